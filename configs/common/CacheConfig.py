@@ -94,6 +94,30 @@ def config_cache(options, system):
         system.l2.cpu_side = system.tol2bus.master
         system.l2.mem_side = system.membus.slave
 
+    if options.parallel_cores:
+        if not options.caches:
+            fatal("--parallel-cores requires --caches.")
+        if getattr(options, "fast_forward", None) or \
+           getattr(options, "standard_switch", None) or \
+           getattr(options, "repeat_switch", None):
+            fatal("--parallel-cores does not support switching CPUs.")
+        if getattr(options, "take_checkpoints", None) or \
+           getattr(options, "take_simpoint_checkpoints", None) or \
+           getattr(options, "checkpoint_at_end", None):
+            fatal("--parallel-cores does not support taking checkpoints.")
+        # The bridged CPUs are not coherent with each other, so each of
+        # them must run its own processes
+        owners = {}
+        for i, cpu in enumerate(system.cpu):
+            if not cpu.workload:
+                fatal("--parallel-cores only supports syscall emulation "
+                      "with multi-programmed workloads.")
+            for process in cpu.workload:
+                if owners.setdefault(id(process), i) != i:
+                    fatal("--parallel-cores needs a separate process per "
+                          "CPU, but cpu%d and cpu%d share one.",
+                          owners[id(process)], i)
+
     if options.memchecker:
         system.memchecker = MemChecker()
 
@@ -157,7 +181,12 @@ def config_cache(options, system):
                         ExternalCache("cpu%d.dcache" % i))
 
         system.cpu[i].createInterruptController()
-        if options.l2cache:
+        if options.parallel_cores:
+            # Queue 0 runs the shared part of the memory system
+            cached_bus = system.tol2bus if options.l2cache else system.membus
+            system.cpu[i].connectAllPortsParallel(i + 1, cached_bus,
+                system.membus, delay=options.queue_bridge_delay)
+        elif options.l2cache:
             system.cpu[i].connectAllPorts(system.tol2bus, system.membus)
         elif options.external_memory_system:
             system.cpu[i].connectUncachedPorts(system.membus)
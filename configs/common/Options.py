@@ -110,6 +110,16 @@ def addNoISAOptions(parser):
     parser.add_option("--l2_assoc", type="int", default=8)
     parser.add_option("--l3_assoc", type="int", default=16)
     parser.add_option("--cacheline_size", type="int", default=64)
+    parser.add_option("--parallel-cores", action="store_true",
+                      help="Simulate each CPU and its private caches in "
+                      "their own thread. The CPUs are not coherent with "
+                      "each other, so this only supports multi-programmed "
+                      "SE workloads, with a process per CPU, and no "
+                      "checkpoints.")
+    parser.add_option("--queue-bridge-delay", type="string", default="2ns",
+                      help="Latency between the CPUs and the shared memory "
+                      "system with --parallel-cores, which is also the "
+                      "simulation quantum [default: %default]")
 
     # Enable Ruby
     parser.add_option("--ruby", action="store_true")
@@ -250,6 +260,11 @@ def addCommonOptions(parser):
         help="the maximum number of checkpoints to drop", default=5)
     parser.add_option("--checkpoint-dir", action="store", type="string",
         help="Place all checkpoints in this absolute directory")
+    parser.add_option("--checkpoint-format", type="choice", default="ini",
+                      choices=["ini", "binary"],
+                      help="Format of the checkpoints taken: INI text, or "
+                      "binary, which is faster to write and restore "
+                      "(convert it with util/cpt_binary.py)")
     parser.add_option("-r", "--checkpoint-restore", action="store", type="int",
         help="restore from checkpoint <N>")
     parser.add_option("--checkpoint-at-end", action="store_true",
@@ -264,6 +279,22 @@ def addCommonOptions(parser):
                       default="AtomicSimpleCPU", choices=CpuConfig.cpu_names(),
                       help = "cpu type for restoring from a checkpoint")
 
+    # Fork-based sampling: fast forward with a simple or KVM CPU, and
+    # fork a child simulating each sample with --cpu-type
+    parser.add_option("--fork-samples", action="store", type="string",
+        help="<M,N> fork a sample at tick M and every N ticks thereafter")
+    parser.add_option("--max-fork-samples", action="store", type="int",
+        help="the maximum number of samples to fork")
+    parser.add_option("--max-fork-children", action="store", type="int",
+        default=1, help="the maximum number of samples running at once")
+    parser.add_option("--fork-warmup", action="store", type="int",
+        default=0, help="ticks of warmup of a sample before its stats reset")
+    parser.add_option("--fork-sample-length", action="store", type="int",
+        default=1000000000, help="ticks of measurement of a sample")
+    parser.add_option("--fork-ff-cpu", action="store", type="choice",
+                      default="AtomicSimpleCPU", choices=CpuConfig.cpu_names(),
+                      help = "cpu type for fast forwarding between samples")
+
 
     # CPU Switching - default switch model goes from a checkpoint
     # to a timing simple CPU with caches to warm up, then to detailed CPU for
@@ -76,7 +76,15 @@ def setCPUClass(options):
             not options.caches and not options.ruby:
         fatal("%s must be used with caches" % options.cpu_type)
 
-    if options.checkpoint_restore != None:
+    if options.fork_samples:
+        # The fast-forwarding CPU also restores the checkpoint, if any
+        if options.checkpoint_restore != None and \
+                options.restore_with_cpu != options.fork_ff_cpu:
+            fatal("--fork-samples restores checkpoints with the "
+                  "--fork-ff-cpu, which must match --restore-with-cpu")
+        CPUClass = TmpClass
+        TmpClass, test_mem_mode = getCPUClass(options.fork_ff_cpu)
+    elif options.checkpoint_restore != None:
         if options.restore_with_cpu != options.cpu_type:
             CPUClass = TmpClass
             TmpClass, test_mem_mode = getCPUClass(options.restore_with_cpu)
@@ -264,6 +272,49 @@ def scriptCheckpoints(options, maxtick, cptdir):
 
     return exit_event
 
+def forkSamples(options, maxtick, testsys, switch_cpu_list):
+    when, period = options.fork_samples.split(",", 1)
+    when = int(when)
+    period = int(period)
+
+    def points():
+        num_samples = 0
+        tick = when
+        # skip the samples before a restored checkpoint
+        while period and tick < m5.curTick():
+            tick += period
+        while tick < maxtick and (options.max_fork_samples is None or
+                                  num_samples < options.max_fork_samples):
+            yield tick
+            tick += period
+            num_samples += 1
+
+    def sample(index):
+        print("Sample %d @ tick %d" % (index, m5.curTick()))
+        m5.switchCpus(testsys, switch_cpu_list, verbose=False)
+        if options.fork_warmup:
+            exit_event = m5.simulate(options.fork_warmup)
+            if exit_event.getCause() != "simulate() limit reached":
+                print("Sample %d ended during warmup because %s" %
+                      (index, exit_event.getCause()))
+                return 1
+        m5.stats.reset()
+        exit_event = m5.simulate(options.fork_sample_length)
+        print("Sample %d ends @ tick %d because %s" %
+              (index, m5.curTick(), exit_event.getCause()))
+        return 0
+
+    exit_event, statuses = m5.forkSamples(points(), sample,
+                                          options.max_fork_children)
+    for index, status in enumerate(statuses):
+        if status != 0:
+            warn("Sample %d failed with status %d" % (index, status))
+
+    if exit_event is None or \
+            exit_event.getCause() == "simulate() limit reached":
+        exit_event = m5.simulate(maxtick - m5.curTick())
+    return exit_event
+
 def benchCheckpoints(options, maxtick, cptdir):
     exit_event = m5.simulate(maxtick - m5.curTick())
     exit_cause = exit_event.getCause()
@@ -448,6 +499,15 @@ def run(options, root, testsys, cpu_class):
     if options.repeat_switch and options.take_checkpoints:
         fatal("Can't specify both --repeat-switch and --take-checkpoints")
 
+    if options.fork_samples and (options.fast_forward or
+                                 options.standard_switch or
+                                 options.repeat_switch or
+                                 options.take_checkpoints):
+        fatal("Can't specify --fork-samples with --fast-forward, "
+              "--standard-switch, --repeat-switch or --take-checkpoints")
+
+    m5.setCheckpointFormat(options.checkpoint_format)
+
     np = options.num_cpus
     switch_cpus = None
 
@@ -641,7 +701,7 @@ def run(options, root, testsys, cpu_class):
         fatal("Bad maxtick (%d) specified: " \
               "Checkpoint starts starts from tick: %d", maxtick, cpt_starttick)
 
-    if options.standard_switch or cpu_class:
+    if (options.standard_switch or cpu_class) and not options.fork_samples:
         if options.standard_switch:
             print("Switch at instruction count:%s" %
                     str(testsys.cpu[0].max_insts_any_thread))
@@ -698,6 +758,9 @@ def run(options, root, testsys, cpu_class):
     elif options.restore_simpoint_checkpoint != None:
         restoreSimpointCheckpoint()
 
+    elif options.fork_samples:
+        exit_event = forkSamples(options, maxtick, testsys, switch_cpu_list)
+
     else:
         if options.fast_forward:
             m5.stats.reset()
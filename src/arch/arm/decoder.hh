@@ -190,6 +190,14 @@ class Decoder
      */
     void takeOverFrom(Decoder *old) {}
 
+    /** Decoded instructions can't be cached by CPUs, see
+     *  X86ISA::Decoder::blockCacheContext(). */
+    bool
+    blockCacheContext(const PCState &pc, uint64_t &context) const
+    {
+        return false;
+    }
+
 
   public: // ARM-specific decoder state manipulation
     void setContext(FPSCR fpscr)
@@ -86,6 +86,14 @@ class Decoder
 
     void takeOverFrom(Decoder *old) {}
 
+    /** Decoded instructions can't be cached by CPUs, see
+     *  X86ISA::Decoder::blockCacheContext(). */
+    bool
+    blockCacheContext(const PCState &pc, uint64_t &context) const
+    {
+        return false;
+    }
+
   protected:
     /// A cache of decoded instruction objects.
     static GenericISA::BasicDecodeCache defaultCache;
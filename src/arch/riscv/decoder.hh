@@ -74,6 +74,14 @@ class Decoder
     bool instReady() { return instDone; }
     void takeOverFrom(Decoder *old) {}
 
+    /** Decoded instructions can't be cached by CPUs, see
+     *  X86ISA::Decoder::blockCacheContext(). */
+    bool
+    blockCacheContext(const PCState &pc, uint64_t &context) const
+    {
+        return false;
+    }
+
     StaticInstPtr decodeInst(ExtMachInst mach_inst);
 
     /// Decode a machine instruction.
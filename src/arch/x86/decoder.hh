@@ -224,6 +224,9 @@ class Decoder
 
     typedef MiscReg CacheKey;
 
+    /** The m5Reg the decoder was last given. */
+    CacheKey cacheKey;
+
     typedef DecodeCache::AddrMap<Decoder::InstBytes> DecodePages;
     DecodePages *decodePages;
     typedef std::unordered_map<CacheKey, DecodePages *> AddrCacheMap;
@@ -252,6 +255,7 @@ class Decoder
         instBytes = &dummy;
         decodePages = NULL;
         instMap = NULL;
+        cacheKey = 0;
     }
 
     void setM5Reg(HandyM5Reg m5Reg)
@@ -265,6 +269,7 @@ class Decoder
         altAddr = m5Reg.altAddr;
         defAddr = m5Reg.defAddr;
         stack = m5Reg.stack;
+        cacheKey = m5Reg;
 
         AddrCacheMap::iterator amIter = addrCacheMap.find(m5Reg);
         if (amIter != addrCacheMap.end()) {
@@ -294,6 +299,28 @@ class Decoder
         altAddr = old->altAddr;
         defAddr = old->defAddr;
         stack = old->stack;
+        cacheKey = old->cacheKey;
+    }
+
+    /**
+     * Check whether CPUs may cache the instruction at a PC once it is
+     * decoded, and reuse it as long as its bytes are the same, instead
+     * of decoding them again, e.g., the AtomicSimpleCPU caches blocks
+     * of decoded instructions. Decoding the same bytes at the same PC
+     * in the same context must give the same instruction, and leave
+     * the PC state the same.
+     *
+     * @param pc PC state before decoding the instruction.
+     * @param context Set to the context of the decoding.
+     * @return Whether the instruction may be cached.
+     */
+    bool
+    blockCacheContext(const PCState &pc, uint64_t &context) const
+    {
+        // The decoder only sets the size and next PC of a PC that has
+        // no size yet
+        context = cacheKey;
+        return pc.microPC() == 0 && pc.size() == 0;
     }
 
     void reset()
@@ -123,6 +123,11 @@ namespace X86ISA
 
         bool checkCondition(uint64_t flags, int condition) const;
 
+        bool classifyCtrlInducer() const override
+        {
+            return classifyCtrlByName(instMnem);
+        }
+
         void
         advancePC(PCState &pcState) const
         {
@@ -40,6 +40,8 @@
 
 #include "arch/x86/insts/static_inst.hh"
 
+#include <cstring>
+
 #include "arch/x86/regs/segment.hh"
 #include "cpu/reg_class.hh"
 
@@ -266,6 +268,23 @@ namespace X86ISA
         os << "]";
     }
 
+    bool X86StaticInst::classifyCtrlByName(const char *inst_name) const
+    {
+        // Trust the generic flags if they were provided after all.
+        if (isDirectCtrl() != isIndirectCtrl() &&
+                isUncondCtrl() != isCondCtrl())
+            return StaticInst::classifyCtrlInducer();
+
+        // Besides returns, direct transfers take an immediate target and
+        // are named with an "_I" suffix.
+        size_t len = strlen(inst_name);
+        if (isReturn() || len < 2 || strcmp(inst_name + len - 2, "_I") != 0)
+            return true;
+
+        // Besides calls, the unconditional ones are the JMPs.
+        return !(isCall() || strncmp(inst_name, "JMP", 3) == 0);
+    }
+
     std::string X86StaticInst::generateDisassembly(Addr pc,
         const SymbolTable *symtab) const
     {
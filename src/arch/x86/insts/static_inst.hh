@@ -91,6 +91,18 @@ namespace X86ISA
         std::string generateDisassembly(Addr pc,
             const SymbolTable *symtab) const;
 
+        /**
+         * The x86 decoder doesn't set the direct and conditional control
+         * flags, so control instructions are classified by the name of
+         * the instruction (or, for microops, the macroop) they implement.
+         */
+        bool classifyCtrlByName(const char *inst_name) const;
+
+        bool classifyCtrlInducer() const override
+        {
+            return classifyCtrlByName(mnemonic);
+        }
+
         void printMnemonic(std::ostream &os, const char * mnemonic) const;
         void printMnemonic(std::ostream &os, const char * instMnemonic,
                 const char * mnemonic) const;
@@ -39,6 +39,7 @@
 
 #include "arch/x86/tlb.hh"
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 
@@ -73,6 +74,7 @@ TLB::TLB(const Params *p)
         tries[i].setTID(i);
     }
 
+    lruPos.resize(size, lruList.end());
     for (int x = 0; x < size; x++) {
         tlb[x].trieHandle = NULL;
         freeList.push_back(&tlb[x]);
@@ -83,24 +85,31 @@ TLB::TLB(const Params *p)
 }
 
 void
-TLB::evictLRU()
+TLB::freeEntry(TlbEntry *entry)
 {
-    // Find the entry with the lowest (and hence least recently updated)
-    // sequence number.
+    assert(entry->trieHandle);
+    tries[entry->trieHandle->tid].remove(entry->trieHandle);
+    entry->trieHandle = NULL;
 
-    unsigned lru = 0;
-    for (unsigned i = 1; i < size; i++) {
-        if (tlb[i].lruSeq < tlb[lru].lruSeq)
-            lru = i;
-    }
+    auto &pos = lruPos[entry - &tlb[0]];
+    lruList.erase(pos);
+    pos = lruList.end();
+
+    freeList.push_back(entry);
+}
+
+void
+TLB::evictLRU()
+{
+    // The entry with the lowest (and hence least recently updated)
+    // sequence number is at the front of the LRU list.
+    assert(!lruList.empty());
+    TlbEntry *lru = lruList.front();
 
     DPRINTF(TLB, "Evicting address %#x.\n",
-                        tlb[lru].vaddr);
+                        lru->vaddr);
 
-    assert(tlb[lru].trieHandle);
-    tries[tlb[lru].trieHandle->tid].remove(tlb[lru].trieHandle);
-    tlb[lru].trieHandle = NULL;
-    freeList.push_back(&tlb[lru]);
+    freeEntry(lru);
 }
 
 void
@@ -166,6 +175,7 @@ TLB::insert(Addr vpn, const TlbEntry &entry)
     *newEntry = entry;
     newEntry->lruSeq = nextSeq();
     newEntry->vaddr = vpn;
+    lruPos[newEntry - &tlb[0]] = lruList.insert(lruList.end(), newEntry);
     newEntry->trieHandle =
     tries[entry.tid].insert(entry.tid, vpn, TlbEntryTrie::MaxBits - entry.logBytes, newEntry);
     return newEntry;
@@ -176,7 +186,7 @@ TLB::lookup(ThreadID tid, Addr va, bool update_lru)
 {
     TlbEntry *entry = tries[tid].lookup(va);
     if (entry && update_lru)
-        entry->lruSeq = nextSeq();
+        touchLRU(entry);
     return entry;
 }
 
@@ -185,11 +195,8 @@ TLB::flushAll()
 {
     DPRINTF(TLB, "Invalidating all entries.\n");
     for (unsigned i = 0; i < size; i++) {
-        if (tlb[i].trieHandle) {
-            tries[tlb[i].trieHandle->tid].remove(tlb[i].trieHandle);
-            tlb[i].trieHandle = NULL;
-            freeList.push_back(&tlb[i]);
-        }
+        if (tlb[i].trieHandle)
+            freeEntry(&tlb[i]);
     }
 }
 
@@ -204,11 +211,8 @@ TLB::flushNonGlobal()
 {
     DPRINTF(TLB, "Invalidating all non global entries.\n");
     for (unsigned i = 0; i < size; i++) {
-        if (tlb[i].trieHandle && !tlb[i].global) {
-            tries[tlb[i].trieHandle->tid].remove(tlb[i].trieHandle);
-            tlb[i].trieHandle = NULL;
-            freeList.push_back(&tlb[i]);
-        }
+        if (tlb[i].trieHandle && !tlb[i].global)
+            freeEntry(&tlb[i]);
     }
 }
 
@@ -217,11 +221,8 @@ TLB::demapPage(Addr va, uint64_t asn)
 {
     // FS mode doesn't support SMT, so give thread ID 0
     TlbEntry *entry = tries[0].lookup(va);
-    if (entry) {
-        tries[0].remove(entry->trieHandle);
-        entry->trieHandle = NULL;
-        freeList.push_back(entry);
-    }
+    if (entry)
+        freeEntry(entry);
 }
 
 Fault
@@ -601,6 +602,7 @@ TLB::unserialize(CheckpointIn &cp)
 
     UNSERIALIZE_SCALAR(lruSeq);
 
+    std::vector<TlbEntry *> restored;
     for (uint32_t x = 0; x < _size; x++) {
         TlbEntry *newEntry = freeList.front();
         freeList.pop_front();
@@ -608,7 +610,16 @@ TLB::unserialize(CheckpointIn &cp)
         newEntry->unserializeSection(cp, csprintf("Entry%d", x));
         newEntry->trieHandle = tries[newEntry->tid].insert(newEntry->tid, newEntry->vaddr,
             TlbEntryTrie::MaxBits - newEntry->logBytes, newEntry);
+        restored.push_back(newEntry);
     }
+
+    // Rebuild the LRU order from the saved sequence numbers
+    std::sort(restored.begin(), restored.end(),
+              [](const TlbEntry *a, const TlbEntry *b) {
+                  return a->lruSeq < b->lruSeq;
+              });
+    for (auto entry : restored)
+        lruPos[entry - &tlb[0]] = lruList.insert(lruList.end(), entry);
 }
 
 BaseMasterPort *
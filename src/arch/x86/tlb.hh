@@ -98,6 +98,15 @@ namespace X86ISA
 
         EntryList freeList;
 
+        /**
+         * Entries in use, least recently used first. Entries move to the
+         * back whenever their lruSeq is bumped, so the list is always in
+         * lruSeq order and the victim is at the front.
+         */
+        EntryList lruList;
+        /** Position of each entry in use in lruList, by index in tlb. */
+        std::vector<EntryList::iterator> lruPos;
+
         std::vector<TlbEntryTrie> tries;
         uint64_t lruSeq;
 
@@ -131,6 +140,17 @@ namespace X86ISA
             return ++lruSeq;
         }
 
+        /** Make an entry in use the most recently used one. */
+        void
+        touchLRU(TlbEntry *entry)
+        {
+            entry->lruSeq = nextSeq();
+            lruList.splice(lruList.end(), lruList, lruPos[entry - &tlb[0]]);
+        }
+
+        /** Remove an entry from its trie and return it to the free list. */
+        void freeEntry(TlbEntry *entry);
+
         Fault translateAtomic(
             const RequestPtr &req, ThreadContext *tc, Mode mode) override;
         void translateTiming(
@@ -0,0 +1,486 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/binary_logger.hh"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#include "base/logging.hh"
+
+namespace Trace {
+
+using namespace BinaryTrace;
+
+namespace {
+
+std::atomic<uint64_t> nextInstance(1);
+
+/** The state of the current thread in the logger it last recorded in. */
+struct CurrentThread
+{
+    uint64_t instance = 0;
+    void *state = nullptr;
+};
+
+thread_local CurrentThread currentThread;
+
+/** Records each line written to it as a text message. */
+class LineBuf : public std::streambuf
+{
+  private:
+    Logger &logger;
+    std::string line;
+
+  protected:
+    int_type
+    overflow(int_type c) override
+    {
+        if (c != traits_type::eof()) {
+            line.push_back(traits_type::to_char_type(c));
+            if (c == '\n')
+                sync();
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int
+    sync() override
+    {
+        if (!line.empty()) {
+            logger.logMessage(MaxTick, std::string(), line);
+            line.clear();
+        }
+        return 0;
+    }
+
+  public:
+    LineBuf(Logger &logger) : logger(logger) {}
+};
+
+void
+flushDebugLogger()
+{
+    getDebugLogger()->flush();
+}
+
+} // anonymous namespace
+
+const size_t BinaryLogger::chunkBytes;
+
+BinaryLogger::BinaryLogger(const std::string &_path, uint64_t ring_records)
+    : instance(nextInstance++), path(_path), file(nullptr),
+      ringRecords(ring_records), stopping(false)
+{
+    file = fopen(path.c_str(), "wb");
+    if (!file)
+        fatal("Can't open binary trace file '%s'\n", path);
+    writeHeader();
+
+    streamBuf.reset(new LineBuf(*this));
+    stream.reset(new std::ostream(streamBuf.get()));
+
+    recordsArgs = true;
+    if (!ringRecords)
+        writer = std::thread(&BinaryLogger::writerLoop, this);
+
+    static bool flush_at_exit = false;
+    if (!flush_at_exit) {
+        std::atexit(flushDebugLogger);
+        flush_at_exit = true;
+    }
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    if (writer.joinable()) {
+        {
+            std::lock_guard<std::mutex> l(lock);
+            stopping = true;
+        }
+        queueReady.notify_one();
+        writer.join();
+    }
+
+    flush();
+    fclose(file);
+}
+
+BinaryLogger::ThreadState &
+BinaryLogger::threadState()
+{
+    if (currentThread.instance == instance)
+        return *static_cast<ThreadState *>(currentThread.state);
+
+    std::lock_guard<std::mutex> l(lock);
+    threads.emplace_back(new ThreadState);
+    ThreadState *ts = threads.back().get();
+    ts->id = threads.size() - 1;
+    currentThread.instance = instance;
+    currentThread.state = ts;
+    return *ts;
+}
+
+uint32_t
+BinaryLogger::intern(ThreadState &ts, const void *key, const char *str,
+                     size_t length)
+{
+    // The same address may hold other strings over time, e.g., when
+    // formats come from std::strings, so check the content as well
+    auto it = ts.strings.find(key);
+    if (it != ts.strings.end() && it->second.str.size() == length &&
+        memcmp(it->second.str.data(), str, length) == 0) {
+        return it->second.id;
+    }
+
+    std::string s(str, length);
+    uint32_t id;
+    {
+        std::lock_guard<std::mutex> l(lock);
+        // ids start at 1, 0 is noName and textFormat
+        auto inserted = stringIds.emplace(s, stringIds.size() + 1);
+        id = inserted.first->second;
+        if (inserted.second)
+            newStrings.emplace_back(id, s);
+    }
+    ts.strings[key] = CachedString{ id, std::move(s) };
+    return id;
+}
+
+BinaryLogger::Chunk *
+BinaryLogger::newChunk(uint32_t thread, size_t min_bytes)
+{
+    std::lock_guard<std::mutex> l(lock);
+    Chunk *chunk;
+    if (!freeChunks.empty() && min_bytes <= chunkBytes) {
+        chunk = freeChunks.back();
+        freeChunks.pop_back();
+    } else {
+        allChunks.emplace_back(new Chunk);
+        chunk = allChunks.back().get();
+        chunk->size = std::max(chunkBytes, min_bytes);
+        chunk->data.reset(new uint8_t[chunk->size]);
+    }
+    chunk->used = 0;
+    chunk->records = 0;
+    chunk->thread = thread;
+    return chunk;
+}
+
+void
+BinaryLogger::chunkFull(ThreadState &ts, size_t bytes)
+{
+    Chunk *full = ts.chunk;
+    ts.chunk = nullptr;
+
+    if (full && ringRecords) {
+        ts.ring.push_back(full);
+        ts.ringRecords += full->records;
+
+        // Drop the oldest chunks while the newer ones keep enough
+        // records, and reuse one of them without locking
+        while (ts.ringRecords - ts.ring.front()->records >= ringRecords) {
+            Chunk *oldest = ts.ring.front();
+            ts.ring.pop_front();
+            ts.ringRecords -= oldest->records;
+            if (!ts.chunk && oldest->size >= bytes) {
+                oldest->used = 0;
+                oldest->records = 0;
+                ts.chunk = oldest;
+            } else {
+                std::lock_guard<std::mutex> l(lock);
+                freeChunks.push_back(oldest);
+            }
+        }
+    } else if (full) {
+        bool write_now;
+        {
+            std::lock_guard<std::mutex> l(lock);
+            queue.push_back(full);
+            write_now = queue.size() > maxQueuedChunks;
+        }
+        queueReady.notify_one();
+        if (write_now)
+            drain();
+    }
+
+    if (!ts.chunk)
+        ts.chunk = newChunk(ts.id, bytes);
+}
+
+uint8_t *
+BinaryLogger::reserve(ThreadState &ts, Tick when, uint32_t name,
+                      uint32_t format, unsigned args, size_t args_bytes)
+{
+    const size_t bytes = sizeof(RecordHeader) + args_bytes;
+    if (!ts.chunk || ts.chunk->size - ts.chunk->used < bytes)
+        chunkFull(ts, bytes);
+
+    RecordHeader header;
+    header.bytes = bytes;
+    header.name = name;
+    header.format = format;
+    header.args = args;
+    header.when = when;
+
+    Chunk *chunk = ts.chunk;
+    uint8_t *p = chunk->data.get() + chunk->used;
+    memcpy(p, &header, sizeof(header));
+    chunk->used += bytes;
+    chunk->records++;
+    return p + sizeof(header);
+}
+
+uint8_t *
+BinaryLogger::recordMessage(Tick when, const std::string &name,
+                            const char *fmt, unsigned args,
+                            size_t args_bytes)
+{
+    ThreadState &ts = threadState();
+    const uint32_t name_id = name.empty() ? noName :
+        intern(ts, &name, name.data(), name.size());
+    const uint32_t format_id = intern(ts, fmt, fmt, strlen(fmt));
+    return reserve(ts, when, name_id, format_id, args, args_bytes);
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+                         const std::string &message)
+{
+    if (!name.empty() && ignore.match(name))
+        return;
+
+    ThreadState &ts = threadState();
+    const uint32_t name_id = name.empty() ? noName :
+        intern(ts, &name, name.data(), name.size());
+    uint8_t *p = reserve(ts, when, name_id, textFormat, 1,
+                         ArgTraits<std::string>::bytes(message));
+    ArgTraits<std::string>::encode(p, message);
+}
+
+std::ostream &
+BinaryLogger::getOstream()
+{
+    return *stream;
+}
+
+void
+BinaryLogger::write(const void *data, size_t bytes)
+{
+    if (fwrite(data, 1, bytes, file) != bytes)
+        fatal("Can't write binary trace file '%s'\n", path);
+}
+
+void
+BinaryLogger::writeBlock(BlockKind kind, uint32_t thread, const void *data,
+                         size_t bytes)
+{
+    BlockHeader header;
+    header.kind = kind;
+    header.thread = thread;
+    header.bytes = bytes;
+    write(&header, sizeof(header));
+    write(data, bytes);
+}
+
+void
+BinaryLogger::writeStrings(
+    const std::vector<std::pair<uint32_t, std::string>> &strings)
+{
+    if (strings.empty())
+        return;
+
+    std::string block;
+    for (const auto &s : strings) {
+        const uint32_t id_length[2] = {
+            s.first, static_cast<uint32_t>(s.second.size()) };
+        block.append(reinterpret_cast<const char *>(id_length),
+                     sizeof(id_length));
+        block.append(s.second);
+    }
+    writeBlock(Strings, 0, block.data(), block.size());
+}
+
+void
+BinaryLogger::writeHeader()
+{
+    FileHeader header;
+    memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.byteOrder = byteOrder;
+    write(&header, sizeof(header));
+}
+
+void
+BinaryLogger::writeChunk(const Chunk *chunk)
+{
+    if (chunk->used)
+        writeBlock(Records, chunk->thread, chunk->data.get(), chunk->used);
+}
+
+void
+BinaryLogger::drain()
+{
+    std::lock_guard<std::mutex> w(writeLock);
+    while (true) {
+        Chunk *chunk;
+        std::vector<std::pair<uint32_t, std::string>> strings;
+        {
+            std::lock_guard<std::mutex> l(lock);
+            if (queue.empty())
+                break;
+            chunk = queue.front();
+            queue.pop_front();
+            // the strings of the chunk were interned before it was
+            // queued, they have been written or are among these
+            strings.swap(newStrings);
+        }
+
+        writeStrings(strings);
+        writeChunk(chunk);
+
+        std::lock_guard<std::mutex> l(lock);
+        freeChunks.push_back(chunk);
+    }
+    fflush(file);
+}
+
+void
+BinaryLogger::writerLoop()
+{
+    while (true) {
+        {
+            std::unique_lock<std::mutex> l(lock);
+            queueReady.wait(l, [this]{ return stopping || !queue.empty(); });
+            if (stopping)
+                return;
+        }
+        drain();
+    }
+}
+
+void
+BinaryLogger::flush()
+{
+    if (!ringRecords) {
+        {
+            std::lock_guard<std::mutex> l(lock);
+            for (auto &ts : threads) {
+                if (ts->chunk && ts->chunk->used) {
+                    queue.push_back(ts->chunk);
+                    ts->chunk = nullptr;
+                }
+            }
+        }
+        drain();
+        return;
+    }
+
+    std::lock_guard<std::mutex> w(writeLock);
+    std::vector<std::pair<uint32_t, std::string>> strings;
+    std::vector<const ThreadState *> states;
+    {
+        std::lock_guard<std::mutex> l(lock);
+        newStrings.clear();
+        for (const auto &s : stringIds)
+            strings.emplace_back(s.second, s.first);
+        for (const auto &ts : threads)
+            states.push_back(ts.get());
+    }
+    writeRing(strings, states);
+}
+
+void
+BinaryLogger::crashFlush()
+{
+    std::unique_lock<std::mutex> w(writeLock, std::try_to_lock);
+    std::unique_lock<std::mutex> l(lock, std::try_to_lock);
+    if (!w.owns_lock() || !l.owns_lock()) {
+        static const char msg[] =
+            "Binary trace in use, not written out on crash\n";
+        if (::write(STDERR_FILENO, msg, sizeof(msg) - 1) < 0) {
+            // nothing more to do
+        }
+        return;
+    }
+
+    // with both locks held, nothing else can touch the trace, which is
+    // then written as flush() would
+    if (!ringRecords) {
+        writeStrings(newStrings);
+        newStrings.clear();
+        for (Chunk *chunk : queue) {
+            writeChunk(chunk);
+            freeChunks.push_back(chunk);
+        }
+        queue.clear();
+        for (auto &ts : threads) {
+            if (ts->chunk) {
+                writeChunk(ts->chunk);
+                ts->chunk->used = 0;
+            }
+        }
+        fflush(file);
+        return;
+    }
+
+    std::vector<std::pair<uint32_t, std::string>> strings;
+    std::vector<const ThreadState *> states;
+    newStrings.clear();
+    for (const auto &s : stringIds)
+        strings.emplace_back(s.second, s.first);
+    for (const auto &ts : threads)
+        states.push_back(ts.get());
+    writeRing(strings, states);
+}
+
+void
+BinaryLogger::writeRing(
+    const std::vector<std::pair<uint32_t, std::string>> &strings,
+    const std::vector<const ThreadState *> &states)
+{
+    // Write the ring over the previous one, if any
+    rewind(file);
+    if (ftruncate(fileno(file), 0) != 0)
+        fatal("Can't truncate binary trace file '%s'\n", path);
+    writeHeader();
+    writeStrings(strings);
+    for (const ThreadState *ts : states) {
+        for (const Chunk *chunk : ts->ring)
+            writeChunk(chunk);
+        if (ts->chunk)
+            writeChunk(ts->chunk);
+    }
+    fflush(file);
+}
+
+} // namespace Trace
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_BINARY_LOGGER_HH__
+#define __BASE_BINARY_LOGGER_HH__
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/binary_trace.hh"
+#include "base/trace.hh"
+
+namespace Trace {
+
+/**
+ * Logger writing a binary trace, see base/binary_trace.hh, that
+ * util/trace_render renders as text. Messages whose arguments are all
+ * of basic types are recorded without being formatted, the others are
+ * formatted and recorded as text.
+ *
+ * Each thread records into its own chunks of memory, without locking.
+ * A full chunk is either handed to a background thread that writes it
+ * to the file, or, when the logger keeps a ring of records, kept until
+ * the thread has recorded enough newer records, and then reused. The
+ * ring is only written to the file by flush() when the simulator
+ * exits, or by crashFlush() when it crashes.
+ */
+class BinaryLogger : public Logger
+{
+  private:
+    struct Chunk
+    {
+        std::unique_ptr<uint8_t[]> data;
+        size_t size = 0;
+        size_t used = 0;
+        uint64_t records = 0;
+        uint32_t thread = 0;
+    };
+
+    /** A string interned by a thread, with the content it had. */
+    struct CachedString
+    {
+        uint32_t id;
+        std::string str;
+    };
+
+    struct ThreadState
+    {
+        uint32_t id;
+        Chunk *chunk = nullptr;
+
+        /** Full chunks kept, oldest first, when keeping a ring. */
+        std::deque<Chunk *> ring;
+        uint64_t ringRecords = 0;
+
+        /** Ids of the strings of the thread, by their address. */
+        std::unordered_map<const void *, CachedString> strings;
+    };
+
+    static const size_t chunkBytes = 1 << 20;
+
+    /** Chunks waiting to be written after which recording threads write
+     *  chunks themselves, rather than outrunning the writer thread. */
+    static const size_t maxQueuedChunks = 64;
+
+    /** Distinguishes loggers, for the state of the threads. */
+    const uint64_t instance;
+
+    const std::string path;
+    FILE *file;
+
+    /** Records of each thread to keep, 0 to write all of them. */
+    const uint64_t ringRecords;
+
+    /** Protects the threads, the chunks and the strings. */
+    std::mutex lock;
+    std::condition_variable queueReady;
+    bool stopping;
+
+    /** Serializes writes to the file. */
+    std::mutex writeLock;
+
+    std::vector<std::unique_ptr<ThreadState>> threads;
+    std::deque<Chunk *> queue;
+    std::vector<Chunk *> freeChunks;
+    std::vector<std::unique_ptr<Chunk>> allChunks;
+
+    /** Interned strings, by content, and those not written yet. */
+    std::unordered_map<std::string, uint32_t> stringIds;
+    std::vector<std::pair<uint32_t, std::string>> newStrings;
+
+    std::thread writer;
+
+    /** Stream of getOstream(), which records each line as text. */
+    std::unique_ptr<std::streambuf> streamBuf;
+    std::unique_ptr<std::ostream> stream;
+
+    ThreadState &threadState();
+    uint32_t intern(ThreadState &ts, const void *key, const char *str,
+                    size_t length);
+
+    Chunk *newChunk(uint32_t thread, size_t min_bytes);
+
+    /** Give up the chunk of a thread, and get one with room for a
+     *  record of some bytes. */
+    void chunkFull(ThreadState &ts, size_t bytes);
+
+    /** Make room for a record in the chunk of a thread.
+     *  @return Where to encode the arguments */
+    uint8_t *reserve(ThreadState &ts, Tick when, uint32_t name,
+                     uint32_t format, unsigned args, size_t args_bytes);
+
+    void write(const void *data, size_t bytes);
+    void writeBlock(BinaryTrace::BlockKind kind, uint32_t thread,
+                    const void *data, size_t bytes);
+    void writeStrings(
+        const std::vector<std::pair<uint32_t, std::string>> &strings);
+    void writeHeader();
+    void writeChunk(const Chunk *chunk);
+
+    /** Write the ring over the one written before, if any. */
+    void writeRing(
+        const std::vector<std::pair<uint32_t, std::string>> &strings,
+        const std::vector<const ThreadState *> &states);
+
+    /** Write the queued chunks, and the strings they refer to. */
+    void drain();
+    void writerLoop();
+
+  protected:
+    uint8_t *recordMessage(Tick when, const std::string &name,
+                           const char *fmt, unsigned args,
+                           size_t args_bytes) override;
+
+  public:
+    /**
+     * @param path File to write the trace to.
+     * @param ring_records Records of each thread to keep and write on
+     * flush(), or 0 to write all the records as they are made.
+     */
+    BinaryLogger(const std::string &path, uint64_t ring_records = 0);
+    ~BinaryLogger();
+
+    void logMessage(Tick when, const std::string &name,
+                    const std::string &message) override;
+
+    std::ostream &getOstream() override;
+
+    /**
+     * Write the records not written yet, or the ring. The records of
+     * other threads are only written consistently when they are not
+     * recording, which is the case when the simulator exits.
+     */
+    void flush() override;
+
+    /**
+     * Same as flush(), unless another thread is using the logger, or
+     * the calling thread crashed while using it: the trace is then
+     * left as it is, with a note on stderr.
+     */
+    void crashFlush() override;
+};
+
+} // namespace Trace
+
+#endif // __BASE_BINARY_LOGGER_HH__
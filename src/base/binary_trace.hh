@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_BINARY_TRACE_HH__
+#define __BASE_BINARY_TRACE_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+/**
+ * @file
+ * Binary debug traces, written by Trace::BinaryLogger and rendered as
+ * text by util/trace_render.
+ *
+ * Instead of formatting the messages of DPRINTF, the logger records
+ * their format string and arguments, and the offline renderer formats
+ * them with the same cprintf code, so the text is the same as that of
+ * Trace::OstreamLogger. Format strings and object names are stored
+ * once in the file, and referred to by id. Values are in the byte
+ * order of the host that wrote the file:
+ *
+ *   char     magic[8]        "gem5trcb"
+ *   uint32_t version
+ *   uint32_t byte_order      0x01020304
+ *   blocks, each:
+ *     uint32_t kind          a BinaryTrace::BlockKind
+ *     uint32_t thread        thread that recorded the block
+ *     uint64_t bytes         size of the payload
+ *     payload:
+ *       Strings: for each string, uint32_t id, uint32_t length, chars
+ *       Records: RecordHeader and arguments of each record
+ *
+ * Each argument is a uint8_t BinaryTrace::ArgType followed by its
+ * value: 8 bytes for numbers and pointers, a uint32_t length and the
+ * chars for strings. Integers are stored as 64 bit, and floats as
+ * doubles, and are converted back to their type before formatting.
+ *
+ * The strings a records block refers to are in strings blocks before
+ * it. Records are in order within the blocks of a thread.
+ */
+
+namespace BinaryTrace {
+
+const char magic[8] = { 'g', 'e', 'm', '5', 't', 'r', 'c', 'b' };
+
+const uint32_t version = 1;
+const uint32_t byteOrder = 0x01020304;
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+};
+
+enum BlockKind : uint32_t {
+    Strings = 1,
+    Records = 2
+};
+
+struct BlockHeader
+{
+    uint32_t kind;
+    uint32_t thread;
+    uint64_t bytes;
+};
+
+/** Format id of records whose message was formatted when recorded. It
+ * has a single string argument, the message. */
+const uint32_t textFormat = 0;
+
+/** Name id of records without a name. */
+const uint32_t noName = 0;
+
+struct RecordHeader
+{
+    /** Size of the record, arguments included. */
+    uint32_t bytes;
+    uint32_t name;
+    uint32_t format;
+    uint32_t args;
+    uint64_t when;
+};
+
+/** Types of the arguments, those cprintf formats differently. */
+enum ArgType : uint8_t {
+    Bool,
+    Char,
+    SignedChar,
+    UnsignedChar,
+    Short,
+    UnsignedShort,
+    Int,
+    UnsignedInt,
+    Long,
+    UnsignedLong,
+    LongLong,
+    UnsignedLongLong,
+    Float,
+    Double,
+    String,
+    Pointer,
+    NumArgTypes
+};
+
+/**
+ * How arguments of a type are recorded. Types that are not recorded
+ * (e.g., classes with their own operator<<) are not basic, and
+ * messages with such arguments are formatted when recorded.
+ */
+template <class T, class Enable = void>
+struct ArgTraits
+{
+    static const bool basic = false;
+
+    // Not called, as messages with such arguments are formatted, but
+    // dprintf() still needs them to compile
+    static size_t bytes(const T &) { return 0; }
+    static uint8_t *encode(uint8_t *p, const T &) { return p; }
+};
+
+template <class T, ArgType Type>
+struct NumberArg
+{
+    static const bool basic = true;
+
+    static size_t bytes(const T &) { return 1 + sizeof(uint64_t); }
+
+    static uint8_t *
+    encode(uint8_t *p, const T &value)
+    {
+        *p = Type;
+        if (std::is_floating_point<T>::value) {
+            const double v = value;
+            memcpy(p + 1, &v, sizeof(v));
+        } else if (std::is_signed<T>::value) {
+            const int64_t v = value;
+            memcpy(p + 1, &v, sizeof(v));
+        } else {
+            const uint64_t v = value;
+            memcpy(p + 1, &v, sizeof(v));
+        }
+        return p + 1 + sizeof(uint64_t);
+    }
+};
+
+template <> struct ArgTraits<bool> : NumberArg<bool, Bool> {};
+template <> struct ArgTraits<char> : NumberArg<char, Char> {};
+template <> struct ArgTraits<signed char>
+    : NumberArg<signed char, SignedChar> {};
+template <> struct ArgTraits<unsigned char>
+    : NumberArg<unsigned char, UnsignedChar> {};
+template <> struct ArgTraits<short> : NumberArg<short, Short> {};
+template <> struct ArgTraits<unsigned short>
+    : NumberArg<unsigned short, UnsignedShort> {};
+template <> struct ArgTraits<int> : NumberArg<int, Int> {};
+template <> struct ArgTraits<unsigned int>
+    : NumberArg<unsigned int, UnsignedInt> {};
+template <> struct ArgTraits<long> : NumberArg<long, Long> {};
+template <> struct ArgTraits<unsigned long>
+    : NumberArg<unsigned long, UnsignedLong> {};
+template <> struct ArgTraits<long long> : NumberArg<long long, LongLong> {};
+template <> struct ArgTraits<unsigned long long>
+    : NumberArg<unsigned long long, UnsignedLongLong> {};
+template <> struct ArgTraits<float> : NumberArg<float, Float> {};
+template <> struct ArgTraits<double> : NumberArg<double, Double> {};
+
+struct StringArg
+{
+    static const bool basic = true;
+
+    static size_t
+    bytes(const char *s, size_t length)
+    {
+        return 1 + sizeof(uint32_t) + length;
+    }
+
+    static uint8_t *
+    encode(uint8_t *p, const char *s, size_t length)
+    {
+        const uint32_t l = length;
+        *p = String;
+        memcpy(p + 1, &l, sizeof(l));
+        memcpy(p + 1 + sizeof(l), s, length);
+        return p + 1 + sizeof(l) + length;
+    }
+};
+
+template <>
+struct ArgTraits<std::string> : StringArg
+{
+    static size_t
+    bytes(const std::string &s)
+    {
+        return StringArg::bytes(s.data(), s.size());
+    }
+
+    static uint8_t *
+    encode(uint8_t *p, const std::string &s)
+    {
+        return StringArg::encode(p, s.data(), s.size());
+    }
+};
+
+/** C strings, recorded as empty when null. */
+struct CStringArg : StringArg
+{
+    static size_t length(const char *s) { return s ? strlen(s) : 0; }
+
+    static size_t
+    bytes(const char *s)
+    {
+        return StringArg::bytes(s, length(s));
+    }
+
+    static uint8_t *
+    encode(uint8_t *p, const char *s)
+    {
+        return StringArg::encode(p, s, length(s));
+    }
+};
+
+template <> struct ArgTraits<char *> : CStringArg {};
+template <> struct ArgTraits<const char *> : CStringArg {};
+template <size_t N> struct ArgTraits<char[N]> : CStringArg {};
+template <size_t N> struct ArgTraits<const char[N]> : CStringArg {};
+
+/**
+ * Pointers to objects, which ostreams print as addresses. Pointers to
+ * signed and unsigned chars print as strings, and pointers to volatile
+ * objects and to functions as bools, so they are not basic.
+ */
+template <class T>
+struct ArgTraits<T *, typename std::enable_if<
+                          std::is_object<T>::value &&
+                          !std::is_volatile<T>::value &&
+                          !std::is_same<typename std::remove_cv<T>::type,
+                                        signed char>::value &&
+                          !std::is_same<typename std::remove_cv<T>::type,
+                                        unsigned char>::value>::type>
+{
+    static const bool basic = true;
+
+    static size_t bytes(const T *) { return 1 + sizeof(uint64_t); }
+
+    static uint8_t *
+    encode(uint8_t *p, const T *value)
+    {
+        const uint64_t v = reinterpret_cast<uintptr_t>(value);
+        *p = Pointer;
+        memcpy(p + 1, &v, sizeof(v));
+        return p + 1 + sizeof(v);
+    }
+};
+
+/** Whether all of the types of a message are basic. */
+template <class ...Args>
+struct AllBasic;
+
+template <>
+struct AllBasic<>
+{
+    static const bool value = true;
+};
+
+template <class T, class ...Args>
+struct AllBasic<T, Args...>
+{
+    static const bool value = ArgTraits<T>::basic && AllBasic<Args...>::value;
+};
+
+inline size_t argBytes() { return 0; }
+
+template <class T, class ...Args>
+inline size_t
+argBytes(const T &value, const Args &...args)
+{
+    return ArgTraits<T>::bytes(value) + argBytes(args...);
+}
+
+inline uint8_t *encodeArgs(uint8_t *p) { return p; }
+
+template <class T, class ...Args>
+inline uint8_t *
+encodeArgs(uint8_t *p, const T &value, const Args &...args)
+{
+    return encodeArgs(ArgTraits<T>::encode(p, value), args...);
+}
+
+} // namespace BinaryTrace
+
+#endif // __BASE_BINARY_TRACE_HH__
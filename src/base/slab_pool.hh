@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_SLAB_POOL_HH__
+#define __BASE_SLAB_POOL_HH__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/**
+ * @file
+ * Per-thread pools of fixed-size blocks, for the objects the memory
+ * system allocates and frees once or more per access (packets, requests
+ * and their data). A pool hands back the blocks freed by its thread
+ * before asking the heap for more, so that the steady state of a
+ * simulation does not go through malloc at all.
+ */
+
+/**
+ * Allocation counts of all the pools of an owner type, over all threads.
+ * A hit is an allocation served from a free list, and a miss one that
+ * had to take a new slab from the heap.
+ *
+ * @tparam Owner Type the pools are for.
+ */
+template <class Owner>
+class SlabPoolCounters
+{
+  public:
+    /** Counts of one thread of one pool. */
+    struct Counts
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+
+  private:
+    static std::mutex &
+    mutex()
+    {
+        static std::mutex m;
+        return m;
+    }
+
+    static std::vector<const Counts *> &
+    threads()
+    {
+        static std::vector<const Counts *> t;
+        return t;
+    }
+
+  public:
+    /** Add the counts of a new thread. They must live forever. */
+    static void
+    add(const Counts *counts)
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        threads().push_back(counts);
+    }
+
+    /**
+     * Total hits. Only exact while the other threads are not allocating,
+     * e.g., when stats are dumped.
+     */
+    static uint64_t
+    hits()
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        uint64_t total = 0;
+        for (auto counts : threads())
+            total += counts->hits;
+        return total;
+    }
+
+    /** Total misses, see hits(). */
+    static uint64_t
+    misses()
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        uint64_t total = 0;
+        for (auto counts : threads())
+            total += counts->misses;
+        return total;
+    }
+};
+
+/**
+ * Pool of fixed-size blocks. Each thread has its own free list, so
+ * allocating and freeing by the same thread never synchronise. A block
+ * freed by another thread than the one that allocated it, which is what
+ * happens to packets crossing between the event queues of a parallel
+ * simulation, goes back to the thread it came from: it is pushed on
+ * that thread's list of remote frees, which the thread takes over
+ * whole when its own free list runs dry. A thread thus never holds
+ * more blocks than it had allocated at once. Blocks are taken from the
+ * heap a slab at a time, and are never given back to it.
+ *
+ * @tparam Owner Type the pool is for, which its counts are kept under.
+ * @tparam Size Size of the blocks.
+ */
+template <class Owner, size_t Size = sizeof(Owner)>
+class SlabPool
+{
+  private:
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    /** Block size, rounded up to keep every block suitably aligned. */
+    static const size_t blockSize =
+        ((Size > sizeof(FreeBlock) ? Size : sizeof(FreeBlock)) +
+         alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+    struct ThreadState
+    {
+        FreeBlock *freeList = nullptr;
+        /** Blocks of this thread freed by other threads. */
+        std::atomic<FreeBlock *> remoteFreeList{nullptr};
+        typename SlabPoolCounters<Owner>::Counts counts;
+    };
+
+    /** Start of a slab, recording the thread its blocks belong to. */
+    struct SlabHeader
+    {
+        ThreadState *owner;
+    };
+
+    static const size_t headerSize =
+        (sizeof(SlabHeader) + alignof(std::max_align_t) - 1) &
+        ~(alignof(std::max_align_t) - 1);
+
+    /**
+     * Size of a slab, at least 64kB. It is a power of two, and slabs
+     * are aligned to it, so the slab of a block is found by masking its
+     * address.
+     */
+    static constexpr size_t
+    slabBytesFor(size_t bytes)
+    {
+        return bytes >= headerSize + blockSize && bytes >= 64 * 1024 ?
+            bytes : slabBytesFor(bytes * 2);
+    }
+
+    static const size_t slabBytes = slabBytesFor(1);
+
+    /** Number of blocks taken from the heap at once. */
+    static const size_t slabBlocks = (slabBytes - headerSize) / blockSize;
+
+    /**
+     * State of the calling thread. It is never freed, so that objects
+     * destroyed after their thread exited (e.g., by static destructors)
+     * can still be returned to it.
+     */
+    static ThreadState &
+    local()
+    {
+        static thread_local ThreadState *state = nullptr;
+        if (!state) {
+            state = new ThreadState;
+            SlabPoolCounters<Owner>::add(&state->counts);
+        }
+        return *state;
+    }
+
+    static void
+    refill(ThreadState &state)
+    {
+        void *mem;
+        if (posix_memalign(&mem, slabBytes, slabBytes))
+            throw std::bad_alloc();
+
+        char *slab = static_cast<char *>(mem);
+        reinterpret_cast<SlabHeader *>(slab)->owner = &state;
+        for (size_t i = slabBlocks; i-- > 0; ) {
+            FreeBlock *block = reinterpret_cast<FreeBlock *>(
+                slab + headerSize + i * blockSize);
+            block->next = state.freeList;
+            state.freeList = block;
+        }
+    }
+
+    static ThreadState *
+    owner(void *p)
+    {
+        return reinterpret_cast<SlabHeader *>(
+            reinterpret_cast<uintptr_t>(p) & ~(uintptr_t)(slabBytes - 1))->
+            owner;
+    }
+
+  public:
+    static void *
+    allocate()
+    {
+        ThreadState &state = local();
+        if (!state.freeList) {
+            state.freeList = state.remoteFreeList.exchange(
+                nullptr, std::memory_order_acquire);
+        }
+        if (state.freeList) {
+            state.counts.hits++;
+        } else {
+            state.counts.misses++;
+            refill(state);
+        }
+
+        FreeBlock *block = state.freeList;
+        state.freeList = block->next;
+        return block;
+    }
+
+    static void
+    deallocate(void *p)
+    {
+        if (!p)
+            return;
+
+        ThreadState &state = *owner(p);
+        FreeBlock *block = static_cast<FreeBlock *>(p);
+        if (&state == &local()) {
+            block->next = state.freeList;
+            state.freeList = block;
+        } else {
+            // the owner only ever takes the whole list, so pushing races
+            // with nothing but other pushes
+            block->next = state.remoteFreeList.load(
+                std::memory_order_relaxed);
+            while (!state.remoteFreeList.compare_exchange_weak(
+                       block->next, block, std::memory_order_release,
+                       std::memory_order_relaxed)) {
+            }
+        }
+    }
+};
+
+/**
+ * Standard allocator taking single objects from a SlabPool, for use with
+ * std::allocate_shared. The pool counts are kept under Owner whatever
+ * type the allocator is rebound to (e.g., the shared_ptr control block
+ * holding the object). Arrays come from the heap.
+ */
+template <class T, class Owner = T>
+class SlabAllocator
+{
+  public:
+    typedef T value_type;
+
+    template <class U>
+    struct rebind
+    {
+        typedef SlabAllocator<U, Owner> other;
+    };
+
+    SlabAllocator() = default;
+
+    template <class U>
+    SlabAllocator(const SlabAllocator<U, Owner> &) {}
+
+    T *
+    allocate(size_t n)
+    {
+        if (n == 1)
+            return static_cast<T *>(SlabPool<Owner, sizeof(T)>::allocate());
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    void
+    deallocate(T *p, size_t n)
+    {
+        if (n == 1)
+            SlabPool<Owner, sizeof(T)>::deallocate(p);
+        else
+            ::operator delete(p);
+    }
+
+    template <class U>
+    bool operator==(const SlabAllocator<U, Owner> &) const { return true; }
+
+    template <class U>
+    bool operator!=(const SlabAllocator<U, Owner> &) const { return false; }
+};
+
+#endif // __BASE_SLAB_POOL_HH__
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "base/slab_pool.hh"
+
+namespace {
+
+struct Small
+{
+    uint64_t value;
+};
+
+struct Shared
+{
+    Shared(int _value) : value(_value) {}
+    int value;
+};
+
+struct ThreadOwner;
+
+} // anonymous namespace
+
+TEST(SlabPool, ReusesFreedBlocks)
+{
+    const uint64_t hits = SlabPoolCounters<Small>::hits();
+    const uint64_t misses = SlabPoolCounters<Small>::misses();
+
+    void *first = SlabPool<Small>::allocate();
+    SlabPool<Small>::deallocate(first);
+    void *second = SlabPool<Small>::allocate();
+    EXPECT_EQ(first, second);
+    SlabPool<Small>::deallocate(second);
+
+    // Only the first allocation of the thread needs a slab
+    EXPECT_EQ(hits + 1, SlabPoolCounters<Small>::hits());
+    EXPECT_EQ(misses + 1, SlabPoolCounters<Small>::misses());
+}
+
+TEST(SlabPool, DistinctAlignedBlocks)
+{
+    std::vector<void *> blocks;
+    std::set<void *> unique;
+    for (int i = 0; i < 10000; i++) {
+        void *block = SlabPool<Small, 24>::allocate();
+        EXPECT_EQ(0, reinterpret_cast<uintptr_t>(block) %
+                  alignof(std::max_align_t));
+        blocks.push_back(block);
+        unique.insert(block);
+    }
+    EXPECT_EQ(blocks.size(), unique.size());
+
+    for (auto block : blocks)
+        SlabPool<Small, 24>::deallocate(block);
+}
+
+TEST(SlabPool, CrossThreadFree)
+{
+    // A block freed by another thread goes back to the thread that
+    // allocated it
+    typedef SlabPool<ThreadOwner, 64> Pool;
+    std::vector<void *> blocks;
+    void *first = Pool::allocate();
+    blocks.push_back(first);
+    // empty the free list of this thread
+    while (SlabPoolCounters<ThreadOwner>::misses() < 2)
+        blocks.push_back(Pool::allocate());
+    void *last = blocks.back();
+    blocks.pop_back();
+
+    void *other_block = nullptr;
+    std::thread other([&]{
+        Pool::deallocate(first);
+        other_block = Pool::allocate();
+    });
+    other.join();
+    EXPECT_NE(first, other_block);
+    EXPECT_EQ(3, SlabPoolCounters<ThreadOwner>::misses());
+
+    Pool::deallocate(last);
+    EXPECT_EQ(last, Pool::allocate());
+    // once the local free list is empty, the remote frees are reused
+    blocks.push_back(last);
+    void *reused = nullptr;
+    do {
+        reused = Pool::allocate();
+        blocks.push_back(reused);
+    } while (reused != first &&
+             SlabPoolCounters<ThreadOwner>::misses() == 3);
+    EXPECT_EQ(first, reused);
+    EXPECT_EQ(3, SlabPoolCounters<ThreadOwner>::misses());
+
+    for (auto block : blocks)
+        Pool::deallocate(block);
+}
+
+TEST(SlabPool, ProducerConsumer)
+{
+    // Blocks allocated by one thread and freed by another do not make
+    // the pools grow
+    struct Crossing;
+    typedef SlabPool<Crossing, 64> Pool;
+    const int count = 100000;
+    std::vector<void *> batch;
+    for (int round = 0; round < 20; round++) {
+        for (int i = 0; i < count; i++)
+            batch.push_back(Pool::allocate());
+        std::thread consumer([&]{
+            for (auto block : batch)
+                Pool::deallocate(block);
+        });
+        consumer.join();
+        batch.clear();
+    }
+
+    // a slab holds a little less than 64kB of blocks
+    const uint64_t slab_blocks = 64 * 1024 / 64 - 1;
+    EXPECT_GE(count / slab_blocks + 2,
+              SlabPoolCounters<Crossing>::misses());
+}
+
+TEST(SlabPool, AllocateShared)
+{
+    const uint64_t allocations = SlabPoolCounters<Shared>::hits() +
+        SlabPoolCounters<Shared>::misses();
+
+    {
+        auto ptr = std::allocate_shared<Shared>(SlabAllocator<Shared>(), 3);
+        EXPECT_EQ(3, ptr->value);
+        auto copy = ptr;
+        EXPECT_EQ(2, copy.use_count());
+    }
+    auto ptr = std::allocate_shared<Shared>(SlabAllocator<Shared>(), 4);
+    EXPECT_EQ(4, ptr->value);
+
+    EXPECT_EQ(allocations + 2, SlabPoolCounters<Shared>::hits() +
+              SlabPoolCounters<Shared>::misses());
+}
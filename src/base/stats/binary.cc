@@ -0,0 +1,453 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/binary.hh"
+
+#include <cassert>
+#include <cstring>
+#include <ostream>
+
+#include "base/callback.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "sim/core.hh"
+
+using namespace std;
+
+namespace Stats {
+
+namespace {
+
+/** Names of the values of a distribution, before its buckets. */
+const char *distFields[] = {
+    "samples", "sum", "squares", "logs", "min", "max", "bucket_size",
+    "min_val", "max_val", "underflow", "overflow",
+};
+const size_t numDistFields = sizeof(distFields) / sizeof(distFields[0]);
+
+size_t
+distSize(const DistData &data)
+{
+    return numDistFields + data.cvec.size();
+}
+
+/** Append raw bytes to a record. */
+template <class T>
+void
+put(vector<char> &record, const T &value)
+{
+    const char *bytes = reinterpret_cast<const char *>(&value);
+    record.insert(record.end(), bytes, bytes + sizeof(value));
+}
+
+void
+putString(vector<char> &record, const string &str)
+{
+    put<uint32_t>(record, str.size());
+    record.insert(record.end(), str.begin(), str.end());
+}
+
+/** Start a record of the given type; its length is patched by finish. */
+void
+startRecord(vector<char> &record, char type)
+{
+    record.push_back(type);
+    put<uint64_t>(record, 0);
+}
+
+void
+finishRecord(vector<char> &record)
+{
+    const uint64_t length = record.size() - 1 - sizeof(uint64_t);
+    memcpy(&record[1], &length, sizeof(length));
+}
+
+void
+distColumns(vector<string> &names, const DistData &data,
+            const string &prefix)
+{
+    for (size_t i = 0; i < numDistFields; i++)
+        names.push_back(prefix + distFields[i]);
+    for (size_t i = 0; i < data.cvec.size(); i++)
+        names.push_back(prefix + to_string(i));
+}
+
+string
+subname(const vector<string> &subnames, size_t i)
+{
+    return i < subnames.size() && !subnames[i].empty() ?
+        subnames[i] : to_string(i);
+}
+
+} // anonymous namespace
+
+const uint32_t Binary::version;
+
+Binary::Binary()
+    : stream(NULL), threaded(false), stopping(false)
+{
+}
+
+Binary::~Binary()
+{
+    close();
+}
+
+void
+Binary::open(ostream &_stream, bool _threaded)
+{
+    if (stream)
+        panic("stream already set!");
+
+    stream = &_stream;
+    if (!valid())
+        fatal("Unable to open output stream for writing\n");
+
+    const uint32_t bom = 0x01020304;
+    stream->write("gem5stat", 8);
+    stream->write(reinterpret_cast<const char *>(&version), sizeof(version));
+    stream->write(reinterpret_cast<const char *>(&bom), sizeof(bom));
+    stream->flush();
+
+    threaded = _threaded;
+    if (threaded)
+        writer = thread([this]{ writerMain(); });
+}
+
+DrainState
+Binary::drain()
+{
+    if (threaded) {
+        unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this]{ return pending.empty(); });
+    }
+    return DrainState::Drained;
+}
+
+void
+Binary::close()
+{
+    if (!writer.joinable())
+        return;
+
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cond.notify_all();
+    writer.join();
+    threaded = false;
+}
+
+bool
+Binary::valid() const
+{
+    return stream != NULL && stream->good();
+}
+
+void
+Binary::begin()
+{
+    columns.clear();
+    values.clear();
+}
+
+void
+Binary::end()
+{
+    if (!(columns == schema)) {
+        schema = columns;
+        write(schemaRecord());
+    }
+    write(dumpRecord());
+}
+
+void
+Binary::add(const Info &info, Kind kind, size_t num_values)
+{
+    columns.push_back(Column{&info, kind, num_values});
+}
+
+void
+Binary::addDist(const DistData &data)
+{
+    values.push_back(data.samples);
+    values.push_back(data.sum);
+    values.push_back(data.squares);
+    values.push_back(data.logs);
+    values.push_back(data.min);
+    values.push_back(data.max);
+    values.push_back(data.bucket_size);
+    values.push_back(data.min_val);
+    values.push_back(data.max_val);
+    values.push_back(data.underflow);
+    values.push_back(data.overflow);
+    values.insert(values.end(), data.cvec.begin(), data.cvec.end());
+}
+
+void
+Binary::visit(const ScalarInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    add(info, ScalarKind, 1);
+    values.push_back(info.result());
+}
+
+void
+Binary::visit(const VectorInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    const VResult &result = info.result();
+    add(info, VectorKind, result.size());
+    values.insert(values.end(), result.begin(), result.end());
+}
+
+void
+Binary::visit(const DistInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    add(info, DistKind, distSize(info.data));
+    addDist(info.data);
+}
+
+void
+Binary::visit(const VectorDistInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    size_t num_values = 0;
+    for (const auto &data : info.data)
+        num_values += distSize(data);
+
+    add(info, VectorDistKind, num_values);
+    for (const auto &data : info.data)
+        addDist(data);
+}
+
+void
+Binary::visit(const Vector2dInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    add(info, Vector2dKind, info.cvec.size());
+    values.insert(values.end(), info.cvec.begin(), info.cvec.end());
+}
+
+void
+Binary::visit(const FormulaInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    const VResult &result = info.result();
+    add(info, FormulaKind, result.size());
+    values.insert(values.end(), result.begin(), result.end());
+}
+
+void
+Binary::visit(const SparseHistInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    // The buckets change from dump to dump, so they are stored as
+    // (key, count) pairs after the number of samples.
+    add(info, SparseHistKind, 1 + 2 * info.data.cmap.size());
+    values.push_back(info.data.samples);
+    for (const auto &bucket : info.data.cmap) {
+        values.push_back(bucket.first);
+        values.push_back(bucket.second);
+    }
+}
+
+vector<char>
+Binary::schemaRecord() const
+{
+    vector<char> record;
+    startRecord(record, 'S');
+    put<uint32_t>(record, schema.size());
+
+    vector<uint64_t> dims;
+    vector<string> names;
+    for (const auto &column : schema) {
+        const Info &info = *column.info;
+        dims.clear();
+        names.clear();
+
+        switch (column.kind) {
+          case ScalarKind:
+            names.push_back("");
+            break;
+
+          case VectorKind:
+          case FormulaKind: {
+              auto &vector_info = static_cast<const VectorInfo &>(info);
+              dims.push_back(column.numValues);
+              for (size_t i = 0; i < column.numValues; i++)
+                  names.push_back(subname(vector_info.subnames, i));
+              break;
+          }
+
+          case DistKind: {
+              auto &dist_info = static_cast<const DistInfo &>(info);
+              dims.push_back(column.numValues);
+              distColumns(names, dist_info.data, "");
+              break;
+          }
+
+          case VectorDistKind: {
+              auto &vdist_info = static_cast<const VectorDistInfo &>(info);
+              dims.push_back(vdist_info.data.size());
+              dims.push_back(vdist_info.data.empty() ? 0 :
+                             distSize(vdist_info.data[0]));
+              for (size_t i = 0; i < vdist_info.data.size(); i++) {
+                  distColumns(names, vdist_info.data[i],
+                              subname(vdist_info.subnames, i) + ".");
+              }
+              break;
+          }
+
+          case Vector2dKind: {
+              auto &v2d_info = static_cast<const Vector2dInfo &>(info);
+              dims.push_back(v2d_info.x);
+              dims.push_back(v2d_info.y);
+              for (size_t i = 0; i < v2d_info.x; i++) {
+                  for (size_t j = 0; j < v2d_info.y; j++) {
+                      names.push_back(subname(v2d_info.subnames, i) + "." +
+                                      subname(v2d_info.y_subnames, j));
+                  }
+              }
+              break;
+          }
+
+          case SparseHistKind:
+            dims.push_back(column.numValues);
+            names.push_back("samples");
+            for (size_t i = 1; i < column.numValues; i += 2) {
+                names.push_back("key");
+                names.push_back("count");
+            }
+            break;
+        }
+
+        assert(names.size() == column.numValues);
+
+        putString(record, info.name);
+        putString(record, info.desc);
+        put<uint8_t>(record, column.kind);
+        put<uint32_t>(record, dims.size());
+        for (auto dim : dims)
+            put<uint64_t>(record, dim);
+        put<uint32_t>(record, names.size());
+        for (const auto &name : names)
+            putString(record, name);
+    }
+
+    finishRecord(record);
+    return record;
+}
+
+vector<char>
+Binary::dumpRecord() const
+{
+    vector<char> record;
+    record.reserve(1 + 3 * sizeof(uint64_t) + values.size() * sizeof(double));
+    startRecord(record, 'D');
+    put<uint64_t>(record, curTick());
+    put<uint64_t>(record, values.size());
+    const char *bytes = reinterpret_cast<const char *>(values.data());
+    record.insert(record.end(), bytes, bytes + values.size() * sizeof(double));
+    finishRecord(record);
+    return record;
+}
+
+void
+Binary::write(vector<char> &&record)
+{
+    if (!threaded) {
+        stream->write(record.data(), record.size());
+        stream->flush();
+        return;
+    }
+
+    {
+        lock_guard<std::mutex> lock(mutex);
+        pending.push_back(std::move(record));
+    }
+    cond.notify_all();
+}
+
+void
+Binary::writerMain()
+{
+    unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        cond.wait(lock, [this]{ return !pending.empty() || stopping; });
+        if (pending.empty())
+            return;
+
+        // Write without holding the lock so that dumps can queue more
+        vector<char> record = std::move(pending.front());
+        lock.unlock();
+        stream->write(record.data(), record.size());
+        stream->flush();
+        lock.lock();
+
+        pending.pop_front();
+        cond.notify_all();
+    }
+}
+
+Output *
+initBinary(const string &filename, bool threaded)
+{
+    static Binary binary;
+    static bool connected = false;
+
+    if (!connected) {
+        binary.open(*simout.findOrCreate(filename, true)->stream(),
+                    threaded);
+        // Make sure the background thread is done before the output
+        // files are closed
+        registerExitCallback(
+            new MakeCallback<Binary, &Binary::close>(&binary));
+        connected = true;
+    }
+
+    return &binary;
+}
+
+} // namespace Stats
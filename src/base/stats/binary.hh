@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_BINARY_HH__
+#define __BASE_STATS_BINARY_HH__
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/stats/info.hh"
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+#include "sim/drain.hh"
+
+namespace Stats {
+
+/**
+ * Compact binary statistics output for frequent dumps.
+ *
+ * The text output formats every statistic on every dump. This output
+ * describes the statistics once, in a schema record, and each dump then
+ * only appends the raw values as one row of doubles, so a file of many
+ * dumps reads as one column per statistic value. A new schema record is
+ * only written when the shape of the statistics changes (e.g., a sparse
+ * histogram grew a bucket). Rows can be written by a background thread,
+ * so that a dump only costs collecting the values. The thread finishes
+ * writing the pending rows when the simulator drains (e.g., before a
+ * checkpoint), and is stopped at exit.
+ *
+ * File layout, in host byte order:
+ *
+ *   header: "gem5stat" | u32 version | u32 0x01020304 byte order mark
+ *   record: u8 type | u64 payload length | payload
+ *
+ *   'S' schema: u32 num_stats, then for each statistic:
+ *        str name | str desc | u8 kind | u32 num_dims | u64 dims[] |
+ *        u32 num_columns | str columns[]
+ *   'D' dump:   u64 tick | u64 num_values | f64 values[]
+ *
+ * where str is a u32 length followed by the characters. The values of a
+ * dump are those of the statistics of the latest schema, in order, each
+ * contributing num_columns values. src/python/m5/stats/binary.py reads
+ * the format back.
+ */
+class Binary : public Output, public Drainable
+{
+  public:
+    /** Kind of a statistic in a schema record. */
+    enum Kind : uint8_t {
+        ScalarKind,
+        VectorKind,
+        DistKind,
+        VectorDistKind,
+        Vector2dKind,
+        FormulaKind,
+        SparseHistKind,
+    };
+
+    static const uint32_t version = 1;
+
+  protected:
+    /** A statistic visited during a dump, and its number of values. */
+    struct Column
+    {
+        const Info *info;
+        Kind kind;
+        size_t numValues;
+
+        bool operator==(const Column &other) const
+        {
+            return info == other.info && kind == other.kind &&
+                numValues == other.numValues;
+        }
+    };
+
+    std::ostream *stream;
+
+    /** Statistics described by the last schema written. */
+    std::vector<Column> schema;
+    /** Statistics visited by the current dump. */
+    std::vector<Column> columns;
+    /** Values of the current dump. */
+    std::vector<double> values;
+
+    /** Whether records are written by the background thread. */
+    bool threaded;
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable cond;
+    /** Records waiting for the background thread. */
+    std::deque<std::vector<char>> pending;
+    bool stopping;
+
+    void add(const Info &info, Kind kind, size_t num_values);
+    void addDist(const DistData &data);
+
+    std::vector<char> schemaRecord() const;
+    std::vector<char> dumpRecord() const;
+
+    void write(std::vector<char> &&record);
+    void writerMain();
+
+  public:
+    Binary();
+    ~Binary();
+
+    /**
+     * Start writing to the given stream.
+     * @param threaded Whether to write from a background thread.
+     */
+    void open(std::ostream &stream, bool threaded);
+
+    /** Wait until all the records have been written. */
+    DrainState drain() override;
+
+    /** Stop the background thread, if any, after draining it. */
+    void close();
+
+    // Implement Visit
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+    // Implement Output
+    bool valid() const override;
+    void begin() override;
+    void end() override;
+};
+
+Output *initBinary(const std::string &filename, bool threaded);
+
+} // namespace Stats
+
+#endif // __BASE_STATS_BINARY_HH__
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_TAG_MATCH_HH__
+#define __BASE_TAG_MATCH_HH__
+
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @file
+ * Search of a contiguous array of 64-bit tags, as kept per set by the
+ * set-associative lookup structures. Compares several ways per
+ * instruction when the host supports it (AVX2, or SSE2 which every
+ * x86-64 host has), and falls back to a plain loop otherwise.
+ */
+
+/**
+ * Find the first tag equal to the given key, one tag at a time.
+ *
+ * @param tags Array of tags.
+ * @param num_tags Number of tags in the array.
+ * @param key Tag to look for.
+ * @param start Index from which to start looking.
+ * @return Index of the first matching tag at or after start, or
+ *         num_tags if there is none.
+ */
+inline unsigned
+findTagScalar(const uint64_t *tags, unsigned num_tags, uint64_t key,
+              unsigned start = 0)
+{
+    for (unsigned i = start; i < num_tags; i++) {
+        if (tags[i] == key)
+            return i;
+    }
+    return num_tags;
+}
+
+/**
+ * Find the first tag equal to the given key.
+ *
+ * @param tags Array of tags.
+ * @param num_tags Number of tags in the array.
+ * @param key Tag to look for.
+ * @param start Index from which to start looking.
+ * @return Index of the first matching tag at or after start, or
+ *         num_tags if there is none.
+ */
+inline unsigned
+findTag(const uint64_t *tags, unsigned num_tags, uint64_t key,
+        unsigned start = 0)
+{
+    unsigned i = start;
+#if defined(__AVX2__)
+    const __m256i k = _mm256_set1_epi64x(key);
+    for (; i + 4 <= num_tags; i += 4) {
+        const __m256i t =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(tags + i));
+        const int mask = _mm256_movemask_pd(
+            _mm256_castsi256_pd(_mm256_cmpeq_epi64(t, k)));
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+#elif defined(__SSE2__)
+    const __m128i k = _mm_set1_epi64x(key);
+    for (; i + 2 <= num_tags; i += 2) {
+        const __m128i t =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(tags + i));
+        // SSE2 only compares 32-bit lanes; a tag matches when both of
+        // its halves do
+        __m128i eq = _mm_cmpeq_epi32(t, k);
+        eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+        const int mask = _mm_movemask_pd(_mm_castsi128_pd(eq));
+        if (mask)
+            return i + ((mask & 1) ? 0 : 1);
+    }
+#endif
+    return findTagScalar(tags, num_tags, key, i);
+}
+
+#endif // __BASE_TAG_MATCH_HH__
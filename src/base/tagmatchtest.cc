@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "base/tag_match.hh"
+
+TEST(TagMatch, EmptyArray)
+{
+    const uint64_t tag = 0;
+    EXPECT_EQ(0, findTag(&tag, 0, 0));
+}
+
+TEST(TagMatch, EveryPosition)
+{
+    // Cover every position within and past the vector width, for
+    // arrays whose size is not a multiple of it
+    for (unsigned num_tags = 1; num_tags <= 33; num_tags++) {
+        std::vector<uint64_t> tags(num_tags);
+        for (unsigned i = 0; i < num_tags; i++)
+            tags[i] = 0x1000 + i;
+
+        for (unsigned i = 0; i < num_tags; i++)
+            EXPECT_EQ(i, findTag(tags.data(), num_tags, 0x1000 + i));
+        EXPECT_EQ(num_tags, findTag(tags.data(), num_tags, 0x999));
+    }
+}
+
+TEST(TagMatch, HalfMatches)
+{
+    // Tags that only share their upper or lower 32 bits with the key
+    // must not match
+    const uint64_t key = 0x1234567800abcdefULL;
+    const uint64_t tags[] = {
+        0x1234567800000000ULL, 0x0000000000abcdefULL,
+        0x1234567900abcdefULL, 0x1234567800abcdeeULL,
+        key,
+    };
+    EXPECT_EQ(4, findTag(tags, 5, key));
+    EXPECT_EQ(4, findTag(tags, 5, key, 1));
+    EXPECT_EQ(4, findTag(tags, 5, key, 4));
+}
+
+TEST(TagMatch, Start)
+{
+    const uint64_t tags[] = { 7, 1, 7, 2, 3, 7, 4, 5, 6 };
+    EXPECT_EQ(0, findTag(tags, 9, 7));
+    EXPECT_EQ(2, findTag(tags, 9, 7, 1));
+    EXPECT_EQ(5, findTag(tags, 9, 7, 3));
+    EXPECT_EQ(9, findTag(tags, 9, 7, 6));
+    EXPECT_EQ(9, findTag(tags, 9, 7, 9));
+}
+
+TEST(TagMatch, RandomAgainstScalar)
+{
+    std::mt19937_64 rng(1);
+    for (unsigned n = 0; n < 10000; n++) {
+        const unsigned num_tags = 1 + rng() % 40;
+        std::vector<uint64_t> tags(num_tags);
+        for (auto &tag : tags)
+            tag = rng() % 16;
+        const uint64_t key = rng() % 16;
+        const unsigned start = rng() % (num_tags + 1);
+        EXPECT_EQ(findTagScalar(tags.data(), num_tags, key, start),
+                  findTag(tags.data(), num_tags, key, start));
+    }
+}
+
+TEST(TagMatch, TagStores)
+{
+    // Lookups in tag stores of the usual associativities, with a mix of
+    // hits in random ways and misses
+    const unsigned num_sets = 1024;
+    const unsigned num_lookups = 1 << 16;
+
+    for (unsigned assoc : { 4, 8, 16, 32 }) {
+        std::mt19937_64 rng(assoc);
+        std::vector<uint64_t> tags(num_sets * assoc);
+        for (auto &tag : tags)
+            tag = rng() >> 16;
+
+        for (unsigned n = 0; n < num_lookups; n++) {
+            const unsigned set = rng() % num_sets;
+            // three quarters of the lookups hit
+            const uint64_t key = (rng() % 4) ?
+                tags[set * assoc + rng() % assoc] : rng() >> 16;
+            const uint64_t *ways = &tags[set * assoc];
+            ASSERT_EQ(findTagScalar(ways, assoc, key, 0),
+                      findTag(ways, assoc, key, 0));
+        }
+    }
+}
+
+namespace {
+
+/**
+ * Time lookups in a tag store of the given associativity, with a mix
+ * of hits in random ways and misses.
+ */
+template <class Find>
+double
+timeLookups(unsigned assoc, Find find, uint64_t &checksum)
+{
+    const unsigned num_sets = 1024;
+    const unsigned num_lookups = 1 << 22;
+
+    std::mt19937_64 rng(assoc);
+    std::vector<uint64_t> tags(num_sets * assoc);
+    for (auto &tag : tags)
+        tag = rng() >> 16;
+
+    std::vector<std::pair<unsigned, uint64_t>> lookups(num_lookups);
+    for (auto &lookup : lookups) {
+        lookup.first = rng() % num_sets;
+        // three quarters of the lookups hit
+        lookup.second = (rng() % 4) ?
+            tags[lookup.first * assoc + rng() % assoc] : rng() >> 16;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto &lookup : lookups)
+        checksum += find(&tags[lookup.first * assoc], assoc, lookup.second, 0);
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    return elapsed.count();
+}
+
+} // anonymous namespace
+
+// Compares the speed of the vector and scalar searches. Disabled by
+// default, run it with --gtest_also_run_disabled_tests.
+TEST(TagMatch, DISABLED_Benchmark)
+{
+    for (unsigned assoc : { 4, 8, 16, 32 }) {
+        uint64_t scalar_sum = 0, vector_sum = 0;
+        const double scalar_time =
+            timeLookups(assoc, findTagScalar, scalar_sum);
+        const double vector_time = timeLookups(assoc, findTag, vector_sum);
+
+        EXPECT_EQ(scalar_sum, vector_sum);
+        std::cout << assoc << "-way: scalar " << scalar_time
+                  << "s, vector " << vector_time << "s ("
+                  << scalar_time / vector_time << "x)" << std::endl;
+    }
+}
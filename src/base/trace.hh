@@ -38,6 +38,7 @@
 
 #include <string>
 
+#include "base/binary_trace.hh"
 #include "base/cprintf.hh"
 #include "base/debug.hh"
 #include "base/match.hh"
@@ -54,6 +55,20 @@ class Logger
     /** Name match for objects to ignore */
     ObjectMatch ignore;
 
+    /** Whether dprintf() records the arguments of messages with
+     *  recordMessage(), instead of formatting them */
+    bool recordsArgs = false;
+
+    /** Make room for a message recorded with its arguments, see
+     *  BinaryLogger.
+     *  @return Where to encode args_bytes bytes of arguments */
+    virtual uint8_t *recordMessage(Tick when, const std::string &name,
+                                   const char *fmt, unsigned args,
+                                   size_t args_bytes)
+    {
+        return nullptr;
+    }
+
   public:
     /** Log a single message */
     template <typename ...Args>
@@ -63,6 +78,13 @@ class Logger
         if (!name.empty() && ignore.match(name))
             return;
 
+        if (recordsArgs && BinaryTrace::AllBasic<Args...>::value) {
+            uint8_t *p = recordMessage(when, name, fmt, sizeof...(Args),
+                                       BinaryTrace::argBytes(args...));
+            BinaryTrace::encodeArgs(p, args...);
+            return;
+        }
+
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, line.str());
@@ -83,6 +105,16 @@ class Logger
      *  way, or just set to one of std::cout, std::cerr */
     virtual std::ostream &getOstream() = 0;
 
+    /** Write out the messages the logger holds, e.g., before the
+     *  simulator exits */
+    virtual void flush() { }
+
+    /** Write out what flush() would when the simulator crashes, from a
+     *  signal handler. It must not wait for anything, as the thread
+     *  holding it may be the one that crashed or may never run again,
+     *  so it writes nothing rather than block. */
+    virtual void crashFlush() { }
+
     /** Set objects to ignore */
     void setIgnore(ObjectMatch &ignore_) { ignore = ignore_; }
 
@@ -50,9 +50,11 @@ from m5.SimObject import *
 from m5.defines import buildEnv
 from m5.params import *
 from m5.proxy import *
+from m5.util import fatal
 from m5.util.fdthelper import *
 
 from XBar import L2XBar
+from QueueBridge import QueueBridge
 from InstTracer import InstTracer
 from CPUTracers import ExeTracer
 from MemObject import MemObject
@@ -269,7 +271,7 @@ class BaseCPU(MemObject):
         for p in self._cached_ports:
             exec('self.%s = bus.slave' % p)
 
-    def connectUncachedPorts(self, bus):
+    def _setUncachedPorts(self):
         # reinit to empty allows SMP to work; each thread allows SMT to work
         if buildEnv['TARGET_ISA'] == 'x86':
             self._uncached_slave_ports = []
@@ -278,6 +280,9 @@ class BaseCPU(MemObject):
                 self._uncached_slave_ports += ["interrupts[" + str(i) + "].pio",
                                 "interrupts[" + str(i) + "].int_slave"]
                 self._uncached_master_ports += ["interrupts[" + str(i) + "].int_master"]
+
+    def connectUncachedPorts(self, bus):
+        self._setUncachedPorts()
         for p in self._uncached_slave_ports:
             exec('self.%s = bus.master' % p)
         for p in self._uncached_master_ports:
@@ -289,6 +294,48 @@ class BaseCPU(MemObject):
             uncached_bus = cached_bus
         self.connectUncachedPorts(uncached_bus)
 
+    # Move the CPU, with everything below it (e.g., its private caches),
+    # to its own event queue, and connect it to buses in the shared event
+    # queue through QueueBridges. The bridges do not forward snoops, so
+    # the CPU is not coherent with the rest of the system: it must run
+    # processes of its own in syscall emulation mode (the workload has
+    # to be set first), and none of them may share memory with another
+    # CPU.
+    def connectAllPortsParallel(self, eventq_index, cached_bus,
+                                uncached_bus = None, shared_eventq_index = 0,
+                                delay = '2ns'):
+        if not self.workload:
+            fatal("connectAllPortsParallel() needs the CPU's syscall "
+                  "emulation workload; full system is not supported.")
+        if not uncached_bus:
+            uncached_bus = cached_bus
+        self._setUncachedPorts()
+
+        self.eventq_index = eventq_index
+
+        bridges = []
+        def bridge(slave_eventq_index, master_eventq_index):
+            b = QueueBridge(eventq_index = slave_eventq_index,
+                            master_eventq_index = master_eventq_index,
+                            delay = delay)
+            bridges.append(b)
+            return b
+
+        for p in self._cached_ports:
+            b = bridge(eventq_index, shared_eventq_index)
+            exec('self.%s = b.slave' % p)
+            b.master = cached_bus.slave
+        for p in self._uncached_slave_ports:
+            b = bridge(shared_eventq_index, eventq_index)
+            b.slave = uncached_bus.master
+            exec('self.%s = b.master' % p)
+        for p in self._uncached_master_ports:
+            b = bridge(eventq_index, shared_eventq_index)
+            exec('self.%s = b.slave' % p)
+            b.master = uncached_bus.slave
+
+        self.queue_bridges = bridges
+
     def addPrivateSplitL1Caches(self, ic, dc, iwc = None, dwc = None):
         self.icache = ic
         self.dcache = dc
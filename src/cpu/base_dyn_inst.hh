@@ -202,6 +202,8 @@ class BaseDynInst : public ExecContext, public RefCounted
     Addr collider_PC;
     InstSeqNum colliderSeqNum;
     DynInstPtr violator;
+    /* DOLMA: load named by violatorSeqNum, so the ROB needn't search for it */
+    DynInstPtr violatorLoad;
 
   public:
     Addr violator_PC;
@@ -606,11 +608,46 @@ class BaseDynInst : public ExecContext, public RefCounted
 
     /* Begin DOLMA functions */
 
+    /* Tell the ROB that the safety state of this inst changed, so it
+     * re-evaluates it; see ROB::updateSafeStatus() */
+    void safetyChanged()
+    {
+        if (cpu->isDolma()) {
+            cpu->dolmaSafetyChanged(
+                static_cast<typename Impl::DynInst *>(this));
+        }
+    }
+
     void setViolator(DynInstPtr inst)
     {
         assert(cpu->isDolma());
         assert(!cpu->isSTT());
         violator = inst;
+        safetyChanged();
+    }
+
+    /* DOLMA: record the load that this store's address resolution caught
+     * executing out of order with it */
+    void setViolatorLoad(const DynInstPtr &load)
+    {
+        violatorSeqNum = load->seqNum;
+        violatorLoad = load;
+        safetyChanged();
+    }
+
+    void clearViolatorLoad()
+    {
+        violatorSeqNum = 0;
+        violatorLoad = NULL;
+    }
+
+    DynInstPtr &getViolatorLoad() { return violatorLoad; }
+
+    /* DOLMA: set the youngest data inducer this inst depends on */
+    void setYdi(InstSeqNum _ydi)
+    {
+        ydi = _ydi;
+        safetyChanged();
     }
 
     DynInstPtr getViolator()
@@ -636,6 +673,7 @@ class BaseDynInst : public ExecContext, public RefCounted
         status.set(PendingMemOrder);
         status.reset(CanCommit);
         violator_PC = instAddr();
+        safetyChanged();
     }
     void setPendingMemOrder(DynInstPtr &store) {
         assert(cpu->isDolma());
@@ -647,12 +685,14 @@ class BaseDynInst : public ExecContext, public RefCounted
             collider_PC = store->instAddr();
         }
         violator_PC = instAddr();
+        safetyChanged();
     }
     
     void clearPendingMemOrder()
     {
         status.reset(PendingMemOrder);
         status.set(CanCommit);
+        safetyChanged();
     }
 
     bool branchTaken = false;
@@ -673,11 +713,18 @@ class BaseDynInst : public ExecContext, public RefCounted
     void setControlInducer() {
         assert(cpu->isDolma());
         assert(!isSquashed());
+        assert(!status[ControlInducer]);
         status.set(ControlInducer);
+        cpu->dolmaControlInducerAdded(threadNumber);
+        safetyChanged();
     }
 
     void clearControlInducer() {
+        if (isControlInducer()) {
+            cpu->dolmaControlInducerResolved(threadNumber);
+        }
         status.reset(ControlInducer);
+        safetyChanged();
     }
 
     bool isControlInducer() {
@@ -690,10 +737,12 @@ class BaseDynInst : public ExecContext, public RefCounted
         assert(!isSquashed());
         assert(!strictlyOrdered());
         status.set(DataInducer);
+        safetyChanged();
     }
 
     void clearDataInducer() {
         status.reset(DataInducer);
+        safetyChanged();
     }
 
     bool isDataInducer() {
@@ -721,6 +770,7 @@ class BaseDynInst : public ExecContext, public RefCounted
         status.reset(PendingMemOrder);
         status.reset(PendingBranch);
         status.set(DolmaStalled);
+        safetyChanged();
         if (dolmaVirtualReq) {
             dolmaVirtualReq.reset();
             dolmaVirtualReq = NULL;
@@ -747,7 +797,13 @@ class BaseDynInst : public ExecContext, public RefCounted
 
     bool isDolmaStalled() const { return !isSquashed() && status[DolmaStalled]; }
 
-    void clearDolmaStalled() { status.reset(DolmaStalled); }
+    void clearDolmaStalled()
+    {
+        if (isDolmaStalled()) {
+            cpu->dolmaStallReleased(seqNum);
+        }
+        status.reset(DolmaStalled);
+    }
 
     void setControlRestricted()
     {
@@ -756,11 +812,13 @@ class BaseDynInst : public ExecContext, public RefCounted
         assert(!isControlRestricted());
 
         status.set(ControlRestricted);
+        safetyChanged();
     }
 
     void clearControlRestricted()
     {
         status.reset(ControlRestricted);
+        safetyChanged();
     }
 
     bool isControlRestricted() const { return !isSquashed() && status[ControlRestricted]; }
@@ -770,11 +828,13 @@ class BaseDynInst : public ExecContext, public RefCounted
         assert(cpu->isDolma());
         assert(!isSquashed());
         status.set(DataRestricted);
+        safetyChanged();
     }
 
     void clearDataRestricted()
     {
         status.reset(DataRestricted);
+        safetyChanged();
     }
 
     bool isDataRestricted() const { return !isSquashed() && status[DataRestricted]; }
@@ -782,9 +842,13 @@ class BaseDynInst : public ExecContext, public RefCounted
     void untaint()
     {
         assert(isDolmaRestricted());
+        if (isDolmaStalled()) {
+            cpu->dolmaStallReleased(seqNum);
+        }
         status.reset(DolmaStalled);
         status.reset(ControlRestricted);
         status.reset(DataRestricted);
+        safetyChanged();
     }
 
     /* End DOLMA functions */
@@ -1006,7 +1070,14 @@ class BaseDynInst : public ExecContext, public RefCounted
 
     /** Sets this instruction as squashed. */
     void setSquashed() {
+        if (isControlInducer()) {
+            cpu->dolmaControlInducerResolved(threadNumber);
+        }
+        if (isDolmaStalled()) {
+            cpu->dolmaStallReleased(seqNum);
+        }
         status.set(Squashed);
+        safetyChanged();
         if (dolmaVirtualReq) {
             dolmaVirtualReq.reset();
             dolmaVirtualReq = NULL;
@@ -1046,7 +1117,18 @@ class BaseDynInst : public ExecContext, public RefCounted
     bool isInIQ() const { return status[IqEntry]; }
 
     /** Sets this instruction as squashed in the IQ. */
-    void setSquashedInIQ() { status.set(SquashedInIQ); status.set(Squashed);}
+    void setSquashedInIQ()
+    {
+        if (isControlInducer()) {
+            cpu->dolmaControlInducerResolved(threadNumber);
+        }
+        if (isDolmaStalled()) {
+            cpu->dolmaStallReleased(seqNum);
+        }
+        status.set(SquashedInIQ);
+        status.set(Squashed);
+        safetyChanged();
+    }
 
     /** Returns whether or not this instruction is squashed in the IQ. */
     bool isSquashedInIQ() const { return status[SquashedInIQ]; }
@@ -1190,7 +1272,7 @@ BaseDynInst<Impl>::initiateMemRead(Addr addr, unsigned size,
         sreqLow = savedSreqLow;
         sreqHigh = savedSreqHigh;
     } else {
-        req = std::make_shared<Request>(
+        req = Request::create(
             asid, addr, size, flags, masterId(),
             this->pc.instAddr(), thread->contextId());
 
@@ -1209,9 +1291,10 @@ BaseDynInst<Impl>::initiateMemRead(Addr addr, unsigned size,
             effAddr = req->getVaddr();
             effSize = size;
             instFlags[EffAddrValid] = true;
+            safetyChanged();
 
             if (cpu->checker) {
-                reqToVerify = std::make_shared<Request>(*req);
+                reqToVerify = Request::create(*req);
             }
             fault = cpu->read(req, sreqLow, sreqHigh, lqIdx);
         }
@@ -1246,7 +1329,7 @@ BaseDynInst<Impl>::writeMem(uint8_t *data, unsigned size, Addr addr,
         sreqLow = savedSreqLow;
         sreqHigh = savedSreqHigh;
     } else {
-        req = std::make_shared<Request>(
+        req = Request::create(
             asid, addr, size, flags, masterId(),
             this->pc.instAddr(), thread->contextId());
 
@@ -1263,9 +1346,10 @@ BaseDynInst<Impl>::writeMem(uint8_t *data, unsigned size, Addr addr,
         effAddr = req->getVaddr();
         effSize = size;
         instFlags[EffAddrValid] = true;
+        safetyChanged();
 
         if (cpu->checker) {
-            reqToVerify = std::make_shared<Request>(*req);
+            reqToVerify = Request::create(*req);
         }
         // DOLMA: cache writes on o3 processor are non-spec, so we can
         // clear now
@@ -1340,11 +1424,11 @@ BaseDynInst<Impl>::initiateTranslation(const RequestPtr &req,
     // DOLMA: Make sure translation request is marked unsafe
     // STT doesn't classify stores as unsafe
     if (isDolmaRestricted() && (!cpu->isSTT() || !isStore())) {
-        dolmaVirtualReq = std::make_shared<Request>(*req);
+        dolmaVirtualReq = Request::create(*req);
         req->setUnsafe();
         if (sreqLow) {
-            dolmaVirtualSreqLow = std::make_shared<Request>(*sreqLow);
-            dolmaVirtualSreqHigh = std::make_shared<Request>(*sreqHigh);
+            dolmaVirtualSreqLow = Request::create(*sreqLow);
+            dolmaVirtualSreqHigh = Request::create(*sreqHigh);
             sreqLow->setUnsafe();
             sreqHigh->setUnsafe();
         }
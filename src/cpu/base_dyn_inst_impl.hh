@@ -96,6 +96,8 @@ BaseDynInst<Impl>::initVars()
     colliderSeqNum = 0;
     violator = NULL;
     violatorSeqNum = 0;
+    violatorLoad = NULL;
+    violator_PC = 0;
 
     memData = NULL;
     effAddr = 0;
@@ -1354,7 +1354,7 @@ X86KvmCPU::handleKvmExitIO()
     // prevent races in multi-core mode.
     EventQueue::ScopedMigration migrate(deviceEventQueue());
     for (int i = 0; i < count; ++i) {
-        RequestPtr io_req = std::make_shared<Request>(
+        RequestPtr io_req = Request::create(
             pAddr, kvm_run.io.size,
             Request::UNCACHEABLE, dataMasterId());
 
@@ -527,6 +527,28 @@ FullO3CPU<Impl>::regStats()
         .precision(6);
     totalIpc =  sum(committedInsts) / numCycles;
 
+    dynInstPoolHits
+        .method(&dynInstPool, &DynInstPool::hits)
+        .name(name() + ".dynInstPoolHits")
+        .desc("Dynamic instructions allocated from blocks freed by earlier "
+              "ones");
+
+    dynInstPoolMisses
+        .method(&dynInstPool, &DynInstPool::misses)
+        .name(name() + ".dynInstPoolMisses")
+        .desc("Dynamic instruction allocations that took a new slab from "
+              "the heap");
+
+    dynInstPoolOccupancy
+        .method(&dynInstPool, &DynInstPool::occupancy)
+        .name(name() + ".dynInstPoolOccupancy")
+        .desc("Dynamic instructions currently allocated");
+
+    dynInstPoolPeakOccupancy
+        .method(&dynInstPool, &DynInstPool::peakOccupancy)
+        .name(name() + ".dynInstPoolPeakOccupancy")
+        .desc("Largest number of dynamic instructions allocated at once");
+
     this->fetch.regStats();
     this->decode.regStats();
     this->rename.regStats();
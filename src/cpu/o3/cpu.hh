@@ -59,6 +59,7 @@
 #include "config/the_isa.hh"
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/cpu_policy.hh"
+#include "cpu/o3/dyn_inst_pool.hh"
 #include "cpu/o3/scoreboard.hh"
 #include "cpu/o3/thread_state.hh"
 #include "cpu/activity.hh"
@@ -547,6 +548,27 @@ class FullO3CPU : public BaseO3CPU
      */
     void removeFrontInst(DynInstPtr &inst);
 
+    /** DOLMA: Notes that the speculative-safety state of an in-flight
+     *  instruction changed, so the ROB must re-evaluate it.
+     */
+    void dolmaSafetyChanged(const DynInstPtr &inst)
+    { rob.safetyChanged(inst); }
+
+    /** DOLMA: Keep the ROB's per-thread count of unresolved control
+     *  inducers in step with the instructions' ControlInducer status.
+     */
+    void dolmaControlInducerAdded(ThreadID tid)
+    { rob.controlInducerAdded(tid); }
+
+    void dolmaControlInducerResolved(ThreadID tid)
+    { rob.controlInducerResolved(tid); }
+
+    /** DOLMA: Tells the IQ that a stalled instruction may now proceed
+     *  because it became safe or was squashed.
+     */
+    void dolmaStallReleased(InstSeqNum seq_num)
+    { iew.instQueue.dolmaStallReleased(seq_num); }
+
     /** Remove all instructions that are not currently in the ROB.
      *  There's also an option to not squash delay slot instructions.*/
     void removeInstsNotInROB(ThreadID tid);
@@ -564,6 +586,12 @@ class FullO3CPU : public BaseO3CPU
     void dumpInsts();
 
   public:
+    /**
+     * Storage of the dynamic instructions. It comes before everything
+     * that may hold instructions, so that it is destroyed after them.
+     */
+    DynInstPool dynInstPool;
+
 #ifndef NDEBUG
     /** Count of total number of dynamic instructions in flight. */
     int instcount;
@@ -801,6 +829,13 @@ class FullO3CPU : public BaseO3CPU
     //number of misc
     Stats::Scalar miscRegfileReads;
     Stats::Scalar miscRegfileWrites;
+
+    /** Stats of the dynamic instruction pool. They are host stats, and
+     * are not reset with the others. */
+    Stats::Value dynInstPoolHits;
+    Stats::Value dynInstPoolMisses;
+    Stats::Value dynInstPoolOccupancy;
+    Stats::Value dynInstPoolPeakOccupancy;
 };
 
 #endif // __CPU_O3_CPU_HH__
\ No newline at end of file
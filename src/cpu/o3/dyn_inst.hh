@@ -94,6 +94,26 @@ class BaseO3DynInst : public BaseDynInst<Impl>
 
     ~BaseO3DynInst();
 
+    /** Take the instruction from the pool of its CPU. */
+    static void *
+    operator new(size_t size, DynInstPool &pool)
+    {
+        return pool.allocate(size);
+    }
+
+    /** Only called if the constructor throws. */
+    static void
+    operator delete(void *p, DynInstPool &pool)
+    {
+        DynInstPool::deallocate(p);
+    }
+
+    static void
+    operator delete(void *p)
+    {
+        DynInstPool::deallocate(p);
+    }
+
     /** Executes the instruction.*/
     Fault execute();
 
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/dyn_inst_pool.hh"
+
+#include <cassert>
+#include <new>
+
+#include "base/intmath.hh"
+
+namespace {
+
+/** Header of a block, before the instruction it holds. */
+struct BlockHeader
+{
+    DynInstPool *pool;
+};
+
+static_assert(sizeof(BlockHeader) <= DynInstPool::lineBytes,
+              "DynInstPool block header does not fit in a line");
+
+/** Bytes of blocks taken from the heap at once. */
+const size_t slabBytes = 256 * 1024;
+
+} // anonymous namespace
+
+const size_t DynInstPool::lineBytes;
+
+DynInstPool::DynInstPool()
+    : blockSize(0), freeList(nullptr), _hits(0), _misses(0),
+      _occupancy(0), _peakOccupancy(0)
+{
+}
+
+void
+DynInstPool::refill()
+{
+    const size_t blocks = slabBytes > blockSize ? slabBytes / blockSize : 1;
+
+    // Slabs are never freed, so there is no need to remember where the
+    // unaligned allocation started
+    char *slab = static_cast<char *>(
+        ::operator new(blocks * blockSize + lineBytes - 1));
+    slab = reinterpret_cast<char *>(
+        roundUp(reinterpret_cast<uintptr_t>(slab), (uintptr_t)lineBytes));
+
+    for (size_t i = blocks; i-- > 0; ) {
+        char *block = slab + i * blockSize;
+        reinterpret_cast<BlockHeader *>(block)->pool = this;
+        FreeBlock *free_block =
+            reinterpret_cast<FreeBlock *>(block + lineBytes);
+        free_block->next = freeList;
+        freeList = free_block;
+    }
+}
+
+void *
+DynInstPool::allocate(size_t size)
+{
+    if (!blockSize)
+        blockSize = lineBytes + roundUp(size, lineBytes);
+    assert(lineBytes + size <= blockSize);
+
+    if (freeList) {
+        _hits++;
+    } else {
+        _misses++;
+        refill();
+    }
+
+    FreeBlock *block = freeList;
+    freeList = block->next;
+
+    if (++_occupancy > _peakOccupancy)
+        _peakOccupancy = _occupancy;
+
+    return block;
+}
+
+void
+DynInstPool::deallocate(void *p)
+{
+    if (!p)
+        return;
+
+    char *block = static_cast<char *>(p) - lineBytes;
+    DynInstPool *pool = reinterpret_cast<BlockHeader *>(block)->pool;
+
+    FreeBlock *free_block = static_cast<FreeBlock *>(p);
+    free_block->next = pool->freeList;
+    pool->freeList = free_block;
+    pool->_occupancy--;
+}
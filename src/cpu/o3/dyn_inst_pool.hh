@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_DYN_INST_POOL_HH__
+#define __CPU_O3_DYN_INST_POOL_HH__
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Storage of the dynamic instructions of one CPU. Most instructions are
+ * squashed soon after fetch, so the blocks they free are handed back to
+ * the next instructions fetched instead of going through malloc. Blocks
+ * are cache line aligned, and each one starts with a header naming its
+ * pool, so that an instruction freed through a plain delete returns to
+ * the CPU it came from. The blocks are taken from the heap a slab at a
+ * time and are never given back to it, and the instructions of a CPU
+ * must not outlive it.
+ *
+ * Reused blocks are not cleared: the instruction constructors must
+ * initialise every field, see BaseDynInst::initVars().
+ */
+class DynInstPool
+{
+  public:
+    /** Alignment of the blocks, and size of their header. */
+    static const size_t lineBytes = 64;
+
+  private:
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    /** Size of the blocks, header included, or 0 before the first. */
+    size_t blockSize;
+
+    FreeBlock *freeList;
+
+    uint64_t _hits;
+    uint64_t _misses;
+    uint64_t _occupancy;
+    uint64_t _peakOccupancy;
+
+    void refill();
+
+  public:
+    DynInstPool();
+
+    DynInstPool(const DynInstPool &) = delete;
+    DynInstPool &operator=(const DynInstPool &) = delete;
+
+    /**
+     * Get a block for an instruction. All the instructions of a pool
+     * must have the same size.
+     */
+    void *allocate(size_t size);
+
+    /** Return the block of an instruction to the pool it came from. */
+    static void deallocate(void *p);
+
+    /** Allocations served from a block freed by an earlier one. */
+    uint64_t hits() const { return _hits; }
+
+    /** Allocations that had to take a new slab from the heap. */
+    uint64_t misses() const { return _misses; }
+
+    /** Instructions currently allocated. */
+    uint64_t occupancy() const { return _occupancy; }
+
+    /** Largest number of instructions ever allocated at once. */
+    uint64_t peakOccupancy() const { return _peakOccupancy; }
+};
+
+#endif // __CPU_O3_DYN_INST_POOL_HH__
@@ -44,6 +44,7 @@
 #ifndef __CPU_O3_INST_QUEUE_HH__
 #define __CPU_O3_INST_QUEUE_HH__
 
+#include <functional>
 #include <list>
 #include <map>
 #include <queue>
@@ -266,6 +267,12 @@ class InstructionQueue
     /* Stall an inst for DOLMA, and update stats about stalled insts */
     void dolmaStallInst(DynInstPtr &blocked_inst);
 
+    /** DOLMA: Notes that the instruction with the given sequence number is
+     *  no longer stalled, so getDolmaStalledInstToExecute() may return it.
+     */
+    void dolmaStallReleased(InstSeqNum seq_num)
+    { releasedDolmaStalls.push(seq_num); }
+
     /**  Notify instruction queue that a previous blockage has resolved */
     void cacheUnblocked();
 
@@ -347,8 +354,16 @@ class InstructionQueue
     /** List of instructions that have been cache blocked. */
     std::list<DynInstPtr> blockedMemInsts;
 
-    /** List of instructions that have been stalled by DOLMA. */
-    std::list<DynInstPtr> dolmaStalledInsts;
+    /** Instructions that have been stalled by DOLMA, by sequence number. */
+    std::map<InstSeqNum, DynInstPtr> dolmaStalledInsts;
+
+    /** Sequence numbers of DOLMA-stalled instructions that were released
+     *  (became safe or were squashed), oldest on top. May hold entries for
+     *  instructions that have since left dolmaStalledInsts or were stalled
+     *  again; those are discarded when they reach the top.
+     */
+    std::priority_queue<InstSeqNum, std::vector<InstSeqNum>,
+                        std::greater<InstSeqNum> > releasedDolmaStalls;
 
     /** List of instructions that were cache blocked, but a retry has been seen
      * since, so they can now be retried. May fail again go on the blocked list.
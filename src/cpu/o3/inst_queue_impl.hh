@@ -442,6 +442,8 @@ InstructionQueue<Impl>::resetState()
     blockedMemInsts.clear();
     retryMemInsts.clear();
     dolmaStalledInsts.clear();
+    while (!releasedDolmaStalls.empty())
+        releasedDolmaStalls.pop();
     wbOutstanding = 0;
 }
 
@@ -1195,7 +1197,7 @@ InstructionQueue<Impl>::wakeDependentInstructions(DynInstPtr &completed_inst)
                 // DOLMA: track youngest data inducer for safety purposes
                 InstSeqNum new_ydi = completed_inst->isDataInducer() ? completed_inst->seqNum : completed_inst->ydi;
                 if (!dep_inst->ydi || dep_inst->ydi < new_ydi) {
-                    dep_inst->ydi = new_ydi;
+                    dep_inst->setYdi(new_ydi);
                 }
                 if (!dep_inst->isDataRestricted()) {
                     dep_inst->setDataRestricted();
@@ -1315,16 +1317,14 @@ void
 InstructionQueue<Impl>::dolmaStallInst(DynInstPtr &inst)
 {
     assert(inst->isDolmaStalled());
-    for (auto it = dolmaStalledInsts.begin(); it != dolmaStalledInsts.end();
-    ++it) {
-        assert(inst->seqNum != (*it)->seqNum);
-    }
 
     inst->translationStarted(false);
     inst->translationCompleted(false);
 
     inst->clearIssued();
-    dolmaStalledInsts.push_back(inst);
+    bool M5_VAR_USED inserted =
+        dolmaStalledInsts.emplace(inst->seqNum, inst).second;
+    assert(inserted);
 }
 
 template <class Impl>
@@ -1357,26 +1357,21 @@ template <class Impl>
 typename Impl::DynInstPtr
 InstructionQueue<Impl>::getDolmaStalledInstToExecute()
 {
-    DynInstPtr oldest = NULL;
-    for (auto it = dolmaStalledInsts.begin(); it != dolmaStalledInsts.end();
-         ++it) {
-        if (!(*it)->isDolmaStalled()) {
-            DynInstPtr inst = *it;
-            if (!oldest || inst->seqNum < oldest->seqNum) {
-                oldest = inst;
-            }
-        }
-    }
-    if (oldest) {
-        for (auto it = dolmaStalledInsts.begin(); it != dolmaStalledInsts.end();
-         ++it) {
-            if ((*it)->seqNum == oldest->seqNum) {
-                dolmaStalledInsts.erase(it);
-                break;
-            }
+    while (!releasedDolmaStalls.empty()) {
+        InstSeqNum seq_num = releasedDolmaStalls.top();
+        releasedDolmaStalls.pop();
+
+        auto it = dolmaStalledInsts.find(seq_num);
+        // stale entry: already handed out, or stalled again since
+        if (it == dolmaStalledInsts.end() || it->second->isDolmaStalled()) {
+            continue;
         }
+
+        DynInstPtr oldest = it->second;
+        dolmaStalledInsts.erase(it);
+        return oldest;
     }
-    return oldest;
+    return NULL;
 }
 
 template <class Impl>
@@ -1620,7 +1615,7 @@ InstructionQueue<Impl>::addToDependents(DynInstPtr &new_inst)
                     assert(!regToProducerInst[src_reg->flatIndex()]->isCommitted());
                     InstSeqNum new_ydi = regToProducerInst[src_reg->flatIndex()]->isDataInducer() ? regToProducerInst[src_reg->flatIndex()]->seqNum : regToProducerInst[src_reg->flatIndex()]->ydi;
                     if (!new_inst->ydi || new_inst->ydi < new_ydi) {
-                        new_inst->ydi = new_ydi;
+                        new_inst->setYdi(new_ydi);
                     }
                     if (!new_inst->isDataRestricted()) {
                         new_inst->setDataRestricted();
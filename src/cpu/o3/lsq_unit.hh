@@ -953,10 +953,10 @@ LSQUnit<Impl>::read(const RequestPtr &req,
     }
 
     if (load_inst->isDolmaRestricted()) {
-        load_inst->dolmaPhysicalReq = std::make_shared<Request>(*req);
+        load_inst->dolmaPhysicalReq = Request::create(*req);
         if (sreqLow) {
-            load_inst->dolmaPhysicalSreqLow = std::make_shared<Request>(*sreqLow);
-            load_inst->dolmaPhysicalSreqHigh = std::make_shared<Request>(*sreqHigh);
+            load_inst->dolmaPhysicalSreqLow = Request::create(*sreqLow);
+            load_inst->dolmaPhysicalSreqHigh = Request::create(*sreqHigh);
         }
     }
 
@@ -619,7 +619,7 @@ LSQUnit<Impl>::checkViolations(int load_idx, DynInstPtr &inst)
                 ++lsqMemOrderViolation;
 
                 if (cpu->isDolma() && !cpu->isDolmaConservative() && !cpu->isSTT()) {
-                    inst->violatorSeqNum = ld_inst->seqNum;
+                    inst->setViolatorLoad(ld_inst);
                 }
 
                 return std::make_shared<GenericISA::M5PanicFault>(
@@ -1072,7 +1072,7 @@ DefaultRename<Impl>::renameSrcRegs(DynInstPtr &inst, ThreadID tid)
                     assert(!iew_ptr->instQueue.regToProducerInst[renamed_reg->flatIndex()]->isCommitted());
                     InstSeqNum new_ydi = iew_ptr->instQueue.regToProducerInst[renamed_reg->flatIndex()]->isDataInducer() ? iew_ptr->instQueue.regToProducerInst[renamed_reg->flatIndex()]->seqNum : iew_ptr->instQueue.regToProducerInst[renamed_reg->flatIndex()]->ydi;
                     if (!inst->ydi || inst->ydi < new_ydi) {
-                        inst->ydi = new_ydi;
+                        inst->setYdi(new_ydi);
                     }
                     if (!inst->isDataRestricted()) {
                         inst->setDataRestricted();
@@ -44,9 +44,9 @@
 #ifndef __CPU_O3_ROB_HH__
 #define __CPU_O3_ROB_HH__
 
+#include <map>
 #include <string>
 #include <utility>
-#include <vector>
 
 #include "arch/registers.hh"
 #include "base/types.hh"
@@ -288,10 +288,51 @@ class ROB
      */  
     void updateSafeStatus(ThreadID tid);
 
+    /** DOLMA: Notes that the speculative-safety state of an instruction
+     *  changed, so the next updateSafeStatus() re-evaluates it.
+     */
+    void safetyChanged(const DynInstPtr &inst)
+    { safety[inst->threadNumber].changed[inst->seqNum] = inst; }
+
+    /** DOLMA: Track the number of unresolved, unsquashed control inducers
+     *  each thread has in the ROB.
+     */
+    void controlInducerAdded(ThreadID tid)
+    { ++numControlInducers[tid]; }
+
+    void controlInducerResolved(ThreadID tid)
+    {
+        assert(numControlInducers[tid] > 0);
+        --numControlInducers[tid];
+    }
+
   private:
     /** Reset the ROB state */
     void resetState();
 
+    /** DOLMA: Re-evaluates the safety of an instruction, as a walk of
+     *  the ROB reaching it would.
+     */
+    void updateSafeStatus(ThreadID tid, DynInstPtr &inst);
+
+    /** DOLMA: Sequence numbers of the oldest unresolved control inducer,
+     *  store with an unresolved address and live load caught violating
+     *  memory order with an older store, or MaxSeqNum if there is none.
+     */
+    InstSeqNum oldestControlInducer(ThreadID tid);
+    InstSeqNum oldestUnresolvedStore(ThreadID tid);
+    InstSeqNum oldestViolator(ThreadID tid);
+
+    /** DOLMA: Whether an older instruction keeps a data inducer from
+     *  resolving.
+     */
+    bool dataInducerHeld(ThreadID tid, InstSeqNum seq_num);
+
+    /** DOLMA: Checks the incremental safety state against a walk of the
+     *  whole ROB, which would change nothing if it is up to date.
+     */
+    void checkSafeStatus(ThreadID tid);
+
     /** Pointer to the CPU. */
     O3CPU *cpu;
 
@@ -352,6 +393,54 @@ class ROB
     /** Is the ROB done squashing. */
     bool doneSquashing[Impl::MaxThreads];
 
+    /** DOLMA: Number of unresolved control inducers per thread. */
+    unsigned numControlInducers[Impl::MaxThreads];
+
+    static const InstSeqNum MaxSeqNum = (InstSeqNum)-1;
+
+    typedef std::map<InstSeqNum, DynInstPtr> InstMap;
+
+    /** DOLMA: What decides the safety of the instructions of a thread.
+     *  Instructions are only re-evaluated when their own state changes,
+     *  or when an older inducer they wait for resolves. Entries are
+     *  dropped lazily, once the state of their instruction no longer
+     *  matches.
+     */
+    struct SafetyState
+    {
+        /** Instructions to re-evaluate. */
+        InstMap changed;
+
+        /** Unresolved control inducers. */
+        InstMap controlInducers;
+
+        /** Stores whose address is unresolved. */
+        InstMap unresolvedStores;
+
+        /** Stores with a load caught violating memory order, by the
+         *  sequence numbers of the load and of the store.
+         */
+        std::map<std::pair<InstSeqNum, InstSeqNum>, DynInstPtr> violators;
+
+        /** Unresolved data inducers. */
+        InstMap dataInducers;
+
+        /** Unresolved data inducers only held by older instructions. */
+        InstMap heldDataInducers;
+
+        /** Control restricted instructions. */
+        InstMap controlRestricted;
+
+        /** Data restricted instructions, by the data inducer they depend
+         *  on.
+         */
+        std::map<InstSeqNum, InstMap> dataRestricted;
+
+        void clear();
+    };
+
+    SafetyState safety[Impl::MaxThreads];
+
     /** Number of active threads. */
     ThreadID numThreads;
 
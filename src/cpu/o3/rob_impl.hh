@@ -45,10 +45,12 @@
 #define __CPU_O3_ROB_IMPL_HH__
 
 #include <list>
+#include <set>
 
 #include "cpu/o3/rob.hh"
 #include "debug/Fetch.hh"
 #include "debug/ROB.hh"
+#include "debug/DolmaSafetyCheck.hh"
 #include "debug/DumpROB.hh"
 #include "debug/DumpROB_show_addr.hh"
 #include "debug/DumpROB_showSrcRegs.hh"
@@ -119,6 +121,8 @@ ROB<Impl>::resetState()
         threadEntries[tid] = 0;
         squashIt[tid] = instList[tid].end();
         squashedSeqNum[tid] = 0;
+        numControlInducers[tid] = 0;
+        safety[tid].clear();
     }
     numInstsInROB = 0;
 
@@ -128,6 +132,20 @@ ROB<Impl>::resetState()
     tail = instList[0].end();
 }
 
+template <class Impl>
+void
+ROB<Impl>::SafetyState::clear()
+{
+    changed.clear();
+    controlInducers.clear();
+    unresolvedStores.clear();
+    violators.clear();
+    dataInducers.clear();
+    heldDataInducers.clear();
+    controlRestricted.clear();
+    dataRestricted.clear();
+}
+
 template <class Impl>
 std::string
 ROB<Impl>::name() const
@@ -147,8 +165,10 @@ template <class Impl>
 void
 ROB<Impl>::drainSanityCheck() const
 {
-    for (ThreadID tid = 0; tid  < numThreads; tid++)
+    for (ThreadID tid = 0; tid  < numThreads; tid++) {
         assert(instList[tid].empty());
+        assert(numControlInducers[tid] == 0);
+    }
     assert(isEmpty());
 }
 
@@ -279,75 +299,26 @@ ROB<Impl>::insertInst(DynInstPtr &inst, IQ& instQueue, LSQ& lsq)
     tail--;
 
     inst->setInROB();
+    if (cpu->isDolma()) {
+        safetyChanged(inst);
+    }
 
     // DOLMA: set control restriction/inducer logic (data logic handled during broadcast)
     if (cpu->isDolma() && !inst->isSquashed()) {
 
-        InstIt end = instList[tid].end();
-
-        if (!cpu->isDolmaMemOnly()) {
-            for (InstIt it = instList[tid].begin(); it != end; ++it) {
-                if ((*it)->isControlInducer()) {
-                    inst->setControlRestricted();
-                    break;
-                }
-            }
+        if (!cpu->isDolmaMemOnly() && numControlInducers[tid]) {
+            inst->setControlRestricted();
         }
 
         // DOLMA: now we must determine whether this inst is a control inducer.
         // All control instructions that depend on runtime args (i.e., indirect or conditional ctrl)
         // are control inducers. Put another way, direct-unconditional branches are not control
         // inducers, because (on a real processor) they can be resolved at decode (before younger
-        // instructions can execute). Indeed, this logic exists for this processor in decode_impl.hh.
-        // Unfortunately, gem5 seems to have a bug where direct/conditional info isn't provided for X86,
-        // possibly because the branchTarget() function used in decode_impl is unimplemented for X86.
-        // What follows is thus semi-complicated logic that determines whether an x86 ctrl
-        // inst is a control inducer based on its mnemonic.
-
-        if (inst->isControl()) {
-            bool isControlInducer = false;
-
-            bool hasCtrlInfo = (inst->isDirectCtrl() != inst->isIndirectCtrl()) &&
-                (inst->isUncondCtrl() != inst->isCondCtrl());
-            if (hasCtrlInfo) {
-                // simple case: we have the needed ctrl info gem5 is supposed to provide
-                isControlInducer = !(inst->isDirectCtrl() && inst->isUncondCtrl());
-            }
-            else {
-                isControlInducer = true;
-                // tougher case: we must determine it ourselves b/c of the gem5 bug
-                const std::string &mnemonic_ = inst->staticInst->disassemble(inst->instAddr());
-                std::string mnemonic = mnemonic_;
-                while(mnemonic.size() && std::isspace(mnemonic.front())) {
-                    mnemonic.erase(0,1);
-                }
-
-                std::string inst_name = mnemonic.substr(0, mnemonic.find(" "));
-
-                // First, figure out direct/indirect
-                // Besides returns, X86 direct jumps end with "_I" (immediate) on gem5
-                std::string substr = "_I";
-
-                if (!inst->isReturn()) {
-                    if (inst_name.length() >= substr.length() &&
-                        (0 == inst_name.compare(inst_name.length() - substr.length(), substr.length(), substr))) {
-                        // now we know it's direct; determine if uncond
-                        // Besides calls, X86 uncond jumps start with "JMP" on gem5
-                        if (inst->isCall()) {
-                            isControlInducer = false;
-                        }
-                        else {
-                            substr = "JMP";
-                            if (0 == inst_name.compare(0, substr.length(), substr)) {
-                                isControlInducer = false;
-                            }
-                        }
-                    }
-                }
-            }
-            if (isControlInducer) {
-                inst->setControlInducer();
-            }
+        // instructions can execute). The StaticInst classifies itself once; see
+        // StaticInst::isCtrlInducer() (and the X86 override, as gem5 doesn't provide
+        // direct/conditional info for X86).
+        if (inst->isControl() && inst->staticInst->isCtrlInducer()) {
+            inst->setControlInducer();
         }
     }
 
@@ -382,65 +353,237 @@ ROB<Impl>::getResolvedRedirect(ThreadID tid)
     return NULL;
 }
 
+template <class Impl>
+const InstSeqNum ROB<Impl>::MaxSeqNum;
+
+template <class Impl>
+InstSeqNum
+ROB<Impl>::oldestControlInducer(ThreadID tid)
+{
+    InstMap &inducers = safety[tid].controlInducers;
+    while (!inducers.empty() &&
+           !inducers.begin()->second->isControlInducer()) {
+        inducers.erase(inducers.begin());
+    }
+    return inducers.empty() ? MaxSeqNum : inducers.begin()->first;
+}
+
+template <class Impl>
+InstSeqNum
+ROB<Impl>::oldestUnresolvedStore(ThreadID tid)
+{
+    InstMap &stores = safety[tid].unresolvedStores;
+    while (!stores.empty()) {
+        DynInstPtr &store = stores.begin()->second;
+        if (store->isInROB() && !store->isSquashed() &&
+            !store->effAddrValid()) {
+            return stores.begin()->first;
+        }
+        stores.erase(stores.begin());
+    }
+    return MaxSeqNum;
+}
+
+template <class Impl>
+InstSeqNum
+ROB<Impl>::oldestViolator(ThreadID tid)
+{
+    auto &violators = safety[tid].violators;
+    while (!violators.empty()) {
+        const InstSeqNum load_seq_num = violators.begin()->first.first;
+        DynInstPtr &store = violators.begin()->second;
+        if (store->isInROB() && !store->isSquashed() &&
+            store->effAddrValid() && store->violatorSeqNum == load_seq_num) {
+            // the violating load is only of interest while it is
+            // still in this thread's ROB and not squashed
+            DynInstPtr &load = store->getViolatorLoad();
+            assert(load && load->seqNum == load_seq_num);
+            if (load->isInROB() && !load->isSquashed()) {
+                return load_seq_num;
+            }
+            store->clearViolatorLoad();
+        }
+        violators.erase(violators.begin());
+    }
+    return MaxSeqNum;
+}
+
+template <class Impl>
+bool
+ROB<Impl>::dataInducerHeld(ThreadID tid, InstSeqNum seq_num)
+{
+    if (cpu->isDolmaMemOnly() && oldestControlInducer(tid) < seq_num) {
+        return true;
+    }
+    return !cpu->isSTT() && (oldestUnresolvedStore(tid) < seq_num ||
+                             oldestViolator(tid) <= seq_num);
+}
+
 // DOLMA: for updating micro-op safety status
 template <class Impl>
 void
 ROB<Impl>::updateSafeStatus(ThreadID tid)
 {
-    // can't clear control dependants once found unresolved branch
-    bool foundUnresolvedBranch = false;
-    bool foundUnresolvedStore = false;
+    SafetyState &state = safety[tid];
+
+    // control restrictions can be cleared once no older control inducer
+    // is left
+    const InstSeqNum oldest_control = oldestControlInducer(tid);
+    auto restricted = state.controlRestricted.begin();
+    while (restricted != state.controlRestricted.end() &&
+           restricted->first <= oldest_control) {
+        state.changed.insert(*restricted);
+        restricted = state.controlRestricted.erase(restricted);
+    }
 
-    // can only clear data dependants whose inducers aren't in this list
-    std::set<InstSeqNum> ydis;
-    InstSeqNum oldestViolator = (InstSeqNum) -1;
+    // data inducers held by older instructions resolve in age order, as
+    // whatever holds one holds the younger ones too
+    auto inducer = state.heldDataInducers.begin();
+    while (inducer != state.heldDataInducers.end() &&
+           !dataInducerHeld(tid, inducer->first)) {
+        state.changed.insert(*inducer);
+        inducer = state.heldDataInducers.erase(inducer);
+    }
 
-    InstIt end = instList[tid].end();
+    // an instruction only affects younger ones, so evaluating them in
+    // age order ends up where a walk of the whole ROB would
+    while (!state.changed.empty()) {
+        DynInstPtr inst = state.changed.begin()->second;
+        updateSafeStatus(tid, inst);
+        // along with the changes its own evaluation noted
+        state.changed.erase(inst->seqNum);
+    }
 
-    for (InstIt it = instList[tid].begin(); it != end; ++it) {
-        DynInstPtr &inst = *it;
-        
-        if (inst->isDolmaRestricted()) {
-            // control restrictions can be cleared when no unresolved branches precede inst
-            if (inst->isControlRestricted() && !foundUnresolvedBranch) {
-                inst->clearControlRestricted();
-            }
-            // data restrictions can be cleared when not dependent on unresolved data inducer
-            if (inst->isDataRestricted() && ydis.find(inst->ydi) == ydis.end()) {
-                inst->clearDataRestricted();
-            }
+    if (DTRACE(DolmaSafetyCheck)) {
+        checkSafeStatus(tid);
+    }
+}
 
-            // both control and data dependency must be cleared for op to be safe
-            if (!inst->isDolmaRestricted()) {
-                // STT stalls, so doesn't need to do metadata update
-                if (!cpu->isSTT() && !inst->isDolmaStalled() && inst->dolmaVirtualReq) {
-                    inst->setPendingMetadata();
-                }
-                if (inst->isDolmaStalled()) {
-                    inst->clearDolmaStalled();
-                }
-                else if (inst->isStore() && !cpu->isSTT()) {
-                    DynInstPtr violator = inst->getViolator();
-                    if (violator && !violator->isSquashed()) {
-                        violator->setPendingMemOrder(inst);
-                    }
-                }
+template <class Impl>
+void
+ROB<Impl>::updateSafeStatus(ThreadID tid, DynInstPtr &inst)
+{
+    SafetyState &state = safety[tid];
+    const InstSeqNum seq_num = inst->seqNum;
+
+    // only instructions in the ROB become safe
+    if (inst->isInROB() && inst->isDolmaRestricted()) {
+        // control restrictions can be cleared when no unresolved branches precede inst
+        if (inst->isControlRestricted() &&
+            !(oldestControlInducer(tid) < seq_num)) {
+            inst->clearControlRestricted();
+        }
+        // data restrictions can be cleared when not dependent on unresolved data inducer
+        if (inst->isDataRestricted()) {
+            auto ydi = state.dataInducers.find(inst->ydi);
+            if (ydi == state.dataInducers.end() ||
+                !ydi->second->isDataInducer()) {
+                inst->clearDataRestricted();
             }
         }
 
-        if (inst->isDataInducer()) {
-            if (cpu->isDolmaConservative() || inst->isPendingMemOrder()) {
-                ydis.insert(inst->seqNum);
+        // both control and data dependency must be cleared for op to be safe
+        if (!inst->isDolmaRestricted()) {
+            // STT stalls, so doesn't need to do metadata update
+            if (!cpu->isSTT() && !inst->isDolmaStalled() && inst->dolmaVirtualReq) {
+                inst->setPendingMetadata();
             }
-            else if (cpu->isDolmaMemOnly() && foundUnresolvedBranch) {
-                ydis.insert(inst->seqNum);
+            if (inst->isDolmaStalled()) {
+                inst->clearDolmaStalled();
             }
-            else if (!cpu->isSTT() && (foundUnresolvedStore || inst->seqNum >= oldestViolator)) {
-                ydis.insert(inst->seqNum);
+            else if (inst->isStore() && !cpu->isSTT()) {
+                DynInstPtr violator = inst->getViolator();
+                if (violator && !violator->isSquashed()) {
+                    violator->setPendingMemOrder(inst);
+                }
             }
-            else {
-                inst->clearDataInducer();
+        } else {
+            // wait for whatever still restricts it to resolve
+            if (inst->isControlRestricted()) {
+                state.controlRestricted[seq_num] = inst;
             }
+            if (inst->isDataRestricted()) {
+                state.dataRestricted[inst->ydi][seq_num] = inst;
+            }
+        }
+    }
+
+    if (inst->isInROB() && inst->isDataInducer()) {
+        if (cpu->isDolmaConservative() || inst->isPendingMemOrder()) {
+            // resolves at retirement or with its memory order
+            state.dataInducers[seq_num] = inst;
+            state.heldDataInducers.erase(seq_num);
+        }
+        else if (dataInducerHeld(tid, seq_num)) {
+            state.dataInducers[seq_num] = inst;
+            state.heldDataInducers[seq_num] = inst;
+        }
+        else {
+            inst->clearDataInducer();
+        }
+    }
+
+    // a resolved data inducer releases the instructions depending on it
+    if (!inst->isDataInducer() && state.dataInducers.erase(seq_num)) {
+        state.heldDataInducers.erase(seq_num);
+        auto waiting = state.dataRestricted.find(seq_num);
+        if (waiting != state.dataRestricted.end()) {
+            state.changed.insert(waiting->second.begin(),
+                                 waiting->second.end());
+            state.dataRestricted.erase(waiting);
+        }
+    }
+
+    if (inst->isSquashed()) {
+        state.controlInducers.erase(seq_num);
+        state.unresolvedStores.erase(seq_num);
+        state.controlRestricted.erase(seq_num);
+        return;
+    }
+    if (!inst->isInROB()) {
+        return;
+    }
+
+    if (inst->isControlInducer()) {
+        state.controlInducers[seq_num] = inst;
+    }
+    if (inst->isStore() && !cpu->isSTT() && !cpu->isDolmaConservative()) {
+        if (!inst->effAddrValid()) {
+            state.unresolvedStores[seq_num] = inst;
+        }
+        else if (inst->violatorSeqNum) {
+            state.violators[std::make_pair(inst->violatorSeqNum, seq_num)] =
+                inst;
+        }
+    }
+}
+
+template <class Impl>
+void
+ROB<Impl>::checkSafeStatus(ThreadID tid)
+{
+    bool foundUnresolvedBranch = false;
+    bool foundUnresolvedStore = false;
+    std::set<InstSeqNum> ydis;
+    InstSeqNum oldestViolator = MaxSeqNum;
+
+    for (DynInstPtr &inst : instList[tid]) {
+        panic_if(inst->isControlRestricted() && !foundUnresolvedBranch,
+                 "[sn:%lli] is control restricted, but no older control "
+                 "inducer is unresolved", inst->seqNum);
+        panic_if(inst->isDataRestricted() && !ydis.count(inst->ydi),
+                 "[sn:%lli] is data restricted, but its data inducer "
+                 "[sn:%lli] is resolved", inst->seqNum, inst->ydi);
+
+        if (inst->isDataInducer()) {
+            panic_if(!cpu->isDolmaConservative() &&
+                     !inst->isPendingMemOrder() &&
+                     !(cpu->isDolmaMemOnly() && foundUnresolvedBranch) &&
+                     (cpu->isSTT() || (!foundUnresolvedStore &&
+                                       inst->seqNum < oldestViolator)),
+                     "data inducer [sn:%lli] should have resolved",
+                     inst->seqNum);
+            ydis.insert(inst->seqNum);
         }
         if (inst->isControlInducer()) {
             foundUnresolvedBranch = true;
@@ -450,24 +593,15 @@ ROB<Impl>::updateSafeStatus(ThreadID tid)
                 foundUnresolvedStore = true;
             }
             else if (inst->violatorSeqNum && inst->violatorSeqNum < oldestViolator) {
-                DynInstPtr violator = findInst(tid, inst->violatorSeqNum);
-                if (violator) {
-                    if (!violator->isSquashed()) {
-                        oldestViolator = inst->violatorSeqNum;
-                    }
-                    else {
-                        inst->violatorSeqNum = 0;
-                    }
-                }
-                else {
-                    inst->violatorSeqNum = 0;
+                DynInstPtr &violator = inst->getViolatorLoad();
+                if (violator->isInROB() && !violator->isSquashed()) {
+                    oldestViolator = inst->violatorSeqNum;
                 }
             }
         }
     }
 }
 
-
 template <class Impl>
 void
 ROB<Impl>::retireHead(  ThreadID tid, 
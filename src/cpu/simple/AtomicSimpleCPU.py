@@ -61,6 +61,12 @@ class AtomicSimpleCPU(BaseSimpleCPU):
     width = Param.Int(1, "CPU width")
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
+    mem_backdoor = Param.Bool(False, "Access memory through the backdoors "
+                              "the memory system hands out, which bypass "
+                              "the stats of the memories and crossbars")
+    block_cache = Param.Bool(False, "Cache blocks of decoded instructions "
+                             "where the ISA allows it, needs mem_backdoor "
+                             "and no simulate_inst_stalls")
 
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
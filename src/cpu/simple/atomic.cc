@@ -43,6 +43,8 @@
 
 #include "cpu/simple/atomic.hh"
 
+#include <cstring>
+
 #include "arch/locked_mem.hh"
 #include "arch/mmapped_ipr.hh"
 #include "arch/utility.hh"
@@ -84,12 +86,16 @@ AtomicSimpleCPU::AtomicSimpleCPU(AtomicSimpleCPUParams *p)
       icachePort(name() + ".icache_port", this),
       dcachePort(name() + ".dcache_port", this),
       dcache_access(false), dcache_latency(0),
+      memBackdoor(p->mem_backdoor),
+      blockCacheEnabled(p->block_cache && p->mem_backdoor &&
+                        !p->simulate_inst_stalls && numThreads == 1),
+      curBlock(nullptr), curBlockInst(0),
       ppCommit(nullptr)
 {
     _status = Idle;
-    ifetch_req = std::make_shared<Request>();
-    data_read_req = std::make_shared<Request>();
-    data_write_req = std::make_shared<Request>();
+    ifetch_req = Request::create();
+    data_read_req = Request::create();
+    data_write_req = Request::create();
 }
 
 
@@ -150,6 +156,10 @@ AtomicSimpleCPU::drainResume()
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
+    // the memory and the threads may have been restored from a
+    // checkpoint
+    flushBlocks();
+
     assert(!threadContexts.empty());
 
     _status = BaseSimpleCPU::Idle;
@@ -198,6 +208,9 @@ AtomicSimpleCPU::switchOut()
     assert(!tickEvent.scheduled());
     assert(_status == BaseSimpleCPU::Running || _status == Idle);
     assert(isDrained());
+
+    backdoors.flush();
+    flushBlocks();
 }
 
 
@@ -277,6 +290,31 @@ AtomicSimpleCPU::sendPacket(MasterPort &port, const PacketPtr &pkt)
     return port.sendAtomic(pkt);
 }
 
+Tick
+AtomicSimpleCPU::sendMemAccess(MasterPort &port, const PacketPtr &pkt)
+{
+    const bool plain = (pkt->cmd == MemCmd::ReadReq ||
+                        pkt->cmd == MemCmd::WriteReq) &&
+        !pkt->req->isUncacheable();
+    if (!memBackdoor || !plain)
+        return sendPacket(port, pkt);
+
+    Tick latency;
+    if (uint8_t *host = backdoors.lookup(pkt->getAddr(), latency,
+                                         pkt->isWrite())) {
+        if (pkt->isRead())
+            pkt->setData(host);
+        else
+            pkt->writeData(host);
+        pkt->makeResponse();
+        return latency;
+    }
+
+    latency = sendPacket(port, pkt);
+    backdoors.fill(port, pkt->getAddr(), latency, pkt->isWrite());
+    return latency;
+}
+
 Tick
 AtomicSimpleCPU::AtomicCPUDPort::recvAtomicSnoop(PacketPtr pkt)
 {
@@ -372,7 +410,7 @@ AtomicSimpleCPU::readMem(Addr addr, uint8_t * data, unsigned size,
             if (req->isMmappedIpr()) {
                 dcache_latency += TheISA::handleIprRead(thread->getTC(), &pkt);
             } else {
-                dcache_latency += sendPacket(dcachePort, &pkt);
+                dcache_latency += sendMemAccess(dcachePort, &pkt);
             }
             dcache_access = true;
 
@@ -468,6 +506,18 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
         if (fault == NoFault) {
             bool do_access = true;  // flag to suppress cache access
 
+            // Code may be modifying itself, check the bytes of the
+            // instructions again
+            const Addr page = req->getPaddr() & ~(TheISA::PageBytes - 1);
+            if (curBlock &&
+                page == (curBlock->paddr & ~(TheISA::PageBytes - 1))) {
+                curBlock = nullptr;
+            }
+            if (newBlock &&
+                page == (newBlock->paddr & ~(TheISA::PageBytes - 1))) {
+                finishBlock();
+            }
+
             if (req->isLLSC()) {
                 do_access = TheISA::handleLockedWrite(thread, req, dcachePort.cacheBlockMask);
             } else if (req->isSwap()) {
@@ -485,7 +535,7 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
                     dcache_latency +=
                         TheISA::handleIprWrite(thread->getTC(), &pkt);
                 } else {
-                    dcache_latency += sendPacket(dcachePort, &pkt);
+                    dcache_latency += sendMemAccess(dcachePort, &pkt);
 
                     // Notify other threads on this CPU of write
                     threadSnoop(&pkt, curThread);
@@ -578,11 +628,21 @@ AtomicSimpleCPU::tick()
 
         bool needToFetch = !isRomMicroPC(pcState.microPC()) &&
                            !curMacroStaticInst;
-        if (needToFetch) {
+
+        // Instruction from the decoded block cache, if any
+        const DecodedBlockCache::Inst *decoded = nullptr;
+        const bool useBlocks = blockCacheEnabled && needToFetch &&
+            t_info.fetchOffset == 0;
+        if (useBlocks)
+            decoded = nextBlockInst(pcState);
+
+        if (needToFetch && !decoded) {
             ifetch_req->taskId(taskId());
             setupFetchRequest(ifetch_req);
             fault = thread->itb->translateAtomic(ifetch_req, thread->getTC(),
                                                  BaseTLB::Execute);
+            if (useBlocks && fault == NoFault)
+                decoded = enterBlock(pcState);
         }
 
         if (fault == NoFault) {
@@ -590,7 +650,7 @@ AtomicSimpleCPU::tick()
             bool icache_access = false;
             dcache_access = false; // assume no dcache access
 
-            if (needToFetch) {
+            if (needToFetch && !decoded) {
                 // This is commented out because the decoder would act like
                 // a tiny cache otherwise. It wouldn't be flushed when needed
                 // like the I cache. It should be flushed, and when that works
@@ -602,7 +662,7 @@ AtomicSimpleCPU::tick()
                     Packet ifetch_pkt = Packet(ifetch_req, MemCmd::ReadReq);
                     ifetch_pkt.dataStatic(&inst);
 
-                    icache_latency = sendPacket(icachePort, &ifetch_pkt);
+                    icache_latency = sendMemAccess(icachePort, &ifetch_pkt);
 
                     assert(!ifetch_pkt.isError());
 
@@ -611,7 +671,14 @@ AtomicSimpleCPU::tick()
                 //}
             }
 
-            preExecute();
+            if (decoded) {
+                thread->pcState(decoded->pc);
+                preExecute(decoded->inst);
+            } else {
+                preExecute();
+                if (needToFetch && blockCacheEnabled)
+                    recordBlockInst(pcState);
+            }
 
             Tick stall_ticks = 0;
             if (curStaticInst) {
@@ -636,6 +703,11 @@ AtomicSimpleCPU::tick()
                 }
 
                 postExecute();
+
+                if (blockCacheEnabled && endsBlock(curStaticInst)) {
+                    curBlock = nullptr;
+                    finishBlock();
+                }
             }
 
             // @todo remove me after debugging with legion done
@@ -673,6 +745,164 @@ AtomicSimpleCPU::tick()
         reschedule(tickEvent, curTick() + latency, true);
 }
 
+const DecodedBlockCache::Inst *
+AtomicSimpleCPU::nextBlockInst(const TheISA::PCState &pc)
+{
+    if (!curBlock)
+        return nullptr;
+
+    if (curBlockInst < curBlock->insts.size()) {
+        const DecodedBlockCache::Inst &next = curBlock->insts[curBlockInst];
+        if (next.pc.instAddr() == pc.instAddr()) {
+            curBlockInst++;
+            numBlockCacheInsts++;
+            return &next;
+        }
+    }
+
+    // the block ended, or the PC left it
+    curBlock = nullptr;
+    return nullptr;
+}
+
+const DecodedBlockCache::Inst *
+AtomicSimpleCPU::enterBlock(const TheISA::PCState &pc)
+{
+    SimpleThread *thread = threadInfo[curThread]->thread;
+
+    curBlock = nullptr;
+    uint64_t context;
+    if (ifetch_req->isUncacheable() ||
+        !thread->decoder.blockCacheContext(pc, context)) {
+        return nullptr;
+    }
+
+    // the fetch is aligned, find the physical address of the PC
+    const Addr paddr = ifetch_req->getPaddr() +
+        (pc.instAddr() - ifetch_req->getVaddr());
+    const DecodedBlockCache::Block *block =
+        blockCache.lookup(pc.instAddr(), paddr, context);
+    if (!block) {
+        numBlockCacheMisses++;
+        return nullptr;
+    }
+
+    // the instructions may have changed since they were decoded, by
+    // any writer of the memory
+    Tick latency;
+    const uint8_t *host = backdoors.lookup(paddr, latency);
+    if (!host ||
+        memcmp(host, block->bytes.data(), block->bytes.size()) != 0) {
+        if (host) {
+            DPRINTF(SimpleCPU, "Decoded block at %#x changed\n",
+                    pc.instAddr());
+            blockCache.erase(block);
+        }
+        numBlockCacheMisses++;
+        return nullptr;
+    }
+
+    numBlockCacheHits++;
+    curBlock = block;
+    curBlockInst = 0;
+    return nextBlockInst(pc);
+}
+
+void
+AtomicSimpleCPU::recordBlockInst(const TheISA::PCState &pc)
+{
+    SimpleExecContext &t_info = *threadInfo[curThread];
+    SimpleThread *thread = t_info.thread;
+
+    if (t_info.stayAtPC)
+        return;
+
+    const StaticInstPtr &inst =
+        curMacroStaticInst ? curMacroStaticInst : curStaticInst;
+    const TheISA::PCState &decoded_pc = thread->pcState();
+    const Addr vaddr = decoded_pc.instAddr();
+    const Addr size = decoded_pc.nextInstAddr() - vaddr;
+    const Addr page_mask = ~(TheISA::PageBytes - 1);
+
+    uint64_t context;
+    if (!inst || ifetch_req->isUncacheable() ||
+        !thread->decoder.blockCacheContext(pc, context) || size == 0 ||
+        (vaddr & page_mask) != ((vaddr + size - 1) & page_mask) ||
+        (vaddr & page_mask) != (ifetch_req->getVaddr() & page_mask)) {
+        finishBlock();
+        return;
+    }
+
+    Tick latency;
+    const Addr paddr = ifetch_req->getPaddr() +
+        (vaddr - ifetch_req->getVaddr());
+    const uint8_t *host = backdoors.lookup(paddr, latency);
+    if (!host) {
+        finishBlock();
+        return;
+    }
+
+    if (newBlock && (newBlock->endAddr() != vaddr ||
+                     newBlock->context != context ||
+                     newBlock->paddr + newBlock->bytes.size() != paddr)) {
+        finishBlock();
+    }
+
+    if (!newBlock) {
+        newBlock.reset(new DecodedBlockCache::Block);
+        newBlock->vaddr = vaddr;
+        newBlock->paddr = paddr;
+        newBlock->context = context;
+    }
+
+    newBlock->insts.push_back({ inst, decoded_pc });
+    newBlock->bytes.insert(newBlock->bytes.end(), host, host + size);
+
+    if (newBlock->insts.size() == DecodedBlockCache::maxBlockInsts)
+        finishBlock();
+}
+
+void
+AtomicSimpleCPU::finishBlock()
+{
+    if (!newBlock)
+        return;
+
+    // inserting may empty the cache
+    curBlock = nullptr;
+    blockCache.insert(std::move(newBlock));
+}
+
+void
+AtomicSimpleCPU::flushBlocks()
+{
+    curBlock = nullptr;
+    newBlock.reset();
+    blockCache.flush();
+}
+
+void
+AtomicSimpleCPU::regStats()
+{
+    BaseSimpleCPU::regStats();
+
+    numBlockCacheHits
+        .name(name() + ".blockCacheHits")
+        .desc("Blocks of instructions taken from the decoded block cache")
+        ;
+
+    numBlockCacheMisses
+        .name(name() + ".blockCacheMisses")
+        .desc("Fetches that found no valid block in the decoded block "
+              "cache")
+        ;
+
+    numBlockCacheInsts
+        .name(name() + ".blockCacheInsts")
+        .desc("Instructions taken from the decoded block cache")
+        ;
+}
+
 void
 AtomicSimpleCPU::regProbePoints()
 {
@@ -44,7 +44,9 @@
 #define __CPU_SIMPLE_ATOMIC_HH__
 
 #include "cpu/simple/base.hh"
+#include "cpu/simple/block_cache.hh"
 #include "cpu/simple/exec_context.hh"
+#include "mem/backdoor.hh"
 #include "mem/request.hh"
 #include "params/AtomicSimpleCPU.hh"
 #include "sim/probe/probe.hh"
@@ -105,6 +107,15 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
     virtual Tick sendPacket(MasterPort &port, const PacketPtr &pkt);
 
+    /**
+     * Perform an access, through a backdoor if the memory of its page
+     * gave one, and through sendPacket() otherwise. Only plain reads
+     * and writes use backdoors.
+     *
+     * @return Latency of the access.
+     */
+    Tick sendMemAccess(MasterPort &port, const PacketPtr &pkt);
+
     /**
      * An AtomicCPUPort overrides the default behaviour of the
      * recvAtomicSnoop and ignores the packet instead of panicking. It
@@ -133,6 +144,12 @@ class AtomicSimpleCPU : public BaseSimpleCPU
             panic("Atomic CPU doesn't expect recvRetry!\n");
         }
 
+        void recvRangeChange()
+        {
+            // the pages may now belong to other memories
+            ((AtomicSimpleCPU *)(&owner))->backdoors.flush();
+        }
+
     };
 
     class AtomicCPUDPort : public AtomicCPUPort
@@ -147,6 +164,11 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
         bool isSnooping() const { return true; }
 
+        // only the writes of others need snooping, to clear the
+        // load-locked reservations and wake up the monitors (which
+        // reads may also do, but need not)
+        bool isSnoopingReads() const { return false; }
+
         Addr cacheBlockMask;
       protected:
         BaseSimpleCPU *cpu;
@@ -167,6 +189,67 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     bool dcache_access;
     Tick dcache_latency;
 
+    /** Use memory backdoors. */
+    const bool memBackdoor;
+
+    /** Host pointers of the pages recently accessed. */
+    BackdoorCache backdoors;
+
+    /** Cache decoded blocks of instructions, see DecodedBlockCache. */
+    const bool blockCacheEnabled;
+
+    DecodedBlockCache blockCache;
+
+    /** Block the next instruction is taken from, and its index. */
+    const DecodedBlockCache::Block *curBlock;
+    unsigned curBlockInst;
+
+    /** Block being recorded from the instructions decoded. */
+    std::unique_ptr<DecodedBlockCache::Block> newBlock;
+
+    Stats::Scalar numBlockCacheHits;
+    Stats::Scalar numBlockCacheMisses;
+    Stats::Scalar numBlockCacheInsts;
+
+    /**
+     * Get the next instruction of the current block, if it is at the
+     * PC. The instructions of a block can be executed without being
+     * translated, as they are in the page of the first one.
+     */
+    const DecodedBlockCache::Inst *nextBlockInst(const TheISA::PCState &pc);
+
+    /**
+     * Look the block at the PC up once ifetch_req is translated, and
+     * check that memory still holds its instructions.
+     *
+     * @return The first instruction of the block, or nullptr.
+     */
+    const DecodedBlockCache::Inst *enterBlock(const TheISA::PCState &pc);
+
+    /**
+     * Record the instruction just decoded, fetched through ifetch_req,
+     * in the block being recorded.
+     *
+     * @param pc PC state before decoding the instruction.
+     */
+    void recordBlockInst(const TheISA::PCState &pc);
+
+    /** Add the block being recorded to the cache. */
+    void finishBlock();
+
+    /** Stop taking instructions from blocks, and forget them all. */
+    void flushBlocks();
+
+    /** Stop taking instructions from the current block after an
+     *  instruction, e.g., one that may change the translations. */
+    static bool
+    endsBlock(const StaticInstPtr &inst)
+    {
+        return inst->isControl() || inst->isSerializing() ||
+            inst->isSquashAfter() || inst->isNonSpeculative() ||
+            inst->isSyscall() || inst->isIprAccess() || inst->isQuiesce();
+    }
+
     /** Probe Points. */
     ProbePointArg<std::pair<SimpleThread*, const StaticInstPtr>> *ppCommit;
 
@@ -205,6 +288,8 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
     void regProbePoints() override;
 
+    void regStats() override;
+
     /**
      * Print state of address in memory system via PrintReq (for
      * debugging).
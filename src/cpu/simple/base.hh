@@ -130,7 +130,17 @@ class BaseSimpleCPU : public BaseCPU
 
     void checkForInterrupts();
     void setupFetchRequest(const RequestPtr &req);
-    void preExecute();
+
+    /**
+     * Get the instruction at the PC ready to execute, decoding it if
+     * needed.
+     *
+     * @param decoded The instruction at the PC if the caller already
+     * decoded it, e.g., from a cache of decoded instructions, and set
+     * the PC state as decoding it would have.
+     */
+    void preExecute(
+        const StaticInstPtr &decoded = StaticInst::nullStaticInstPtr);
     void postExecute();
     void advancePC(const Fault &fault);
 
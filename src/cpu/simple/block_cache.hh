@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_BLOCK_CACHE_HH__
+#define __CPU_SIMPLE_BLOCK_CACHE_HH__
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "arch/types.hh"
+#include "base/types.hh"
+#include "config/the_isa.hh"
+#include "cpu/static_inst.hh"
+
+/**
+ * Cache of blocks of decoded instructions, with which the
+ * AtomicSimpleCPU runs through straight-line code without translating,
+ * fetching and decoding each instruction.
+ *
+ * A block holds the macro instructions decoded at consecutive PCs of a
+ * page, and the bytes they were decoded from. It is looked up by its
+ * virtual and physical start address and the context of the decoder
+ * (see the blockCacheContext() of the decoders), and is only valid as
+ * long as memory still holds its bytes, which the user checks when
+ * entering it.
+ */
+class DecodedBlockCache
+{
+  public:
+    /** A decoded instruction. */
+    struct Inst
+    {
+        StaticInstPtr inst;
+
+        /** PC state once the instruction is decoded. */
+        TheISA::PCState pc;
+    };
+
+    struct Block
+    {
+        Addr vaddr;
+        Addr paddr;
+        uint64_t context;
+
+        std::vector<Inst> insts;
+
+        /** Bytes of the instructions, from vaddr. */
+        std::vector<uint8_t> bytes;
+
+        /** Virtual address following the last instruction. */
+        Addr endAddr() const { return vaddr + bytes.size(); }
+    };
+
+    /** Longest block, in instructions. */
+    static const unsigned maxBlockInsts = 64;
+
+  private:
+    struct Key
+    {
+        Addr vaddr;
+        Addr paddr;
+        uint64_t context;
+
+        bool
+        operator==(const Key &other) const
+        {
+            return vaddr == other.vaddr && paddr == other.paddr &&
+                context == other.context;
+        }
+    };
+
+    struct KeyHash
+    {
+        size_t
+        operator()(const Key &key) const
+        {
+            return std::hash<Addr>()(key.vaddr ^ (key.paddr << 16) ^
+                                     (key.context << 40));
+        }
+    };
+
+    std::unordered_map<Key, std::unique_ptr<Block>, KeyHash> blocks;
+
+    /** Blocks after which the cache is emptied. */
+    const size_t maxBlocks;
+
+  public:
+    DecodedBlockCache(size_t max_blocks = 16384) : maxBlocks(max_blocks) {}
+
+    /** Look a block up, nullptr if there is none. */
+    Block *
+    lookup(Addr vaddr, Addr paddr, uint64_t context)
+    {
+        auto it = blocks.find(Key{ vaddr, paddr, context });
+        return it == blocks.end() ? nullptr : it->second.get();
+    }
+
+    /**
+     * Add a block, replacing the one with the same start, if any. This
+     * may empty the cache, so the blocks looked up before must not be
+     * used afterwards.
+     */
+    void insert(std::unique_ptr<Block> block);
+
+    /** Remove a block, e.g., when its bytes changed. */
+    void erase(const Block *block);
+
+    void flush() { blocks.clear(); }
+
+    size_t size() const { return blocks.size(); }
+};
+
+#endif // __CPU_SIMPLE_BLOCK_CACHE_HH__
@@ -96,6 +96,18 @@ StaticInst::hasBranchTarget(const TheISA::PCState &pc, ThreadContext *tc,
     return false;
 }
 
+bool
+StaticInst::classifyCtrlInducer() const
+{
+    bool has_ctrl_info = (isDirectCtrl() != isIndirectCtrl()) &&
+                         (isUncondCtrl() != isCondCtrl());
+
+    if (!has_ctrl_info)
+        return true;
+
+    return !(isDirectCtrl() && isUncondCtrl());
+}
+
 StaticInstPtr
 StaticInst::fetchMicroop(MicroPC upc) const
 {
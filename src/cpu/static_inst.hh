@@ -164,6 +164,21 @@ class StaticInst : public RefCounted, public StaticInstFlags
     bool isUncondCtrl()   const { return flags[IsUncondControl]; }
     bool isCondDelaySlot() const { return flags[IsCondDelaySlot]; }
 
+    /**
+     * DOLMA: Whether this control instruction depends on runtime values
+     * (it is indirect or conditional) and so induces control speculation.
+     * Direct unconditional transfers are resolved at decode on a real
+     * front end and are not inducers. Classified once per StaticInst, so
+     * the (decode-cached) instruction carries the answer from then on.
+     */
+    bool
+    isCtrlInducer() const
+    {
+        if (_ctrlInducer < 0)
+            _ctrlInducer = classifyCtrlInducer();
+        return _ctrlInducer;
+    }
+
     bool isThreadSync()   const { return flags[IsThreadSync]; }
     bool isSerializing()  const { return flags[IsSerializing] ||
                                       flags[IsSerializeBefore] ||
@@ -240,6 +255,21 @@ class StaticInst : public RefCounted, public StaticInstFlags
     virtual std::string
     generateDisassembly(Addr pc, const SymbolTable *symtab) const = 0;
 
+    /**
+     * Cached result of classifyCtrlInducer() (lazily evaluated via
+     * isCtrlInducer()), or -1 if not classified yet.
+     */
+    mutable int8_t _ctrlInducer;
+
+    /**
+     * Internal function to classify a control instruction for
+     * isCtrlInducer(). The default relies on the IsDirectControl /
+     * IsCondControl family of flags and conservatively treats the
+     * instruction as an inducer if the decoder left them incomplete;
+     * ISAs that don't set those flags override this.
+     */
+    virtual bool classifyCtrlInducer() const;
+
     /// Constructor.
     /// It's important to initialize everything here to a sane
     /// default, since the decoder generally only overrides
@@ -249,7 +279,7 @@ class StaticInst : public RefCounted, public StaticInstFlags
         : _opClass(__opClass), _numSrcRegs(0), _numDestRegs(0),
           _numFPDestRegs(0), _numIntDestRegs(0), _numCCDestRegs(0),
           _numVecDestRegs(0), _numVecElemDestRegs(0), machInst(_machInst),
-          mnemonic(_mnemonic), cachedDisassembly(0)
+          mnemonic(_mnemonic), cachedDisassembly(0), _ctrlInducer(-1)
     { }
 
   public:
@@ -165,7 +165,7 @@ DmaPort::dmaAction(Packet::Command cmd, Addr addr, int size, Event *event,
     for (ChunkGenerator gen(addr, size, sys->cacheLineSize());
          !gen.done(); gen.next()) {
 
-        req = std::make_shared<Request>(
+        req = Request::create(
             gen.addr(), gen.size(), flag, masterId);
 
         req->taskId(ContextSwitchTaskId::DMA);
@@ -0,0 +1,47 @@
+# Copyright (c) 2026 The Regents of The University of Michigan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from MemObject import MemObject
+
+# A bridge between two main event queues, typically between a core with
+# its private caches (the slave side, in the bridge's own event queue)
+# and the shared part of the memory system (the master side). Packets
+# cross through deterministic channels that are exchanged at the
+# quantum barriers, so the delay is also the lookahead that bounds the
+# simulation quantum. The bridge does not forward snoops, so the caches
+# above it are not kept coherent with the rest of the system, and a
+# coherent shared crossbar or last-level cache behind bridged cores is
+# not supported. A bridge between two event queues can't be checkpointed.
+class QueueBridge(MemObject):
+    type = 'QueueBridge'
+    cxx_header = "mem/queue_bridge.hh"
+    slave = SlavePort('Slave port')
+    master = MasterPort('Master port')
+    master_eventq_index = Param.UInt32(0,
+        "Event queue of the master side of the bridge")
+    delay = Param.Latency('2ns', "The latency of this bridge in each "
+                          "direction")
@@ -122,9 +122,16 @@ class SnoopFilter(SimObject):
 
     system = Param.System(Parent.any, "System that the crossbar belongs to.")
 
-    # Sanity check on max capacity to track, adjust if needed.
+    # Sanity check on max capacity to track, adjust if needed. For a
+    # bounded snoop filter, this is the capacity it models.
     max_capacity = Param.MemorySize('8MB', "Maximum capacity of snoop filter")
 
+    # Associativity of a bounded snoop filter, which behaves as an
+    # inclusive directory: when a set is full, it evicts a line and the
+    # crossbar invalidates it in the caches above. With the default of
+    # 0, the snoop filter is unbounded.
+    assoc = Param.Unsigned(0, "Associativity, 0 for an unbounded filter")
+
 # We use a coherent crossbar to connect multiple masters to the L2
 # caches. Normally this crossbar would be part of the cache itself.
 class L2XBar(CoherentXBar):
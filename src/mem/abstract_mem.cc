@@ -76,6 +76,12 @@ void
 AbstractMemory::setBackingStore(uint8_t* pmem_addr)
 {
     pmemAddr = pmem_addr;
+
+    // all the memories of an interleaved range share its backing store,
+    // but each of them only tracks the locked addresses of its own
+    // interleaving, so the backdoor keeps the interleaved range (and is
+    // not cached, see BackdoorCache::insert())
+    backdoor.reset(range, pmem_addr);
 }
 
 void
@@ -219,6 +225,7 @@ AbstractMemory::trackLoadLocked(PacketPtr pkt)
     // no record for this xc: need to allocate a new one
     DPRINTF(LLSC, "Adding lock record: context %d addr %#x\n",
             req->contextId(), paddr);
+    backdoor.invalidate();
     lockedAddrList.push_front(LockedAddr(req));
 }
 
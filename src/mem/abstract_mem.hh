@@ -49,6 +49,7 @@
 #ifndef __MEM_ABSTRACT_MEMORY_HH__
 #define __MEM_ABSTRACT_MEMORY_HH__
 
+#include "mem/backdoor.hh"
 #include "mem/mem_object.hh"
 #include "params/AbstractMemory.hh"
 #include "sim/stats.hh"
@@ -121,6 +122,9 @@ class AbstractMemory : public MemObject
 
     std::list<LockedAddr> lockedAddrList;
 
+    // Backdoor to the backing store, see getBackdoor()
+    MemBackdoor backdoor;
+
     // helper function for checkLockedAddrs(): we really want to
     // inline a quick check for an empty locked addr list (hopefully
     // the common case), and do the full list search (if necessary) in
@@ -227,7 +231,26 @@ class AbstractMemory : public MemObject
     /**
      * Add a locked address to allow for checkpointing.
      */
-    void addLockedAddr(LockedAddr addr) { lockedAddrList.push_back(addr); }
+    void
+    addLockedAddr(LockedAddr addr)
+    {
+        backdoor.invalidate();
+        lockedAddrList.push_back(addr);
+    }
+
+    /**
+     * Get a backdoor to the backing store of this memory. There is none
+     * for null memories, nor while load-locked addresses are tracked,
+     * as the stores going through the backdoor would not clear them.
+     * Accesses through the backdoor are not counted in the stats.
+     *
+     * @return The backdoor, or nullptr if there is none.
+     */
+    MemBackdoorPtr
+    getBackdoor()
+    {
+        return pmemAddr && lockedAddrList.empty() ? &backdoor : nullptr;
+    }
 
     /** read the system pointer
      * Implemented for completeness with the setter
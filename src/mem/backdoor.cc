@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/backdoor.hh"
+
+#include <algorithm>
+
+#include "mem/port.hh"
+
+void
+MemBackdoor::addInvalidationCallback(const void *key, Callback callback)
+{
+    for (auto &entry : callbacks) {
+        if (entry.first == key) {
+            entry.second = std::move(callback);
+            return;
+        }
+    }
+    callbacks.emplace_back(key, std::move(callback));
+}
+
+void
+MemBackdoor::removeInvalidationCallback(const void *key)
+{
+    callbacks.erase(std::remove_if(callbacks.begin(), callbacks.end(),
+                                   [key](const std::pair<const void *,
+                                                         Callback> &entry)
+                                   { return entry.first == key; }),
+                    callbacks.end());
+}
+
+void
+MemBackdoor::invalidateUsers()
+{
+    // the callbacks may add themselves back, e.g., when their user asks
+    // for the backdoor again right away
+    auto invalidated = std::move(callbacks);
+    callbacks.clear();
+    for (auto &entry : invalidated)
+        entry.second(*this);
+}
+
+BackdoorCache::~BackdoorCache()
+{
+    for (auto backdoor : backdoors)
+        backdoor->removeInvalidationCallback(this);
+}
+
+bool
+BackdoorCache::insert(Addr addr, MemBackdoor &backdoor, Tick latency,
+                      bool writable)
+{
+    const Addr page = addr & ~(pageBytes - 1);
+    const AddrRange &range = backdoor.range();
+    if (range.interleaved() || page < range.start() ||
+        page + pageBytes - 1 > range.end()) {
+        return false;
+    }
+
+    if (std::find(backdoors.begin(), backdoors.end(), &backdoor) ==
+        backdoors.end()) {
+        backdoors.push_back(&backdoor);
+        backdoor.addInvalidationCallback(this, [this](MemBackdoor &b) {
+            backdoors.erase(std::find(backdoors.begin(), backdoors.end(),
+                                      &b));
+            flush();
+        });
+    }
+
+    Entry &e = entry(addr);
+    e.page = page;
+    e.ptr = backdoor.ptr() + (page - range.start());
+    e.latency = latency;
+    e.writable = writable;
+    e.skips = 0;
+    return true;
+}
+
+void
+BackdoorCache::fill(MasterPort &port, Addr addr, Tick latency, bool write)
+{
+    const Addr page = addr & ~(pageBytes - 1);
+    Entry &e = entry(addr);
+    if (e.page == page && e.skips > 0) {
+        e.skips--;
+        return;
+    }
+
+    MemBackdoorPtr backdoor = port.sendBackdoorReq(addr, write);
+    if (backdoor && insert(addr, *backdoor, latency, write))
+        return;
+
+    // remember the refusal (or a backdoor that can't be cached),
+    // keeping the page if it can still be read
+    if (e.page != page)
+        e = Entry();
+    e.page = page;
+    e.skips = refusalSkips;
+}
+
+void
+BackdoorCache::flush()
+{
+    for (auto &e : entries)
+        e = Entry();
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_BACKDOOR_HH__
+#define __MEM_BACKDOOR_HH__
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "base/addr_range.hh"
+#include "base/types.hh"
+
+/**
+ * @file
+ * Backdoors to the host memory backing a simulated memory, through
+ * which untimed accesses read and write the memory directly instead of
+ * sending packets down the memory system.
+ */
+
+/**
+ * Host memory backing an address range. A memory hands out a backdoor
+ * when accessing it directly is equivalent to an atomic or functional
+ * access, and invalidates it as soon as that is no longer true (e.g.,
+ * when a load-locked needs tracking). The users of a backdoor must
+ * stop using it once it is invalidated, and ask the memory for it
+ * again.
+ */
+class MemBackdoor
+{
+  public:
+    typedef std::function<void(MemBackdoor &)> Callback;
+
+  private:
+    AddrRange _range;
+    uint8_t *_ptr;
+
+    /** Invalidation callbacks, with the key they were added under. */
+    std::vector<std::pair<const void *, Callback>> callbacks;
+
+  public:
+    MemBackdoor() : _ptr(nullptr) {}
+
+    MemBackdoor(const MemBackdoor &) = delete;
+    MemBackdoor &operator=(const MemBackdoor &) = delete;
+
+    /** Address range the backdoor covers. */
+    const AddrRange &range() const { return _range; }
+
+    /** Host pointer to the start of the range. */
+    uint8_t *ptr() const { return _ptr; }
+
+    /** Point the backdoor at other memory, invalidating it first. */
+    void
+    reset(const AddrRange &range, uint8_t *ptr)
+    {
+        invalidate();
+        _range = range;
+        _ptr = ptr;
+    }
+
+    /**
+     * Call a function when the backdoor is next invalidated. There is
+     * at most one callback per key, adding another one replaces it.
+     */
+    void addInvalidationCallback(const void *key, Callback callback);
+
+    /** Forget the callback added under a key, if any. */
+    void removeInvalidationCallback(const void *key);
+
+    /** Tell the users to stop using the backdoor. */
+    void
+    invalidate()
+    {
+        if (!callbacks.empty())
+            invalidateUsers();
+    }
+
+  private:
+    void invalidateUsers();
+};
+
+typedef MemBackdoor *MemBackdoorPtr;
+
+class MasterPort;
+
+/**
+ * Host pointers of the pages recently accessed through backdoors, and
+ * the latency of the access that got each page. The cache is emptied
+ * when one of the backdoors it used is invalidated.
+ *
+ * The cache also remembers the pages for which a backdoor was refused,
+ * so that the following accesses to them do not ask again every time.
+ */
+class BackdoorCache
+{
+  public:
+    /** Size of the pages cached. Accesses must not cross pages. */
+    static const Addr pageBytes = 4096;
+
+  private:
+    static const unsigned numEntries = 64;
+
+    /**
+     * Accesses to a page after a refusal before asking again, as some
+     * refusals do not last (e.g., while a memory tracks load-locked
+     * addresses).
+     */
+    static const unsigned refusalSkips = 256;
+
+    struct Entry
+    {
+        Addr page = MaxAddr;
+        /** Host pointer of the page, nullptr if it has no backdoor. */
+        uint8_t *ptr = nullptr;
+        Tick latency = 0;
+        /** Whether the backdoor can be written through. */
+        bool writable = false;
+        /** Accesses left before asking again after a refusal. */
+        unsigned skips = 0;
+    };
+
+    Entry entries[numEntries];
+
+    /** Backdoors the cache has an invalidation callback with. */
+    std::vector<MemBackdoorPtr> backdoors;
+
+    Entry &
+    entry(Addr addr)
+    {
+        return entries[(addr / pageBytes) % numEntries];
+    }
+
+  public:
+    BackdoorCache() {}
+
+    /** Copies start empty, as callbacks are added per cache. */
+    BackdoorCache(const BackdoorCache &) : BackdoorCache() {}
+    BackdoorCache &operator=(const BackdoorCache &) = delete;
+
+    ~BackdoorCache();
+
+    /**
+     * Look an address up.
+     *
+     * @param addr Address accessed.
+     * @param latency Set to the latency of the page, on hits.
+     * @param write Whether the access writes.
+     * @return Host pointer of the address, or nullptr on misses.
+     */
+    uint8_t *
+    lookup(Addr addr, Tick &latency, bool write = false)
+    {
+        Entry &e = entry(addr);
+        if (e.page != (addr & ~(pageBytes - 1)) || !e.ptr ||
+            (write && !e.writable)) {
+            return nullptr;
+        }
+        latency = e.latency;
+        return e.ptr + (addr & (pageBytes - 1));
+    }
+
+    /**
+     * Cache the page of an address, if the backdoor covers all of it.
+     *
+     * @param addr Address accessed.
+     * @param backdoor Backdoor covering the address.
+     * @param latency Latency of accesses to the page.
+     * @param writable Whether the backdoor can be written through.
+     * @return Whether the page was cached.
+     */
+    bool insert(Addr addr, MemBackdoor &backdoor, Tick latency,
+                bool writable);
+
+    /**
+     * After a miss, ask a port for a backdoor to the page of an
+     * address and cache the page, unless the port refused to give one
+     * recently.
+     *
+     * @param port Port the access was sent to.
+     * @param addr Address accessed.
+     * @param latency Latency of the access.
+     * @param write Whether the access writes.
+     */
+    void fill(MasterPort &port, Addr addr, Tick latency, bool write);
+
+    /** Forget all the pages. */
+    void flush();
+};
+
+#endif // __MEM_BACKDOOR_HH__
@@ -50,6 +50,8 @@
 
 #include "mem/bridge.hh"
 
+#include <algorithm>
+
 #include "base/trace.hh"
 #include "debug/Bridge.hh"
 #include "params/Bridge.hh"
@@ -233,6 +235,12 @@ Bridge::BridgeMasterPort::schedTimingReq(PacketPtr pkt, Tick when)
 
     assert(transmitList.size() != reqQueueLimit);
 
+    if (pkt->isWrite()) {
+        for (auto backdoor : backdoors)
+            backdoor->invalidate();
+        backdoors.clear();
+    }
+
     transmitList.emplace_back(pkt, when);
 }
 
@@ -395,6 +403,36 @@ Bridge::BridgeMasterPort::trySatisfyFunctional(PacketPtr pkt)
     return found;
 }
 
+MemBackdoorPtr
+Bridge::BridgeMasterPort::getBackdoor(Addr addr, bool write)
+{
+    if (!transmitList.empty())
+        return nullptr;
+
+    MemBackdoorPtr backdoor = sendBackdoorReq(addr, write);
+    if (backdoor && std::find(backdoors.begin(), backdoors.end(),
+                              backdoor) == backdoors.end()) {
+        backdoors.push_back(backdoor);
+    }
+    return backdoor;
+}
+
+MemBackdoorPtr
+Bridge::BridgeSlavePort::recvBackdoorReq(Addr addr, bool write)
+{
+    MemBackdoorPtr backdoor = masterPort.getBackdoor(addr, write);
+    if (!backdoor)
+        return nullptr;
+
+    // accesses through the backdoor must not reach addresses that the
+    // bridge does not forward
+    for (const auto &range : ranges) {
+        if (backdoor->range().isSubset(range))
+            return backdoor;
+    }
+    return nullptr;
+}
+
 AddrRangeList
 Bridge::BridgeSlavePort::getAddrRanges() const
 {
@@ -52,6 +52,7 @@
 #define __MEM_BRIDGE_HH__
 
 #include <deque>
+#include <vector>
 
 #include "base/types.hh"
 #include "mem/mem_object.hh"
@@ -208,6 +209,10 @@ class Bridge : public MemObject
             pass it to the bridge. */
         void recvFunctional(PacketPtr pkt);
 
+        /** When receiving a backdoor request from the peer port, pass
+            it on if the backdoor only covers ranges of the bridge. */
+        MemBackdoorPtr recvBackdoorReq(Addr addr, bool write);
+
         /** When receiving a address range request the peer port,
             pass it to the bridge. */
         AddrRangeList getAddrRanges() const;
@@ -246,6 +251,12 @@ class Bridge : public MemObject
         /** Max queue size for request packets */
         const unsigned int reqQueueLimit;
 
+        /**
+         * Backdoors handed out through the bridge, which are invalidated
+         * when a write is queued, as they would not see it.
+         */
+        std::vector<MemBackdoorPtr> backdoors;
+
         /**
          * Handle send event, scheduled when the packet at the head of
          * the outbound queue is ready to transmit (for timing
@@ -297,6 +308,18 @@ class Bridge : public MemObject
          */
         bool trySatisfyFunctional(PacketPtr pkt);
 
+        /**
+         * Get a backdoor to the memory beyond the bridge. There is none
+         * while requests are queued, as accesses through the backdoor
+         * would not see them.
+         *
+         * @param addr Address to get a backdoor for
+         * @param write Whether the backdoor is also written through
+         *
+         * @return The backdoor, or nullptr if there is none
+         */
+        MemBackdoorPtr getBackdoor(Addr addr, bool write);
+
       protected:
 
         /** When receiving a timing request from the peer port,
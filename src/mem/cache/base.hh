@@ -1162,7 +1162,8 @@ class BaseCache : public MemObject
     /**
      * Serialize the state of the caches
      *
-     * We currently don't support checkpointing cache state, so this panics.
+     * The contents of the cache are checkpointed by its tags (see
+     * BaseTags::serialize).
      */
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
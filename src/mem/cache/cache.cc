@@ -378,10 +378,10 @@ Cache::handleTimingReqMiss(PacketPtr pkt, CacheBlk *blk, Tick forward_time,
 
         if (!mshr) {
             // copy the request and create a new SoftPFReq packet
-            RequestPtr req = std::make_shared<Request>(pkt->req->getPaddr(),
-                                                       pkt->req->getSize(),
-                                                       pkt->req->getFlags(),
-                                                       pkt->req->masterId());
+            RequestPtr req = Request::create(pkt->req->getPaddr(),
+                                             pkt->req->getSize(),
+                                             pkt->req->getFlags(),
+                                             pkt->req->masterId());
             pf = new Packet(req, pkt->cmd);
             pf->allocate();
             assert(pf->getAddr() == pkt->getAddr());
@@ -870,7 +870,7 @@ Cache::cleanEvictBlk(CacheBlk *blk)
     assert(blk && blk->isValid() && !blk->isDirty());
 
     // Creating a zero sized write, a message to the snoop filter
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbMasterId);
 
     if (blk->isSecure())
@@ -1231,10 +1231,15 @@ Cache::recvTimingSnoopReq(PacketPtr pkt)
         // the difference being that instead of querying the block
         // state to determine if it is dirty and writable, we use the
         // command and fields of the writeback packet
+        bool invalidate = pkt->isInvalidate();
+        // a cache clean and invalidate takes the dirty line with a
+        // WriteClean, as for a dirty block, rather than a response
+        // that would not carry the data of the discarded writeback
+        bool write_clean = pkt->isClean() && invalidate &&
+            wb_pkt->cmd == MemCmd::WritebackDirty;
         bool respond = wb_pkt->cmd == MemCmd::WritebackDirty &&
-            pkt->needsResponse();
+            pkt->needsResponse() && !write_clean;
         bool have_writable = !wb_pkt->hasSharers();
-        bool invalidate = pkt->isInvalidate();
 
         if (!pkt->req->isUncacheable() && pkt->isRead() && !invalidate) {
             assert(!pkt->needsWritable());
@@ -1254,10 +1259,38 @@ Cache::recvTimingSnoopReq(PacketPtr pkt)
         }
 
         if (invalidate && wb_pkt->cmd != MemCmd::WriteClean) {
+            PacketList writebacks;
+            if (write_clean) {
+                // same as writecleanBlk, with the writeback as the block
+                RequestPtr req = Request::create(
+                    wb_pkt->getAddr(), blkSize, 0, Request::wbMasterId);
+                if (is_secure) {
+                    req->setFlags(Request::SECURE);
+                }
+                req->taskId(wb_pkt->req->taskId());
+
+                PacketPtr wc_pkt = new Packet(req, MemCmd::WriteClean,
+                                              blkSize, pkt->id);
+                if (pkt->req->getDest()) {
+                    req->setFlags(pkt->req->getDest());
+                    wc_pkt->setWriteThrough();
+                }
+                if (!have_writable) {
+                    wc_pkt->setHasSharers();
+                }
+                wc_pkt->allocate();
+                wc_pkt->setData(wb_pkt->getConstPtr<uint8_t>());
+                writebacks.push_back(wc_pkt);
+                pkt->setSatisfied();
+            }
+
             // Invalidation trumps our writeback... discard here
             // Note: markInService will remove entry from writeback buffer.
             markInService(wb_entry);
             delete wb_pkt;
+
+            doWritebacks(writebacks, clockEdge(forwardLatency) +
+                         pkt->headerDelay);
         }
     }
 
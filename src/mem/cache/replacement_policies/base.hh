@@ -123,6 +123,32 @@ class BaseReplacementPolicy : public SimObject
      * @return A shared pointer to the new replacement data.
      */
     virtual std::shared_ptr<ReplacementData> instantiateEntry() = 0;
+
+    /**
+     * Number of 64-bit words needed to save the state of an entry, used
+     * to checkpoint the contents of the tables using this policy.
+     * Policies without per-entry state save nothing.
+     */
+    virtual unsigned entryStateSize() const { return 0; }
+
+    /**
+     * Save the replacement state of an entry.
+     *
+     * @param replacement_data Replacement data to be saved.
+     * @param state Array of entryStateSize() words to save it to.
+     */
+    virtual void saveEntry(const std::shared_ptr<ReplacementData>&
+                           replacement_data, uint64_t *state) const {}
+
+    /**
+     * Restore the replacement state of an entry saved by saveEntry().
+     * The entry must have been reset beforehand.
+     *
+     * @param replacement_data Replacement data to be restored.
+     * @param state Array of entryStateSize() words to restore it from.
+     */
+    virtual void loadEntry(const std::shared_ptr<ReplacementData>&
+                           replacement_data, const uint64_t *state) const {}
 };
 
 #endif // __MEM_CACHE_REPLACEMENT_POLICIES_BASE_HH__
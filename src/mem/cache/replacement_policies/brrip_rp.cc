@@ -132,6 +132,20 @@ BRRIPRP::getVictim(const ReplacementCandidates& candidates) const
     return victim;
 }
 
+void
+BRRIPRP::saveEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                   uint64_t *state) const
+{
+    state[0] = std::static_pointer_cast<BRRIPReplData>(replacement_data)->rrpv;
+}
+
+void
+BRRIPRP::loadEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                   const uint64_t *state) const
+{
+    std::static_pointer_cast<BRRIPReplData>(replacement_data)->rrpv = state[0];
+}
+
 std::shared_ptr<ReplacementData>
 BRRIPRP::instantiateEntry()
 {
@@ -84,6 +84,22 @@ FIFORP::getVictim(const ReplacementCandidates& candidates) const
     return victim;
 }
 
+void
+FIFORP::saveEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                  uint64_t *state) const
+{
+    state[0] = std::static_pointer_cast<FIFOReplData>(
+        replacement_data)->tickInserted;
+}
+
+void
+FIFORP::loadEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                  const uint64_t *state) const
+{
+    std::static_pointer_cast<FIFOReplData>(
+        replacement_data)->tickInserted = state[0];
+}
+
 std::shared_ptr<ReplacementData>
 FIFORP::instantiateEntry()
 {
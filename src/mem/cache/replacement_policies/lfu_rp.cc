@@ -83,6 +83,22 @@ LFURP::getVictim(const ReplacementCandidates& candidates) const
     return victim;
 }
 
+void
+LFURP::saveEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                 uint64_t *state) const
+{
+    state[0] = std::static_pointer_cast<LFUReplData>(
+        replacement_data)->refCount;
+}
+
+void
+LFURP::loadEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                 const uint64_t *state) const
+{
+    std::static_pointer_cast<LFUReplData>(
+        replacement_data)->refCount = state[0];
+}
+
 std::shared_ptr<ReplacementData>
 LFURP::instantiateEntry()
 {
@@ -86,6 +86,22 @@ LRURP::getVictim(const ReplacementCandidates& candidates) const
     return victim;
 }
 
+void
+LRURP::saveEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                 uint64_t *state) const
+{
+    state[0] = std::static_pointer_cast<LRUReplData>(
+        replacement_data)->lastTouchTick;
+}
+
+void
+LRURP::loadEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                 const uint64_t *state) const
+{
+    std::static_pointer_cast<LRUReplData>(
+        replacement_data)->lastTouchTick = state[0];
+}
+
 std::shared_ptr<ReplacementData>
 LRURP::instantiateEntry()
 {
@@ -86,6 +86,22 @@ MRURP::getVictim(const ReplacementCandidates& candidates) const
     return victim;
 }
 
+void
+MRURP::saveEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                 uint64_t *state) const
+{
+    state[0] = std::static_pointer_cast<MRUReplData>(
+        replacement_data)->lastTouchTick;
+}
+
+void
+MRURP::loadEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                 const uint64_t *state) const
+{
+    std::static_pointer_cast<MRUReplData>(
+        replacement_data)->lastTouchTick = state[0];
+}
+
 std::shared_ptr<ReplacementData>
 MRURP::instantiateEntry()
 {
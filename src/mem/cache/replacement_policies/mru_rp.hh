@@ -108,6 +108,15 @@ class MRURP : public BaseReplacementPolicy
     ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
                                                                      override;
 
+    /**
+     * Checkpoint the replacement state of an entry.
+     */
+    unsigned entryStateSize() const override { return 1; }
+    void saveEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                   uint64_t *state) const override;
+    void loadEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                   const uint64_t *state) const override;
+
     /**
      * Instantiate a replacement data entry.
      *
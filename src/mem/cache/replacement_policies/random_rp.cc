@@ -86,6 +86,22 @@ RandomRP::getVictim(const ReplacementCandidates& candidates) const
     return victim;
 }
 
+void
+RandomRP::saveEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                    uint64_t *state) const
+{
+    state[0] = std::static_pointer_cast<RandomReplData>(
+        replacement_data)->valid;
+}
+
+void
+RandomRP::loadEntry(const std::shared_ptr<ReplacementData>& replacement_data,
+                    const uint64_t *state) const
+{
+    std::static_pointer_cast<RandomReplData>(
+        replacement_data)->valid = state[0];
+}
+
 std::shared_ptr<ReplacementData>
 RandomRP::instantiateEntry()
 {
@@ -125,6 +125,26 @@ SecondChanceRP::getVictim(const ReplacementCandidates& candidates) const
     return victim;
 }
 
+void
+SecondChanceRP::saveEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    uint64_t *state) const
+{
+    FIFORP::saveEntry(replacement_data, state);
+    state[1] = std::static_pointer_cast<SecondChanceReplData>(
+        replacement_data)->hasSecondChance;
+}
+
+void
+SecondChanceRP::loadEntry(
+    const std::shared_ptr<ReplacementData>& replacement_data,
+    const uint64_t *state) const
+{
+    FIFORP::loadEntry(replacement_data, state);
+    std::static_pointer_cast<SecondChanceReplData>(
+        replacement_data)->hasSecondChance = state[1];
+}
+
 std::shared_ptr<ReplacementData>
 SecondChanceRP::instantiateEntry()
 {
@@ -48,9 +48,15 @@
 
 #include "mem/cache/tags/base.hh"
 
+#include <zlib.h>
+
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <vector>
 
 #include "base/types.hh"
+#include "debug/Checkpoint.hh"
 #include "mem/cache/base.hh"
 #include "mem/packet.hh"
 #include "mem/request.hh"
@@ -180,6 +186,171 @@ BaseTags::print()
     return str;
 }
 
+namespace
+{
+
+/** Per-block header of the checkpointed tag contents. */
+enum BlkRecordField
+{
+    RecIndex,
+    RecAddr,
+    RecStatus,
+    RecMasterId,
+    RecTaskId,
+    RecRefCount,
+    RecTickInserted,
+    NumRecFields
+};
+
+} // anonymous namespace
+
+void
+BaseTags::serialize(CheckpointOut &cp) const
+{
+    const unsigned repl_state_size = replStateSize();
+    const unsigned block_size = blkSize;
+    const unsigned num_blocks = numBlocks;
+    std::string filename = name() + ".blocks";
+
+    // forEachBlk is not const, but only reads the blocks here
+    BaseTags *tags = const_cast<BaseTags *>(this);
+
+    unsigned num_valid = 0;
+    tags->forEachBlk([&num_valid](CacheBlk &blk) {
+        if (blk.isValid())
+            num_valid++;
+    });
+
+    DPRINTF(Checkpoint, "Serializing %d valid blocks to %s\n", num_valid,
+            filename);
+
+    SERIALIZE_SCALAR(num_blocks);
+    SERIALIZE_SCALAR(block_size);
+    SERIALIZE_SCALAR(repl_state_size);
+    SERIALIZE_SCALAR(num_valid);
+    SERIALIZE_SCALAR(filename);
+
+    std::string filepath = CheckpointIn::dir() + "/" + filename;
+    gzFile compressed_blks = gzopen(filepath.c_str(), "wb");
+    if (compressed_blks == NULL)
+        fatal("Can't open cache checkpoint file '%s'\n", filename);
+
+    std::vector<uint64_t> record(NumRecFields + repl_state_size);
+    prepareReplState();
+    uint64_t index = 0;
+    tags->forEachBlk([&](CacheBlk &blk) {
+        if (blk.isValid()) {
+            record[RecIndex] = index;
+            record[RecAddr] = regenerateBlkAddr(&blk);
+            record[RecStatus] = blk.status;
+            record[RecMasterId] = blk.srcMasterId;
+            record[RecTaskId] = blk.task_id;
+            record[RecRefCount] = blk.refCount;
+            record[RecTickInserted] = blk.tickInserted;
+            saveReplState(&blk, &record[NumRecFields]);
+
+            const int record_bytes = record.size() * sizeof(uint64_t);
+            if (gzwrite(compressed_blks, record.data(), record_bytes) !=
+                record_bytes ||
+                gzwrite(compressed_blks, blk.data, blkSize) != (int)blkSize)
+                fatal("Write failed on cache checkpoint file '%s'\n",
+                      filename);
+        }
+        index++;
+    });
+
+    if (gzclose(compressed_blks))
+        fatal("Close failed on cache checkpoint file '%s'\n", filename);
+}
+
+void
+BaseTags::unserialize(CheckpointIn &cp)
+{
+    std::string filename;
+    if (!optParamIn(cp, "filename", filename)) {
+        warn("%s: no cache contents in checkpoint, starting cold\n",
+             name());
+        return;
+    }
+
+    unsigned num_blocks, block_size, repl_state_size, num_valid;
+    UNSERIALIZE_SCALAR(num_blocks);
+    UNSERIALIZE_SCALAR(block_size);
+    UNSERIALIZE_SCALAR(repl_state_size);
+    UNSERIALIZE_SCALAR(num_valid);
+
+    if (num_blocks != numBlocks || block_size != blkSize ||
+        repl_state_size != replStateSize()) {
+        warn("%s: cache geometry differs from the checkpoint, "
+             "starting cold\n", name());
+        return;
+    }
+
+    DPRINTF(Checkpoint, "Unserializing %d valid blocks from %s\n",
+            num_valid, filename);
+
+    std::string filepath = cp.cptDir + "/" + filename;
+    gzFile compressed_blks = gzopen(filepath.c_str(), "rb");
+    if (compressed_blks == NULL)
+        fatal("Can't open cache checkpoint file '%s'\n", filename);
+
+    const unsigned record_size = NumRecFields + repl_state_size;
+    std::vector<uint64_t> records(num_valid * record_size);
+    std::vector<uint8_t> data(num_valid * blkSize);
+    for (unsigned i = 0; i < num_valid; i++) {
+        const int record_bytes = record_size * sizeof(uint64_t);
+        if (gzread(compressed_blks, &records[i * record_size],
+                   record_bytes) != record_bytes ||
+            gzread(compressed_blks, &data[i * blkSize], blkSize) !=
+            (int)blkSize)
+            fatal("Read failed on cache checkpoint file '%s'\n", filename);
+    }
+
+    if (gzclose(compressed_blks))
+        fatal("Close failed on cache checkpoint file '%s'\n", filename);
+
+    std::vector<CacheBlk *> blks;
+    blks.reserve(numBlocks);
+    forEachBlk([&blks](CacheBlk &blk) { blks.push_back(&blk); });
+
+    std::vector<unsigned> order(num_valid);
+    for (unsigned i = 0; i < num_valid; i++)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+        [&](unsigned a, unsigned b) {
+            return restoreOrder(&records[a * record_size + NumRecFields]) <
+                restoreOrder(&records[b * record_size + NumRecFields]);
+        });
+
+    for (unsigned i : order) {
+        const uint64_t *record = &records[i * record_size];
+        panic_if(record[RecIndex] >= blks.size(),
+                 "Bad block index in cache checkpoint file '%s'\n",
+                 filename);
+        CacheBlk *blk = blks[record[RecIndex]];
+        if (blk->isValid())
+            invalidate(blk);
+
+        // Insert the block as a fill would, then overwrite its state
+        const CacheBlk::State status = record[RecStatus];
+        RequestPtr req = Request::create(
+            record[RecAddr], blkSize,
+            (status & BlkSecure) ? Request::SECURE : 0,
+            record[RecMasterId]);
+        req->taskId(record[RecTaskId]);
+        Packet pkt(req, MemCmd::ReadReq);
+        insertBlock(&pkt, blk);
+
+        blk->status = status;
+        blk->refCount = record[RecRefCount];
+        blk->tickInserted = record[RecTickInserted];
+        blk->whenReady = curTick();
+        blk->isInitialized = true;
+        std::memcpy(blk->data, &data[i * blkSize], blkSize);
+        loadReplState(blk, record + NumRecFields);
+    }
+}
+
 void
 BaseTags::regStats()
 {
@@ -319,6 +319,59 @@ class BaseTags : public ClockedObject
      */
     virtual bool anyBlk(std::function<bool(CacheBlk &)> visitor) = 0;
 
+    /**
+     * Checkpoint the contents of the tags: the state, replacement
+     * metadata and data of every valid block, dirty or not. The blocks
+     * are written to a separate compressed file in the checkpoint
+     * directory, like the contents of physical memory.
+     */
+    void serialize(CheckpointOut &cp) const override;
+
+    /**
+     * Refill the tags from a checkpoint. A checkpoint taken with a
+     * different geometry (or without cache contents) is ignored and the
+     * tags start cold.
+     */
+    void unserialize(CheckpointIn &cp) override;
+
+  protected:
+    /**
+     * Number of 64-bit words of replacement state checkpointed for each
+     * block.
+     */
+    virtual unsigned replStateSize() const { return 0; }
+
+    /**
+     * Get ready to save the replacement state of the blocks, for tags
+     * that derive it for all of the blocks at once. Called before
+     * saveReplState() is called for each valid block.
+     */
+    virtual void prepareReplState() const {}
+
+    /**
+     * Save the replacement state of a valid block.
+     *
+     * @param blk The block.
+     * @param state Array of replStateSize() words to save it to.
+     */
+    virtual void saveReplState(CacheBlk *blk, uint64_t *state) const {}
+
+    /**
+     * Restore the replacement state of a block, after it was inserted.
+     *
+     * @param blk The block.
+     * @param state Array of replStateSize() words to restore it from.
+     */
+    virtual void loadReplState(CacheBlk *blk, const uint64_t *state) {}
+
+    /**
+     * Key by which the blocks are re-inserted when restoring, lowest
+     * first, for tags whose replacement state is the insertion order.
+     *
+     * @param state Saved replacement state of a block.
+     */
+    virtual uint64_t restoreOrder(const uint64_t *state) const { return 0; }
+
   private:
     /**
      * Update the reference stats using data from the input block
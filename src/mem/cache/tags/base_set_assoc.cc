@@ -76,9 +76,7 @@ BaseSetAssoc::BaseSetAssoc(const Params *p)
 
     unsigned blkIndex = 0;       // index into blks array
     for (unsigned i = 0; i < numSets; ++i) {
-        sets[i].assoc = assoc;
-
-        sets[i].blks.resize(assoc);
+        sets[i].init(assoc);
 
         // link in the data blocks
         for (unsigned j = 0; j < assoc; ++j) {
@@ -113,6 +111,9 @@ BaseSetAssoc::invalidate(CacheBlk *blk)
 {
     BaseTags::invalidate(blk);
 
+    // The block can no longer match a lookup
+    sets[blk->set].clearKey(blk);
+
     // Decrease the number of tags in use
     tagsInUse--;
 
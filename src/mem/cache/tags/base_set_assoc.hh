@@ -255,6 +255,9 @@ class BaseSetAssoc : public BaseTags
         // Insert block
         BaseTags::insertBlock(pkt, blk);
 
+        // Make the new tag visible to lookups
+        sets[blk->set].setKey(blk, blk->isSecure());
+
         // Increment tag counter
         tagsInUse++;
 
@@ -317,6 +320,22 @@ class BaseSetAssoc : public BaseTags
         return false;
     }
 
+  protected:
+    unsigned replStateSize() const override
+    {
+        return replacementPolicy->entryStateSize();
+    }
+
+    void saveReplState(CacheBlk *blk, uint64_t *state) const override
+    {
+        replacementPolicy->saveEntry(blk->replacementData, state);
+    }
+
+    void loadReplState(CacheBlk *blk, const uint64_t *state) override
+    {
+        replacementPolicy->loadEntry(blk->replacementData, state);
+    }
+
   private:
     /**
      * Calculate the set index from the address.
@@ -48,9 +48,11 @@
 #ifndef __MEM_CACHE_TAGS_CACHESET_HH__
 #define __MEM_CACHE_TAGS_CACHESET_HH__
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
 
+#include "base/tag_match.hh"
 #include "base/types.hh"
 
 /**
@@ -66,6 +68,44 @@ class CacheSet
     /** Cache blocks in this set, maintained in LRU order 0 = MRU. */
     std::vector<Blktype*> blks;
 
+    /**
+     * Lookup keys of the blocks, in the same order: the tag and secure
+     * bit each block was inserted with, or invalidKey. They are kept in
+     * one array so that a lookup compares all the ways at once instead
+     * of visiting each block. A key may be stale (e.g., if the block was
+     * invalidated behind the set's back), so a matching block is only a
+     * candidate until its own state is checked.
+     */
+    std::vector<uint64_t> keys;
+
+    /** Key that no block tag matches. */
+    static const uint64_t invalidKey = ~uint64_t(0);
+
+    /**
+     * The lookup key of a tag. Tags never use the top bit of an
+     * address, so the secure bit fits below them.
+     */
+    static uint64_t key(Addr tag, bool is_secure)
+    { return (uint64_t(tag) << 1) | is_secure; }
+
+    /**
+     * Set the number of ways of the set, leaving it empty.
+     */
+    void init(int _assoc);
+
+    /**
+     * Update the lookup key of a block whose tag was just set.
+     * @param blk The block.
+     * @param is_secure True if the block is in secure space.
+     */
+    void setKey(Blktype *blk, bool is_secure);
+
+    /**
+     * Clear the lookup key of a block that was invalidated.
+     * @param blk The block.
+     */
+    void clearKey(Blktype *blk);
+
     /**
      * Find a block matching the tag in this set.
      * @param way_id The id of the way that matches the tag.
@@ -90,6 +130,36 @@ class CacheSet
 
 };
 
+template <class Blktype>
+const uint64_t CacheSet<Blktype>::invalidKey;
+
+template <class Blktype>
+void
+CacheSet<Blktype>::init(int _assoc)
+{
+    assoc = _assoc;
+    blks.resize(assoc);
+    keys.assign(assoc, invalidKey);
+}
+
+template <class Blktype>
+void
+CacheSet<Blktype>::setKey(Blktype *blk, bool is_secure)
+{
+    auto pos = std::find(blks.begin(), blks.end(), blk);
+    assert(pos != blks.end());
+    keys[pos - blks.begin()] = key(blk->tag, is_secure);
+}
+
+template <class Blktype>
+void
+CacheSet<Blktype>::clearKey(Blktype *blk)
+{
+    auto pos = std::find(blks.begin(), blks.end(), blk);
+    assert(pos != blks.end());
+    keys[pos - blks.begin()] = invalidKey;
+}
+
 template <class Blktype>
 Blktype*
 CacheSet<Blktype>::findBlk(Addr tag, bool is_secure, int& way_id) const
@@ -98,14 +168,16 @@ CacheSet<Blktype>::findBlk(Addr tag, bool is_secure, int& way_id) const
      * Way_id returns the id of the way that matches the block
      * If no block is found way_id is set to assoc.
      */
-    way_id = assoc;
-    for (int i = 0; i < assoc; ++i) {
+    const uint64_t k = key(tag, is_secure);
+    for (int i = findTag(keys.data(), assoc, k); i < assoc;
+         i = findTag(keys.data(), assoc, k, i + 1)) {
         if (blks[i]->tag == tag && blks[i]->isValid() &&
             blks[i]->isSecure() == is_secure) {
             way_id = i;
             return blks[i];
         }
     }
+    way_id = assoc;
     return nullptr;
 }
 
@@ -132,9 +204,13 @@ CacheSet<Blktype>::moveToHead(Blktype *blk)
     int i = 0;
     Blktype *next = blk;
 
+    uint64_t next_key = keys[std::find(blks.begin(), blks.end(), blk) -
+                             blks.begin()];
+
     do {
         assert(i < assoc);
         std::swap(blks[i], next);
+        std::swap(keys[i], next_key);
         ++i;
     } while (next != blk);
 }
@@ -154,9 +230,13 @@ CacheSet<Blktype>::moveToTail(Blktype *blk)
     int i = assoc - 1;
     Blktype *next = blk;
 
+    uint64_t next_key = keys[std::find(blks.begin(), blks.end(), blk) -
+                             blks.begin()];
+
     do {
         assert(i >= 0);
         std::swap(blks[i], next);
+        std::swap(keys[i], next_key);
         --i;
     } while (next != blk);
 }
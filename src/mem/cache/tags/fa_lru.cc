@@ -224,6 +224,25 @@ FALRU::insertBlock(const PacketPtr pkt, CacheBlk *blk)
     tagHash[std::make_pair(blk->tag, blk->isSecure())] = falruBlk;
 }
 
+void
+FALRU::prepareReplState() const
+{
+    // the list holds every block, so the one at position i from the
+    // head is numBlocks - 1 - i from the tail
+    replRanks.resize(numBlocks);
+    uint64_t rank = numBlocks;
+    for (const FALRUBlk *b = head; b != nullptr; b = b->next) {
+        replRanks[b - blks] = --rank;
+    }
+    assert(rank == 0);
+}
+
+void
+FALRU::saveReplState(CacheBlk *blk, uint64_t *state) const
+{
+    state[0] = replRanks[static_cast<FALRUBlk*>(blk) - blks];
+}
+
 void
 FALRU::moveToHead(FALRUBlk *blk)
 {
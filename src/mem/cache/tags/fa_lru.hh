@@ -53,6 +53,7 @@
 #include <functional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
@@ -110,6 +111,9 @@ class FALRU : public BaseTags
     /** The LRU block. */
     FALRUBlk *tail;
 
+    /** Position of each block from the tail, see prepareReplState(). */
+    mutable std::vector<uint64_t> replRanks;
+
     /** Hash table type mapping addresses to cache block pointers. */
     struct PairHash
     {
@@ -253,6 +257,20 @@ class FALRU : public BaseTags
         return false;
     }
 
+  protected:
+    /**
+     * The replacement state of a block is its position in the LRU list,
+     * counted from the tail. Restoring inserts the blocks from the LRU
+     * one up, which rebuilds the list.
+     */
+    unsigned replStateSize() const override { return 1; }
+    void prepareReplState() const override;
+    void saveReplState(CacheBlk *blk, uint64_t *state) const override;
+    uint64_t restoreOrder(const uint64_t *state) const override
+    {
+        return state[0];
+    }
+
   private:
     /**
      * Mechanism that allows us to simultaneously collect miss
@@ -220,6 +220,28 @@ SectorTags::insertBlock(const PacketPtr pkt, CacheBlk *blk)
     }
 }
 
+unsigned
+SectorTags::replStateSize() const
+{
+    return replacementPolicy->entryStateSize();
+}
+
+void
+SectorTags::saveReplState(CacheBlk *blk, uint64_t *state) const
+{
+    const SectorBlk* sector_blk =
+        static_cast<SectorSubBlk*>(blk)->getSectorBlock();
+    replacementPolicy->saveEntry(sector_blk->replacementData, state);
+}
+
+void
+SectorTags::loadReplState(CacheBlk *blk, const uint64_t *state)
+{
+    const SectorBlk* sector_blk =
+        static_cast<SectorSubBlk*>(blk)->getSectorBlock();
+    replacementPolicy->loadEntry(sector_blk->replacementData, state);
+}
+
 CacheBlk*
 SectorTags::findBlock(Addr addr, bool is_secure) const
 {
@@ -237,6 +237,15 @@ class SectorTags : public BaseTags
      * @param visitor Visitor to call on each block.
      */
     bool anyBlk(std::function<bool(CacheBlk &)> visitor) override;
+
+  protected:
+    /**
+     * The replacement state is kept per sector, so it is saved along
+     * with each of the sector's valid sub-blocks.
+     */
+    unsigned replStateSize() const override;
+    void saveReplState(CacheBlk *blk, uint64_t *state) const override;
+    void loadReplState(CacheBlk *blk, const uint64_t *state) override;
 };
 
 #endif //__MEM_CACHE_TAGS_SECTOR_TAGS_HH__
@@ -219,6 +219,7 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID slave_port_id)
             // the xbar has to be charged also with to lookup latency
             // of the snoop filter
             pkt->headerDelay += sf_res.second * clockPeriod();
+            backInvalidate(true);
             DPRINTF(CoherentXBar, "%s: src %s packet %s SF size: %i lat: %i\n",
                     __func__, src_port->name(), pkt->print(),
                     sf_res.first.size(), sf_res.second);
@@ -757,6 +758,7 @@ CoherentXBar::recvAtomic(PacketPtr pkt, PortID slave_port_id)
             // avoid situations where atomic upward snoops sneak in
             // between and change the filter state
             snoopFilter->finishRequest(false, pkt->getAddr(), pkt->isSecure());
+            backInvalidate(false);
 
             if (pkt->isEviction()) {
                 // for block-evicting packets, i.e. writebacks and
@@ -980,6 +982,38 @@ CoherentXBar::forwardAtomic(PacketPtr pkt, PortID exclude_slave_port_id,
     return std::make_pair(snoop_response_cmd, snoop_response_latency);
 }
 
+void
+CoherentXBar::backInvalidate(bool is_timing)
+{
+    Addr addr;
+    bool is_secure;
+    std::vector<QueuedSlavePort*> holders;
+    if (!snoopFilter->takeEviction(addr, is_secure, holders))
+        return;
+
+    RequestPtr req = Request::create(addr, system->cacheLineSize(),
+                                     Request::CLEAN | Request::INVALIDATE,
+                                     Request::wbMasterId);
+    if (is_secure) {
+        req->setFlags(Request::SECURE);
+    }
+    Packet pkt(req, MemCmd::CleanInvalidReq);
+
+    DPRINTF(CoherentXBar, "%s: %s to %d holders\n", __func__,
+            pkt.print(), holders.size());
+
+    // the caches deal with the snoop before returning, and the request
+    // has no destination, so any WriteClean stops at the next level
+    if (is_timing) {
+        forwardTiming(&pkt, InvalidPortID, holders);
+    } else {
+        forwardAtomic(&pkt, InvalidPortID, InvalidPortID, holders);
+    }
+
+    // caches write back rather than respond to cache cleans
+    assert(!pkt.cacheResponding());
+}
+
 void
 CoherentXBar::recvFunctional(PacketPtr pkt, PortID slave_port_id)
 {
@@ -1015,6 +1049,25 @@ CoherentXBar::recvFunctional(PacketPtr pkt, PortID slave_port_id)
     }
 }
 
+MemBackdoorPtr
+CoherentXBar::recvBackdoorReq(Addr addr, bool write, PortID slave_port_id)
+{
+    const MemObject &requester =
+        slavePorts[slave_port_id]->getMasterPort().getOwner();
+    for (const auto& p : snoopPorts) {
+        if (&p->getMasterPort().getOwner() != &requester &&
+            (write || p->isSnoopingReads())) {
+            DPRINTF(CoherentXBar, "recvBackdoorReq: refused to %s as %s "
+                    "snoops\n", slavePorts[slave_port_id]->name(),
+                    p->getMasterPort().name());
+            return nullptr;
+        }
+    }
+
+    return masterPorts[findPort(RangeSize(addr, 1))]->sendBackdoorReq(addr,
+                                                                      write);
+}
+
 void
 CoherentXBar::recvFunctionalSnoop(PacketPtr pkt, PortID master_port_id)
 {
@@ -52,7 +52,6 @@
 #define __MEM_COHERENT_XBAR_HH__
 
 #include <unordered_map>
-#include <unordered_set>
 
 #include "mem/snoop_filter.hh"
 #include "mem/xbar.hh"
@@ -132,6 +131,12 @@ class CoherentXBar : public BaseXBar
         virtual void recvFunctional(PacketPtr pkt)
         { xbar.recvFunctional(pkt, id); }
 
+        /**
+         * When receiving a backdoor request, pass it to the crossbar.
+         */
+        virtual MemBackdoorPtr recvBackdoorReq(Addr addr, bool write)
+        { return xbar.recvBackdoorReq(addr, write, id); }
+
         /**
          * Return the union of all adress ranges seen by this crossbar.
          */
@@ -259,9 +264,10 @@ class CoherentXBar : public BaseXBar
     /**
      * Store the outstanding requests that we are expecting snoop
      * responses from so we can determine which snoop responses we
-     * generated and which ones were merely forwarded.
+     * generated and which ones were merely forwarded. Only the keys
+     * of the map are used.
      */
-    std::unordered_set<RequestPtr> outstandingSnoop;
+    RequestMap<bool> outstandingSnoop;
 
     /**
      * Store the outstanding cache maintenance that we are expecting
@@ -382,10 +388,29 @@ class CoherentXBar : public BaseXBar
                                           const std::vector<QueuedSlavePort*>&
                                           dests);
 
+    /**
+     * Invalidate the line a bounded snoop filter evicted on the last
+     * request lookup, if any, in the caches that may hold it. This is
+     * done with a cache clean and invalidate snoop, so that a cache
+     * with a dirty copy writes it back rather than responding.
+     *
+     * @param is_timing Whether to snoop in timing or atomic mode
+     */
+    void backInvalidate(bool is_timing);
+
     /** Function called by the port when the crossbar is recieving a Functional
         transaction.*/
     void recvFunctional(PacketPtr pkt, PortID slave_port_id);
 
+    /** Function called by the port when the crossbar is recieving a
+        backdoor request. The accesses through the backdoor are not
+        snooped, so it is only passed on if all the snooping masters
+        belong to the requester, e.g., a CPU without caches. A backdoor
+        for reads only is also passed on if the other snoopers do not
+        need to see reads, e.g., other CPUs without caches. */
+    MemBackdoorPtr recvBackdoorReq(Addr addr, bool write,
+                                   PortID slave_port_id);
+
     /** Function called by the port when the crossbar is recieving a functional
         snoop transaction.*/
     void recvFunctionalSnoop(PacketPtr pkt, PortID master_port_id);
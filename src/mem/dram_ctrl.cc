@@ -440,25 +440,22 @@ DRAMCtrl::addToReadQueue(PacketPtr pkt, unsigned int pktCount)
         Addr burst_addr = burstAlign(addr);
         // if the burst address is not present then there is no need
         // looking any further
-        if (isInWriteQueue.find(burst_addr) != isInWriteQueue.end()) {
-            for (const auto& vec : writeQueue) {
-                for (const auto& p : vec) {
-                    // check if the read is subsumed in the write queue
-                    // packet we are looking at
-                    if (p->addr <= addr &&
-                       ((addr + size) <= (p->addr + p->size))) {
-
-                        foundInWrQ = true;
-                        servicedByWrQ++;
-                        pktsServicedByWrQ++;
-                        DPRINTF(DRAM,
-                                "Read to addr %lld with size %d serviced by "
-                                "write queue\n",
-                                addr, size);
-                        bytesReadWrQ += burstSize;
-                        break;
-                    }
-                }
+        auto wr = isInWriteQueue.find(burst_addr);
+        if (wr != isInWriteQueue.end()) {
+            const DRAMPacket* p = wr->second;
+            // check if the read is subsumed in the write queue
+            // packet to the same burst
+            if (p->addr <= addr &&
+               ((addr + size) <= (p->addr + p->size))) {
+
+                foundInWrQ = true;
+                servicedByWrQ++;
+                pktsServicedByWrQ++;
+                DPRINTF(DRAM,
+                        "Read to addr %lld with size %d serviced by "
+                        "write queue\n",
+                        addr, size);
+                bytesReadWrQ += burstSize;
             }
         }
 
@@ -548,7 +545,7 @@ DRAMCtrl::addToWriteQueue(PacketPtr pkt, unsigned int pktCount)
             DPRINTF(DRAM, "Adding to write queue\n");
 
             writeQueue[dram_pkt->qosValue()].push_back(dram_pkt);
-            isInWriteQueue.insert(burstAlign(addr));
+            isInWriteQueue[burstAlign(addr)] = dram_pkt;
 
             // log packet
             logRequest(MemCtrl::WRITE, pkt->masterId(), pkt->qosValue(),
@@ -769,6 +766,37 @@ DRAMCtrl::processRespondEvent()
     }
 }
 
+void
+DRAMCtrl::DRAMPacketQueue::push_back(DRAMPacket* dram_pkt)
+{
+    packets.push_back(dram_pkt);
+
+    if (dram_pkt->bankId >= banks.size())
+        banks.resize(dram_pkt->bankId + 1);
+    banks[dram_pkt->bankId][dram_pkt->row].push_back(
+        Entry{nextSeq++, std::prev(packets.end())});
+}
+
+DRAMCtrl::DRAMPacketQueue::iterator
+DRAMCtrl::DRAMPacketQueue::erase(iterator it)
+{
+    BankQueue& bank = banks[(*it)->bankId];
+    auto row = bank.find((*it)->row);
+    assert(row != bank.end());
+
+    // the scheduler almost always takes the oldest packet to a row
+    auto entry = row->second.begin();
+    while (entry->pkt != it) {
+        ++entry;
+        assert(entry != row->second.end());
+    }
+    row->second.erase(entry);
+    if (row->second.empty())
+        bank.erase(row);
+
+    return packets.erase(it);
+}
+
 DRAMCtrl::DRAMPacketQueue::iterator
 DRAMCtrl::chooseNext(DRAMPacketQueue& queue, Tick extra_col_delay)
 {
@@ -807,111 +835,107 @@ DRAMCtrl::chooseNext(DRAMPacketQueue& queue, Tick extra_col_delay)
 DRAMCtrl::DRAMPacketQueue::iterator
 DRAMCtrl::chooseNextFRFCFS(DRAMPacketQueue& queue, Tick extra_col_delay)
 {
-    // Only determine this if needed
-    vector<uint32_t> earliest_banks(ranksPerChannel, 0);
-
-    // Has minBankPrep been called to populate earliest_banks?
-    bool filled_earliest_banks = false;
-    // can the PRE/ACT sequence be done without impacting utlization?
-    bool hidden_bank_prep = false;
+    // Rather than going through the whole queue in arrival order, only
+    // look at the oldest packet to each row of the banks, which is all
+    // a search in arrival order can pick. The packet selected is:
+    // 1) the oldest row hit that can issue seamlessly, without
+    // additional delay, such as same rank accesses and/or different
+    // bank-group accesses, else
+    // 2) the oldest row hit, prepped and ready, or the oldest packet to
+    // a closed row of one of the banks that can be prepped first, the
+    // latter being preferred when the bank commands can be issued
+    // 'behind the scenes', without incurring additional delay
+    const DRAMPacketQueue::Entry* seamless_pkt = nullptr;
+    const DRAMPacketQueue::Entry* prepped_pkt = nullptr;
+    const DRAMPacketQueue::Entry* earliest_pkt = nullptr;
+
+    // are there packets to closed rows of available ranks?
+    bool got_row_miss = false;
 
-    // search for seamless row hits first, if no seamless row hit is
-    // found then determine if there are other packets that can be issued
-    // without incurring additional bus delay due to bank timing
-    // Will select closed rows first to enable more open row possibilies
-    // in future selections
-    bool found_hidden_bank = false;
+    // time we need to issue a column command to be seamless
+    const Tick min_col_at = std::max(nextBurstAt + extra_col_delay, curTick());
 
-    // remember if we found a row hit, not seamless, but bank prepped
-    // and ready
-    bool found_prepped_pkt = false;
+    for (uint16_t bank_id = 0; bank_id < queue.numBanks(); ++bank_id) {
+        const DRAMPacketQueue::BankQueue& rows = queue.bank(bank_id);
+        if (rows.empty())
+            continue;
 
-    // if we have no row hit, prepped or not, and no seamless packet,
-    // just go for the earliest possible
-    bool found_earliest_pkt = false;
+        const Rank& rank = *ranks[bank_id / banksPerRank];
+        const Bank& bank = rank.banks[bank_id % banksPerRank];
 
-    auto selected_pkt_it = queue.end();
+        // check if rank is not doing a refresh and thus is available, if
+        // not, jump to the next bank
+        if (!rank.inRefIdleState()) {
+            DPRINTF(DRAM, "%s bank %d - Rank %d not available\n", __func__,
+                    bank.bank, rank.rank);
+            continue;
+        }
 
-    // time we need to issue a column command to be seamless
-    const Tick min_col_at = std::max(nextBurstAt + extra_col_delay, curTick());
+        auto hit = rows.find(bank.openRow);
+        if (hit != rows.end()) {
+            const DRAMPacketQueue::Entry& entry = hit->second.front();
+            const Tick col_allowed_at = (*entry.pkt)->isRead() ?
+                bank.rdAllowedAt : bank.wrAllowedAt;
 
-    for (auto i = queue.begin(); i != queue.end() ; ++i) {
-        DRAMPacket* dram_pkt = *i;
-        const Bank& bank = dram_pkt->bankRef;
-        const Tick col_allowed_at = dram_pkt->isRead() ? bank.rdAllowedAt :
-                                                         bank.wrAllowedAt;
+            if (col_allowed_at <= min_col_at &&
+                (!seamless_pkt || entry.seq < seamless_pkt->seq)) {
+                seamless_pkt = &entry;
+            }
+            if (!prepped_pkt || entry.seq < prepped_pkt->seq)
+                prepped_pkt = &entry;
+        }
 
-        DPRINTF(DRAM, "%s checking packet in bank %d\n",
-                __func__, dram_pkt->bankRef.bank);
+        if (rows.size() > (hit != rows.end() ? 1 : 0))
+            got_row_miss = true;
+    }
 
-        // check if rank is not doing a refresh and thus is available, if not,
-        // jump to the next packet
-        if (dram_pkt->rankRef.inRefIdleState()) {
+    if (seamless_pkt) {
+        DPRINTF(DRAM, "%s Seamless row buffer hit\n", __func__);
+        return seamless_pkt->pkt;
+    }
 
-            DPRINTF(DRAM,
-                    "%s bank %d - Rank %d available\n", __func__,
-                    dram_pkt->bankRef.bank, dram_pkt->rankRef.rank);
-
-            // check if it is a row hit
-            if (bank.openRow == dram_pkt->row) {
-                // no additional rank-to-rank or same bank-group
-                // delays, or we switched read/write and might as well
-                // go for the row hit
-                if (col_allowed_at <= min_col_at) {
-                    // FCFS within the hits, giving priority to
-                    // commands that can issue seamlessly, without
-                    // additional delay, such as same rank accesses
-                    // and/or different bank-group accesses
-                    DPRINTF(DRAM, "%s Seamless row buffer hit\n", __func__);
-                    selected_pkt_it = i;
-                    // no need to look through the remaining queue entries
-                    break;
-                } else if (!found_hidden_bank && !found_prepped_pkt) {
-                    // if we did not find a packet to a closed row that can
-                    // issue the bank commands without incurring delay, and
-                    // did not yet find a packet to a prepped row, remember
-                    // the current one
-                    selected_pkt_it = i;
-                    found_prepped_pkt = true;
-                    DPRINTF(DRAM, "%s Prepped row buffer hit\n", __func__);
-                }
-            } else if (!found_earliest_pkt) {
-                // if we have not initialised the bank status, do it
-                // now, and only once per scheduling decisions
-                if (!filled_earliest_banks) {
-                    // determine entries with earliest bank delay
-                    std::tie(earliest_banks, hidden_bank_prep) =
-                        minBankPrep(queue, min_col_at);
-                    filled_earliest_banks = true;
-                }
+    // can the PRE/ACT sequence be done without impacting utlization?
+    bool hidden_bank_prep = false;
 
-                // bank is amongst first available banks
-                // minBankPrep will give priority to packets that can
-                // issue seamlessly
-                if (bits(earliest_banks[dram_pkt->rank],
-                         dram_pkt->bank, dram_pkt->bank)) {
-                    found_earliest_pkt = true;
-                    found_hidden_bank = hidden_bank_prep;
-
-                    // give priority to packets that can issue
-                    // bank commands 'behind the scenes'
-                    // any additional delay if any will be due to
-                    // col-to-col command requirements
-                    if (hidden_bank_prep || !found_prepped_pkt)
-                        selected_pkt_it = i;
+    if (got_row_miss) {
+        // determine entries with earliest bank delay
+        vector<uint32_t> earliest_banks;
+        std::tie(earliest_banks, hidden_bank_prep) =
+            minBankPrep(queue, min_col_at);
+
+        for (uint16_t bank_id = 0; bank_id < queue.numBanks(); ++bank_id) {
+            const DRAMPacketQueue::BankQueue& rows = queue.bank(bank_id);
+            const int r = bank_id / banksPerRank;
+            const int b = bank_id % banksPerRank;
+
+            // bank is amongst first available banks, which are all in
+            // available ranks
+            if (rows.empty() || !bits(earliest_banks[r], b, b))
+                continue;
+
+            const Bank& bank = ranks[r]->banks[b];
+            for (const auto& row : rows) {
+                const DRAMPacketQueue::Entry& entry = row.second.front();
+                if (row.first != bank.openRow &&
+                    (!earliest_pkt || entry.seq < earliest_pkt->seq)) {
+                    earliest_pkt = &entry;
                 }
             }
-        } else {
-            DPRINTF(DRAM, "%s bank %d - Rank %d not available\n", __func__,
-                    dram_pkt->bankRef.bank, dram_pkt->rankRef.rank);
         }
     }
 
-    if (selected_pkt_it == queue.end()) {
+    const DRAMPacketQueue::Entry* selected_pkt = hidden_bank_prep ?
+        (earliest_pkt ? earliest_pkt : prepped_pkt) :
+        (prepped_pkt ? prepped_pkt : earliest_pkt);
+
+    if (!selected_pkt) {
         DPRINTF(DRAM, "%s no available ranks found\n", __func__);
+        return queue.end();
     }
 
-    return selected_pkt_it;
+    DPRINTF(DRAM, "%s %s row buffer hit\n", __func__,
+            selected_pkt == prepped_pkt ? "Prepped" : "No");
+    return selected_pkt->pkt;
 }
 
 void
@@ -1658,9 +1682,10 @@ DRAMCtrl::minBankPrep(const DRAMPacketQueue& queue,
     // determine if we have queued transactions targetting the
     // bank in question
     vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
-    for (const auto& p : queue) {
-        if (p->rankRef.inRefIdleState())
-            got_waiting[p->bankId] = true;
+    for (uint16_t bank_id = 0; bank_id < queue.numBanks(); ++bank_id) {
+        if (!queue.bank(bank_id).empty() &&
+            ranks[bank_id / banksPerRank]->inRefIdleState())
+            got_waiting[bank_id] = true;
     }
 
     // Find command with optimal bank timing
@@ -2939,6 +2964,15 @@ DRAMCtrl::MemoryPort::getAddrRanges() const
     return ranges;
 }
 
+MemBackdoorPtr
+DRAMCtrl::MemoryPort::recvBackdoorReq(Addr addr, bool write)
+{
+    // writes update the backing store when they are queued, and the
+    // queued reads are only serviced from it later, so it is always
+    // up to date
+    return memory.getBackdoor();
+}
+
 void
 DRAMCtrl::MemoryPort::recvFunctional(PacketPtr pkt)
 {
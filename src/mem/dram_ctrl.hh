@@ -55,8 +55,11 @@
 #define __MEM_DRAM_CTRL_HH__
 
 #include <deque>
+#include <iterator>
+#include <list>
+#include <map>
 #include <string>
-#include <unordered_set>
+#include <unordered_map>
 #include <vector>
 
 #include "base/callback.hh"
@@ -118,6 +121,8 @@ class DRAMCtrl : public QoS::MemCtrl
 
         void recvFunctional(PacketPtr pkt);
 
+        MemBackdoorPtr recvBackdoorReq(Addr addr, bool write);
+
         bool recvTimingReq(PacketPtr);
 
         virtual AddrRangeList getAddrRanges() const;
@@ -743,9 +748,58 @@ class DRAMCtrl : public QoS::MemCtrl
 
     };
 
-    // The DRAM packets are store in a multiple dequeue structure,
-    // based on their QoS priority
-    typedef std::deque<DRAMPacket*> DRAMPacketQueue;
+    /**
+     * A queue of DRAM packets in arrival order. The queue also keeps
+     * its packets by bank and by row, so that the FR-FCFS scheduler
+     * only needs to look at the oldest packet to each row of each bank
+     * rather than at every packet. Entries are numbered in arrival
+     * order to compare packets to different banks.
+     */
+    class DRAMPacketQueue
+    {
+      public:
+        typedef std::list<DRAMPacket*>::iterator iterator;
+        typedef std::list<DRAMPacket*>::const_iterator const_iterator;
+
+        /** A queued packet and its position in arrival order. */
+        struct Entry
+        {
+            uint64_t seq;
+            iterator pkt;
+        };
+
+        /** The packets to a bank, per row, oldest first. */
+        typedef std::map<uint32_t, std::deque<Entry>> BankQueue;
+
+      private:
+        std::list<DRAMPacket*> packets;
+
+        /** Packets per bank, indexed by DRAMPacket::bankId. */
+        std::vector<BankQueue> banks;
+
+        uint64_t nextSeq;
+
+      public:
+        DRAMPacketQueue() : nextSeq(0) { }
+
+        iterator begin() { return packets.begin(); }
+        iterator end() { return packets.end(); }
+        const_iterator begin() const { return packets.begin(); }
+        const_iterator end() const { return packets.end(); }
+
+        size_t size() const { return packets.size(); }
+        bool empty() const { return packets.empty(); }
+
+        void push_back(DRAMPacket* dram_pkt);
+        iterator erase(iterator it);
+
+        /** Number of banks that may have packets. */
+        size_t numBanks() const { return banks.size(); }
+
+        /** The packets to a bank, valid for bank_id < numBanks(). */
+        const BankQueue& bank(uint16_t bank_id) const
+        { return banks[bank_id]; }
+    };
 
     /**
      * Bunch of things requires to setup "events" in gem5
@@ -929,12 +983,13 @@ class DRAMCtrl : public QoS::MemCtrl
 
     /**
      * To avoid iterating over the write queue to check for
-     * overlapping transactions, maintain a set of burst addresses
-     * that are currently queued. Since we merge writes to the same
-     * location we never have more than one address to the same burst
-     * address.
+     * overlapping transactions, maintain a map of burst addresses
+     * that are currently queued to the queued write. Since we merge
+     * writes to the same location we never have more than one write
+     * to the same burst address, and a read can only be serviced by
+     * the write to its burst.
      */
-    std::unordered_set<Addr> isInWriteQueue;
+    std::unordered_map<Addr, const DRAMPacket*> isInWriteQueue;
 
     /**
      * Response queue where read packets wait after we're done working
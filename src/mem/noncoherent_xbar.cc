@@ -312,6 +312,13 @@ NoncoherentXBar::recvFunctional(PacketPtr pkt, PortID slave_port_id)
     masterPorts[dest_id]->sendFunctional(pkt);
 }
 
+MemBackdoorPtr
+NoncoherentXBar::recvBackdoorReq(Addr addr, bool write, PortID slave_port_id)
+{
+    return masterPorts[findPort(RangeSize(addr, 1))]->sendBackdoorReq(addr,
+                                                                      write);
+}
+
 NoncoherentXBar*
 NoncoherentXBarParams::create()
 {
@@ -122,6 +122,12 @@ class NoncoherentXBar : public BaseXBar
         virtual void recvFunctional(PacketPtr pkt)
         { xbar.recvFunctional(pkt, id); }
 
+        /**
+         * When receiving a backdoor request, pass it to the crossbar.
+         */
+        virtual MemBackdoorPtr recvBackdoorReq(Addr addr, bool write)
+        { return xbar.recvBackdoorReq(addr, write, id); }
+
         /**
          * Return the union of all adress ranges seen by this crossbar.
          */
@@ -189,6 +195,11 @@ class NoncoherentXBar : public BaseXBar
         transaction.*/
     void recvFunctional(PacketPtr pkt, PortID slave_port_id);
 
+    /** Function called by the port when the crossbar is recieving a
+        backdoor request. */
+    MemBackdoorPtr recvBackdoorReq(Addr addr, bool write,
+                                   PortID slave_port_id);
+
   public:
 
     NoncoherentXBar(const NoncoherentXBarParams *p);
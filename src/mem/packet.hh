@@ -62,6 +62,7 @@
 #include "base/flags.hh"
 #include "base/logging.hh"
 #include "base/printable.hh"
+#include "base/slab_pool.hh"
 #include "base/types.hh"
 #include "mem/request.hh"
 #include "sim/core.hh"
@@ -255,8 +256,19 @@ class Packet : public Printable
     typedef uint32_t FlagsType;
     typedef ::Flags<FlagsType> Flags;
 
+    /** Largest data allocate() keeps inline in the packet. */
+    static const unsigned inlineDataSize = 64;
+
+    /** Largest data allocate() takes from the data buffer pool. */
+    static const unsigned pooledDataSize = 256;
+
+    /** Owner of the data buffer pool, for its counts. */
+    struct DataBuffer;
+
   private:
 
+    typedef SlabPool<DataBuffer, pooledDataSize> DataPool;
+
     enum : FlagsType {
         // Flags to transfer across when copying a packet
         COPY_FLAGS             = 0x0000003F,
@@ -297,6 +309,10 @@ class Packet : public Printable
         /// the packet is destroyed. The pointer is assumed to be pointing
         /// to an array, and delete [] is consequently called
         DYNAMIC_DATA           = 0x00002000,
+        /// The data pointer points to storage allocated by allocate(),
+        /// either inline in the packet or from the data buffer pool,
+        /// which is released when the packet is destroyed.
+        POOLED_DATA            = 0x00004000,
 
         /// suppress the error if this packet encounters a functional
         /// access failure.
@@ -348,6 +364,13 @@ class Packet : public Printable
     // Quality of Service priority value
     uint8_t _qosValue;
 
+    /**
+     * Storage for the data of small packets, which covers most
+     * accesses of the cores and the cache lines of the common
+     * configurations, so that they do not allocate any.
+     */
+    alignas(16) uint8_t inlineData[inlineDataSize];
+
   public:
 
     /**
@@ -898,6 +921,23 @@ class Packet : public Printable
         deleteData();
     }
 
+    /**
+     * Packets are allocated from a per-thread pool, as the memory
+     * system creates and destroys at least one per access.
+     */
+    static void *
+    operator new(size_t size)
+    {
+        assert(size == sizeof(Packet));
+        return SlabPool<Packet>::allocate();
+    }
+
+    static void
+    operator delete(void *p)
+    {
+        SlabPool<Packet>::deallocate(p);
+    }
+
     /**
      * Take a request packet and modify it in place to be suitable for
      * returning as a response to that request.
@@ -969,7 +1009,7 @@ class Packet : public Printable
     void
     dataStatic(T *p)
     {
-        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA));
         data = (PacketDataPtr)p;
         flags.set(STATIC_DATA);
     }
@@ -986,7 +1026,7 @@ class Packet : public Printable
     void
     dataStaticConst(const T *p)
     {
-        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA));
         data = const_cast<PacketDataPtr>(p);
         flags.set(STATIC_DATA);
     }
@@ -1007,7 +1047,7 @@ class Packet : public Printable
     void
     dataDynamic(T *p)
     {
-        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA));
         data = (PacketDataPtr)p;
         flags.set(DYNAMIC_DATA);
     }
@@ -1019,7 +1059,7 @@ class Packet : public Printable
     T*
     getPtr()
     {
-        assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA));
         return (T*)data;
     }
 
@@ -1027,7 +1067,7 @@ class Packet : public Printable
     const T*
     getConstPtr() const
     {
-        assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA));
         return (const T*)data;
     }
 
@@ -1150,8 +1190,10 @@ class Packet : public Printable
     {
         if (flags.isSet(DYNAMIC_DATA))
             delete [] data;
+        else if (flags.isSet(POOLED_DATA) && data != inlineData)
+            DataPool::deallocate(data);
 
-        flags.clear(STATIC_DATA|DYNAMIC_DATA);
+        flags.clear(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA);
         data = NULL;
     }
 
@@ -1162,9 +1204,17 @@ class Packet : public Printable
         // if either this command or the response command has a data
         // payload, actually allocate space
         if (hasData() || hasRespData()) {
-            assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
-            flags.set(DYNAMIC_DATA);
-            data = new uint8_t[getSize()];
+            assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA));
+            if (getSize() <= inlineDataSize) {
+                flags.set(POOLED_DATA);
+                data = inlineData;
+            } else if (getSize() <= pooledDataSize) {
+                flags.set(POOLED_DATA);
+                data = static_cast<PacketDataPtr>(DataPool::allocate());
+            } else {
+                flags.set(DYNAMIC_DATA);
+                data = new uint8_t[getSize()];
+            }
         }
     }
 
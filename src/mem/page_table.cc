@@ -39,12 +39,130 @@
 
 #include <string>
 
-#include "base/compiler.hh"
 #include "base/trace.hh"
 #include "debug/MMU.hh"
 #include "sim/faults.hh"
 #include "sim/serialize.hh"
 
+EmulationPageTable::~EmulationPageTable()
+{
+    for (unsigned i = 0; i < fanout; ++i) {
+        if (root.children[i])
+            freeNode(static_cast<Node *>(root.children[i]), 1);
+    }
+}
+
+void
+EmulationPageTable::freeNode(Node *node, unsigned level)
+{
+    for (unsigned i = 0; i < fanout; ++i) {
+        if (!node->children[i])
+            continue;
+        if (level == levels - 1)
+            delete static_cast<Leaf *>(node->children[i]);
+        else
+            freeNode(static_cast<Node *>(node->children[i]), level + 1);
+    }
+    delete node;
+}
+
+EmulationPageTable::Entry *
+EmulationPageTable::find(Addr vaddr) const
+{
+    const Addr vpn = vaddr >> pageShift;
+    const Node *node = &root;
+    for (unsigned level = 0; level < levels - 1; ++level) {
+        node = static_cast<const Node *>(
+                node->children[childIndex(vpn, level)]);
+        if (!node)
+            return nullptr;
+    }
+
+    Leaf *leaf = static_cast<Leaf *>(
+            node->children[childIndex(vpn, levels - 1)]);
+    const unsigned idx = childIndex(vpn, levels);
+    if (!leaf || !leaf->mapped[idx])
+        return nullptr;
+    return &leaf->entries[idx];
+}
+
+EmulationPageTable::Leaf &
+EmulationPageTable::leafFor(Addr vaddr)
+{
+    const Addr vpn = vaddr >> pageShift;
+    Node *node = &root;
+    for (unsigned level = 0; level < levels; ++level) {
+        void *&child = node->children[childIndex(vpn, level)];
+        if (!child) {
+            if (level == levels - 1)
+                child = new Leaf;
+            else
+                child = new Node;
+            ++node->used;
+        }
+        if (level == levels - 1)
+            return *static_cast<Leaf *>(child);
+        node = static_cast<Node *>(child);
+    }
+    panic("EmulationPageTable: page table without levels");
+}
+
+void
+EmulationPageTable::erase(Addr vaddr)
+{
+    const Addr vpn = vaddr >> pageShift;
+    Node *path[(64 + levelBits - 1) / levelBits];
+    assert(levels <= sizeof(path) / sizeof(path[0]));
+    void *child = &root;
+    for (unsigned level = 0; level < levels; ++level) {
+        path[level] = static_cast<Node *>(child);
+        child = path[level]->children[childIndex(vpn, level)];
+        assert(child);
+    }
+
+    Leaf *leaf = static_cast<Leaf *>(child);
+    const unsigned idx = childIndex(vpn, levels);
+    assert(leaf->mapped[idx]);
+    leaf->mapped[idx] = false;
+    --numEntries;
+    if (leaf->mapped.any())
+        return;
+
+    // Free the leaf, and the nodes it leaves empty, but the root
+    delete leaf;
+    for (unsigned level = levels; level-- > 0; ) {
+        path[level]->children[childIndex(vpn, level)] = nullptr;
+        if (--path[level]->used > 0 || level == 0)
+            break;
+        delete path[level];
+    }
+}
+
+void
+EmulationPageTable::forEachEntry(const Node *node, unsigned level, Addr vpn,
+        const std::function<void(Addr, const Entry &)> &f) const
+{
+    for (unsigned i = 0; i < fanout; ++i) {
+        const void *child = node->children[i];
+        if (!child)
+            continue;
+        const Addr child_vpn = (vpn << levelBits) | i;
+        if (level < levels - 1) {
+            forEachEntry(static_cast<const Node *>(child), level + 1,
+                         child_vpn, f);
+            continue;
+        }
+
+        const Leaf *leaf = static_cast<const Leaf *>(child);
+        for (unsigned j = 0; j < fanout; ++j) {
+            if (leaf->mapped[j]) {
+                f(((child_vpn << levelBits) | j) << pageShift,
+                  leaf->entries[j]);
+            }
+        }
+    }
+}
+
 void
 EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 {
@@ -54,17 +172,20 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 
     DPRINTF(MMU, "Allocating Page: %#x-%#x\n", vaddr, vaddr + size);
 
+    invalidateLast();
     while (size > 0) {
-        auto it = pTable.find(vaddr);
-        if (it != pTable.end()) {
+        Leaf &leaf = leafFor(vaddr);
+        const unsigned idx = childIndex(vaddr >> pageShift, levels);
+        if (leaf.mapped[idx]) {
             // already mapped
             panic_if(!clobber,
                      "EmulationPageTable::allocate: addr %#x already mapped",
                      vaddr);
-            it->second = Entry(paddr, flags);
         } else {
-            pTable.emplace(vaddr, Entry(paddr, flags));
+            leaf.mapped[idx] = true;
+            ++numEntries;
         }
+        leaf.entries[idx] = Entry(paddr, flags);
 
         size -= pageSize;
         vaddr += pageSize;
@@ -81,13 +202,18 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
     DPRINTF(MMU, "moving pages from vaddr %08p to %08p, size = %d\n", vaddr,
             new_vaddr, size);
 
+    invalidateLast();
     while (size > 0) {
-        auto new_it M5_VAR_USED = pTable.find(new_vaddr);
-        auto old_it = pTable.find(vaddr);
-        assert(old_it != pTable.end() && new_it == pTable.end());
+        const Entry *old_entry = find(vaddr);
+        assert(old_entry && !find(new_vaddr));
+        const Entry entry = *old_entry;
 
-        pTable.emplace(new_vaddr, old_it->second);
-        pTable.erase(old_it);
+        Leaf &leaf = leafFor(new_vaddr);
+        const unsigned idx = childIndex(new_vaddr >> pageShift, levels);
+        leaf.mapped[idx] = true;
+        leaf.entries[idx] = entry;
+        ++numEntries;
+        erase(vaddr);
         size -= pageSize;
         vaddr += pageSize;
         new_vaddr += pageSize;
@@ -97,8 +223,9 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
 void
 EmulationPageTable::getMappings(std::vector<std::pair<Addr, Addr>> *addr_maps)
 {
-    for (auto &iter : pTable)
-        addr_maps->push_back(std::make_pair(iter.first, iter.second.paddr));
+    forEachEntry([addr_maps](Addr vaddr, const Entry &entry) {
+        addr_maps->push_back(std::make_pair(vaddr, entry.paddr));
+    });
 }
 
 void
@@ -108,10 +235,9 @@ EmulationPageTable::unmap(Addr vaddr, int64_t size)
 
     DPRINTF(MMU, "Unmapping page: %#x-%#x\n", vaddr, vaddr + size);
 
+    invalidateLast();
     while (size > 0) {
-        auto it = pTable.find(vaddr);
-        assert(it != pTable.end());
-        pTable.erase(it);
+        erase(vaddr);
         size -= pageSize;
         vaddr += pageSize;
     }
@@ -124,22 +250,12 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
     assert(pageOffset(vaddr) == 0);
 
     for (int64_t offset = 0; offset < size; offset += pageSize)
-        if (pTable.find(vaddr + offset) != pTable.end())
+        if (find(vaddr + offset))
             return false;
 
     return true;
 }
 
-const EmulationPageTable::Entry *
-EmulationPageTable::lookup(Addr vaddr)
-{
-    Addr page_addr = pageAlign(vaddr);
-    PTableItr iter = pTable.find(page_addr);
-    if (iter == pTable.end())
-        return nullptr;
-    return &(iter->second);
-}
-
 bool
 EmulationPageTable::translate(Addr vaddr, Addr &paddr)
 {
@@ -172,17 +288,17 @@ EmulationPageTable::translate(const RequestPtr &req)
 void
 EmulationPageTable::serialize(CheckpointOut &cp) const
 {
-    paramOut(cp, "ptable.size", pTable.size());
+    paramOut(cp, "ptable.size", numEntries);
 
-    PTable::size_type count = 0;
-    for (auto &pte : pTable) {
+    size_t count = 0;
+    forEachEntry([&cp, &count](Addr vaddr, const Entry &entry) {
         ScopedCheckpointSection sec(cp, csprintf("Entry%d", count++));
 
-        paramOut(cp, "vaddr", pte.first);
-        paramOut(cp, "paddr", pte.second.paddr);
-        paramOut(cp, "flags", pte.second.flags);
-    }
-    assert(count == pTable.size());
+        paramOut(cp, "vaddr", vaddr);
+        paramOut(cp, "paddr", entry.paddr);
+        paramOut(cp, "flags", entry.flags);
+    });
+    assert(count == numEntries);
 }
 
 void
@@ -201,7 +317,14 @@ EmulationPageTable::unserialize(CheckpointIn &cp)
         UNSERIALIZE_SCALAR(paddr);
         UNSERIALIZE_SCALAR(flags);
 
-        pTable.emplace(vaddr, Entry(paddr, flags));
+        Leaf &leaf = leafFor(vaddr);
+        const unsigned idx = childIndex(vaddr >> pageShift, levels);
+        if (!leaf.mapped[idx]) {
+            leaf.mapped[idx] = true;
+            leaf.entries[idx] = Entry(paddr, flags);
+            ++numEntries;
+        }
     }
+    invalidateLast();
 }
 
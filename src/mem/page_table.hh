@@ -37,8 +37,9 @@
 #ifndef __MEM_PAGE_TABLE_HH__
 #define __MEM_PAGE_TABLE_HH__
 
+#include <bitset>
+#include <functional>
 #include <string>
-#include <unordered_map>
 
 #include "base/intmath.hh"
 #include "base/types.hh"
@@ -60,9 +61,31 @@ class EmulationPageTable : public Serializable
     };
 
   protected:
-    typedef std::unordered_map<Addr, Entry> PTable;
-    typedef PTable::iterator PTableItr;
-    PTable pTable;
+    /**
+     * The entries are kept in a radix tree indexed by virtual page
+     * number, each level of which consumes levelBits of the number, most
+     * significant first. The inner nodes point to the nodes of the next
+     * level, and those of the last level to leaves, which hold the
+     * entries of fanout consecutive pages.
+     */
+    static const unsigned levelBits = 9;
+    static const unsigned fanout = 1 << levelBits;
+
+    struct Leaf
+    {
+        Entry entries[fanout];
+        std::bitset<fanout> mapped;
+    };
+
+    struct Node
+    {
+        /** Nodes of the next level, or leaves in the last level. */
+        void *children[fanout];
+        /** Number of non-null children. */
+        unsigned used;
+
+        Node() : children(), used(0) {}
+    };
 
     const Addr pageSize;
     const Addr offsetMask;
@@ -70,19 +93,65 @@ class EmulationPageTable : public Serializable
     const uint64_t _pid;
     const std::string _name;
 
+    const unsigned pageShift;
+    /** Number of levels of inner nodes, the root included. */
+    const unsigned levels;
+
+    Node root;
+    size_t numEntries;
+
+    /**
+     * Last page looked up and its entry, or nullptr if it is unmapped.
+     * Any change to the mappings invalidates it.
+     */
+    Addr lastPage;
+    const Entry *lastEntry;
+
+    /** Index of the child of a node of a level holding a page number. */
+    unsigned
+    childIndex(Addr vpn, unsigned level) const
+    {
+        return (vpn >> (levelBits * (levels - level))) & (fanout - 1);
+    }
+
+    /** Entry of a page, or nullptr if it is unmapped. */
+    Entry *find(Addr vaddr) const;
+    /** Leaf holding the entry of a page, created if needed. */
+    Leaf &leafFor(Addr vaddr);
+    /** Unmap a page, which must be mapped, and free the empty nodes. */
+    void erase(Addr vaddr);
+
+    void freeNode(Node *node, unsigned level);
+    void forEachEntry(const Node *node, unsigned level, Addr vpn,
+            const std::function<void(Addr, const Entry &)> &f) const;
+
+    /** Call f with the address and entry of each page, in address order. */
+    void
+    forEachEntry(const std::function<void(Addr, const Entry &)> &f) const
+    {
+        forEachEntry(&root, 0, 0, f);
+    }
+
+    void invalidateLast() { lastPage = MaxAddr; }
+
   public:
 
     EmulationPageTable(
             const std::string &__name, uint64_t _pid, Addr _pageSize) :
             pageSize(_pageSize), offsetMask(mask(floorLog2(_pageSize))),
-            _pid(_pid), _name(__name)
+            _pid(_pid), _name(__name), pageShift(floorLog2(_pageSize)),
+            levels(divCeil(64 - pageShift - levelBits, levelBits)),
+            numEntries(0), lastPage(MaxAddr), lastEntry(nullptr)
     {
         assert(isPowerOf2(pageSize));
     }
 
+    EmulationPageTable(const EmulationPageTable &) = delete;
+    EmulationPageTable &operator=(const EmulationPageTable &) = delete;
+
     uint64_t pid() const { return _pid; };
 
-    virtual ~EmulationPageTable() {};
+    virtual ~EmulationPageTable();
 
     /* generic page table mapping flags
      *              unset | set
@@ -129,7 +198,16 @@ class EmulationPageTable : public Serializable
      * @param vaddr The virtual address.
      * @return The page table entry corresponding to vaddr.
      */
-    const Entry *lookup(Addr vaddr);
+    const Entry *
+    lookup(Addr vaddr)
+    {
+        const Addr page = pageAlign(vaddr);
+        if (page != lastPage) {
+            lastEntry = find(page);
+            lastPage = page;
+        }
+        return lastEntry;
+    }
 
     /**
      * Translate function
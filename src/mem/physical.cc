@@ -56,6 +56,7 @@
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
 #include "mem/abstract_mem.hh"
+#include "mem/sparse_store.hh"
 
 /**
  * On Linux, MAP_NORESERVE allow us to simulate a very large memory
@@ -73,8 +74,13 @@ using namespace std;
 
 PhysicalMemory::PhysicalMemory(const string& _name,
                                const vector<AbstractMemory*>& _memories,
-                               bool mmap_using_noreserve) :
-    _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve)
+                               bool mmap_using_noreserve,
+                               Enums::PhysMemStoreFormat store_format,
+                               unsigned store_threads,
+                               bool store_restore_mmap) :
+    _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
+    storeFormat(store_format), storeThreads(store_threads),
+    storeRestoreMmap(store_restore_mmap)
 {
     if (mmap_using_noreserve)
         warn("Not reserving swap space. May cause SIGSEGV on actual usage\n");
@@ -340,8 +346,17 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
     SERIALIZE_SCALAR(filename);
     SERIALIZE_SCALAR(range_size);
 
+    string format = Enums::PhysMemStoreFormatStrings[storeFormat];
+    SERIALIZE_SCALAR(format);
+
     // write memory file
     string filepath = CheckpointIn::dir() + "/" + filename.c_str();
+    if (storeFormat != Enums::gzip) {
+        SparseStore::write(filepath, pmem, range.size(),
+                           storeFormat == Enums::sparse, storeThreads);
+        return;
+    }
+
     gzFile compressed_mem = gzopen(filepath.c_str(), "wb");
     if (compressed_mem == NULL)
         fatal("Can't open physical memory checkpoint file '%s'\n",
@@ -407,11 +422,6 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     string filepath = cp.cptDir + "/" + filename;
 
-    // mmap memoryfile
-    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
-    if (compressed_mem == NULL)
-        fatal("Can't open physical memory checkpoint file '%s'", filename);
-
     // we've already got the actual backing store mapped
     uint8_t* pmem = backingStore[store_id].pmem;
     AddrRange range = backingStore[store_id].range;
@@ -426,6 +436,24 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
         fatal("Memory range size has changed! Saw %lld, expected %lld\n",
               range_size, range.size());
 
+    // checkpoints without a format predate the sparse ones
+    string format = "gzip";
+    UNSERIALIZE_OPT_SCALAR(format);
+    if (format == "sparse" || format == "sparse_raw") {
+        const uint64_t mapped_pages = SparseStore::read(
+            filepath, pmem, range.size(), storeRestoreMmap, storeThreads);
+        DPRINTF(Checkpoint, "Mapped %d pages of %s\n", mapped_pages,
+                filepath);
+        return;
+    } else if (format != "gzip") {
+        fatal("Unknown format '%s' of physical memory checkpoint file "
+              "'%s'\n", format, filename);
+    }
+
+    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
+    if (compressed_mem == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'", filename);
+
     uint64_t curr_size = 0;
     long* temp_page = new long[chunk_size];
     long* pmem_current;
@@ -41,6 +41,7 @@
 #define __MEM_PHYSICAL_HH__
 
 #include "base/addr_range_map.hh"
+#include "enums/PhysMemStoreFormat.hh"
 #include "mem/packet.hh"
 
 /**
@@ -129,6 +130,15 @@ class PhysicalMemory : public Serializable
     // Let the user choose if we reserve swap space when calling mmap
     const bool mmapUsingNoReserve;
 
+    // Format of the checkpoint files of the backing store
+    const Enums::PhysMemStoreFormat storeFormat;
+
+    // Host threads (de)compressing sparse checkpoint files
+    const unsigned storeThreads;
+
+    // Map the raw pages of sparse checkpoint files on restore
+    const bool storeRestoreMmap;
+
     // The physical memory used to provide the memory in the simulated
     // system
     std::vector<BackingStoreEntry> backingStore;
@@ -160,7 +170,9 @@ class PhysicalMemory : public Serializable
      */
     PhysicalMemory(const std::string& _name,
                    const std::vector<AbstractMemory*>& _memories,
-                   bool mmap_using_noreserve);
+                   bool mmap_using_noreserve,
+                   Enums::PhysMemStoreFormat store_format,
+                   unsigned store_threads, bool store_restore_mmap);
 
     /**
      * Unmap all the backing store we have used.
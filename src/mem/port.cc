@@ -176,6 +176,12 @@ MasterPort::sendFunctional(PacketPtr pkt)
     return _slavePort->recvFunctional(pkt);
 }
 
+MemBackdoorPtr
+MasterPort::sendBackdoorReq(Addr addr, bool write)
+{
+    return _slavePort->recvBackdoorReq(addr, write);
+}
+
 bool
 MasterPort::sendTimingReq(PacketPtr pkt)
 {
@@ -206,7 +212,7 @@ MasterPort::sendRetryResp()
 void
 MasterPort::printAddr(Addr a)
 {
-    auto req = std::make_shared<Request>(
+    auto req = Request::create(
         a, 1, 0, Request::funcMasterId);
 
     Packet pkt(req, MemCmd::PrintReq);
@@ -51,6 +51,7 @@
 #define __MEM_PORT_HH__
 
 #include "base/addr_range.hh"
+#include "mem/backdoor.hh"
 #include "mem/packet.hh"
 
 class MemObject;
@@ -101,6 +102,9 @@ class Port
     /** Get the port id. */
     PortID getId() const { return id; }
 
+    /** Get the MemObject that owns this port. */
+    MemObject &getOwner() const { return owner; }
+
 };
 
 /** Forward declaration */
@@ -210,6 +214,20 @@ class MasterPort : public BaseMasterPort
      */
     void sendFunctional(PacketPtr pkt);
 
+    /**
+     * Ask for a backdoor to the memory holding an address, through
+     * which later atomic and functional accesses to the address can
+     * bypass the memory system. The backdoor is only valid until it is
+     * invalidated.
+     *
+     * @param addr Address to get a backdoor for.
+     * @param write Whether the backdoor is also written through, and not
+     *              only read through.
+     *
+     * @return The backdoor, or nullptr if the slave refuses to give one.
+     */
+    MemBackdoorPtr sendBackdoorReq(Addr addr, bool write);
+
     /**
      * Attempt to send a timing request to the slave port by calling
      * its corresponding receive function. If the send does not
@@ -266,6 +284,17 @@ class MasterPort : public BaseMasterPort
      */
     virtual bool isSnooping() const { return false; }
 
+    /**
+     * Determine if this master port must see the snoops of reads, as a
+     * cache holding data that the reads must find does. A port that
+     * only snoops to watch the writes of others (e.g., to clear its
+     * load-locked reservations) can leave reads unsnooped, and reads
+     * through a backdoor can then bypass it.
+     *
+     * @return true if reads must be snooped by this port
+     */
+    virtual bool isSnoopingReads() const { return isSnooping(); }
+
     /**
      * Get the address ranges of the connected slave port.
      */
@@ -417,6 +446,13 @@ class SlavePort : public BaseSlavePort
      */
     bool isSnooping() const { return _masterPort->isSnooping(); }
 
+    /**
+     * Find out if the peer master port must see the snoops of reads.
+     *
+     * @return true if reads must be snooped by the peer master port
+     */
+    bool isSnoopingReads() const { return _masterPort->isSnoopingReads(); }
+
     /**
      * Called by the owner to send a range change
      */
@@ -459,6 +495,14 @@ class SlavePort : public BaseSlavePort
      */
     virtual void recvFunctional(PacketPtr pkt) = 0;
 
+    /**
+     * Receive a backdoor request from the master port. The default is
+     * to refuse it, which is what any port that keeps state or models
+     * timing on the way to the memory (e.g., a cache) must do.
+     */
+    virtual MemBackdoorPtr recvBackdoorReq(Addr addr, bool write)
+    { return nullptr; }
+
     /**
      * Receive a timing request from the master port.
      */
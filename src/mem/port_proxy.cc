@@ -39,22 +39,50 @@
 
 #include "mem/port_proxy.hh"
 
-#include "base/chunk_generator.hh"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+
+/** Bytes of an access of size bytes at addr up to the end of a block. */
+int
+chunkBytes(Addr addr, int size, Addr block_size)
+{
+    return std::min<Addr>(size, block_size - (addr & (block_size - 1)));
+}
+
+} // anonymous namespace
 
 void
 PortProxy::readBlobPhys(Addr addr, Request::Flags flags,
                         uint8_t *p, int size) const
 {
-    for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
-         gen.next()) {
+    while (size > 0) {
+        // Through a backdoor, copy the rest of the page at once
+        Tick latency;
+        if (uint8_t *host = backdoors.lookup(addr, latency)) {
+            const int bytes =
+                chunkBytes(addr, size, BackdoorCache::pageBytes);
+            std::memcpy(p, host, bytes);
+            addr += bytes;
+            p += bytes;
+            size -= bytes;
+            continue;
+        }
 
-        auto req = std::make_shared<Request>(
-            gen.addr(), gen.size(), flags, Request::funcMasterId);
+        const int bytes = chunkBytes(addr, size, _cacheLineSize);
+        auto req = Request::create(addr, bytes, flags, Request::funcMasterId);
 
         Packet pkt(req, MemCmd::ReadReq);
         pkt.dataStatic(p);
         _port.sendFunctional(&pkt);
-        p += gen.size();
+        backdoors.fill(_port, addr, 0, false);
+
+        addr += bytes;
+        p += bytes;
+        size -= bytes;
     }
 }
 
@@ -62,16 +90,30 @@ void
 PortProxy::writeBlobPhys(Addr addr, Request::Flags flags,
                          const uint8_t *p, int size) const
 {
-    for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
-         gen.next()) {
+    while (size > 0) {
+        // Through a backdoor, copy the rest of the page at once
+        Tick latency;
+        if (uint8_t *host = backdoors.lookup(addr, latency, true)) {
+            const int bytes =
+                chunkBytes(addr, size, BackdoorCache::pageBytes);
+            std::memcpy(host, p, bytes);
+            addr += bytes;
+            p += bytes;
+            size -= bytes;
+            continue;
+        }
 
-        auto req = std::make_shared<Request>(
-            gen.addr(), gen.size(), flags, Request::funcMasterId);
+        const int bytes = chunkBytes(addr, size, _cacheLineSize);
+        auto req = Request::create(addr, bytes, flags, Request::funcMasterId);
 
         Packet pkt(req, MemCmd::WriteReq);
         pkt.dataStaticConst(p);
         _port.sendFunctional(&pkt);
-        p += gen.size();
+        backdoors.fill(_port, addr, 0, true);
+
+        addr += bytes;
+        p += bytes;
+        size -= bytes;
     }
 }
 
@@ -79,13 +121,27 @@ void
 PortProxy::memsetBlobPhys(Addr addr, Request::Flags flags,
                           uint8_t v, int size) const
 {
-    // quick and dirty...
-    uint8_t *buf = new uint8_t[size];
+    // Set the pages with a backdoor in place, and write the rest a line
+    // at a time
+    std::vector<uint8_t> line;
+    while (size > 0) {
+        Tick latency;
+        if (uint8_t *host = backdoors.lookup(addr, latency, true)) {
+            const int bytes =
+                chunkBytes(addr, size, BackdoorCache::pageBytes);
+            std::memset(host, v, bytes);
+            addr += bytes;
+            size -= bytes;
+            continue;
+        }
 
-    std::memset(buf, v, size);
-    PortProxy::writeBlobPhys(addr, flags, buf, size);
-
-    delete [] buf;
+        const int bytes = chunkBytes(addr, size, _cacheLineSize);
+        if (line.empty())
+            line.assign(_cacheLineSize, v);
+        PortProxy::writeBlobPhys(addr, flags, line.data(), bytes);
+        addr += bytes;
+        size -= bytes;
+    }
 }
 
 
@@ -64,6 +64,7 @@
     #include "arch/isa_traits.hh"
 #endif
 
+#include "mem/backdoor.hh"
 #include "mem/port.hh"
 #include "sim/byteswap.hh"
 
@@ -91,6 +92,12 @@ class PortProxy
     /** Granularity of any transactions issued through this proxy. */
     const unsigned int _cacheLineSize;
 
+    /**
+     * Host pointers of the pages recently accessed, which accesses use
+     * instead of functional packets when the memory system gave them.
+     */
+    mutable BackdoorCache backdoors;
+
   public:
     PortProxy(MasterPort &port, unsigned int cacheLineSize) :
         _port(port), _cacheLineSize(cacheLineSize) { }
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/queue_bridge.hh"
+
+#include "base/trace.hh"
+#include "debug/QueueBridge.hh"
+#include "params/QueueBridge.hh"
+
+QueueBridge::QueueBridge(const QueueBridgeParams *p)
+    : MemObject(p),
+      masterSide(getEventQueue(p->master_eventq_index)),
+      delay(p->delay),
+      slavePort(p->name + ".slave", *this),
+      masterPort(p->name + ".master", *this),
+      reqQueue(masterSide, masterPort),
+      respQueue(*this, slavePort),
+      snoopRespQueue(masterSide, masterPort),
+      reqChannel(p->name + ".req_channel", eventQueue(),
+                 masterSide.eventQueue(), delay,
+                 [this](const PacketPtr &pkt) {
+                     masterPort.schedTimingReq(pkt,
+                         masterSide.eventQueue()->getCurTick());
+                 }),
+      respChannel(p->name + ".resp_channel", masterSide.eventQueue(),
+                  eventQueue(), delay,
+                  [this](const PacketPtr &pkt) {
+                      slavePort.schedTimingResp(pkt, curTick());
+                  })
+{
+}
+
+void
+QueueBridge::init()
+{
+    if (!slavePort.isConnected() || !masterPort.isConnected())
+        fatal("Both ports of a queue bridge must be connected.\n");
+}
+
+void
+QueueBridge::serialize(CheckpointOut &cp) const
+{
+    fatal_if(masterSide.eventQueue() != eventQueue(),
+             "%s: Checkpointing a queue bridge between two event queues "
+             "is not supported.\n", name());
+}
+
+BaseMasterPort&
+QueueBridge::getMasterPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "master")
+        return masterPort;
+    else
+        return MemObject::getMasterPort(if_name, idx);
+}
+
+BaseSlavePort&
+QueueBridge::getSlavePort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "slave")
+        return slavePort;
+    else
+        return MemObject::getSlavePort(if_name, idx);
+}
+
+bool
+QueueBridge::trySatisfyFunctional(PacketPtr pkt)
+{
+    auto check = [pkt](const PacketPtr &in_flight) {
+        return pkt->trySatisfyFunctional(in_flight);
+    };
+
+    return slavePort.trySatisfyFunctional(pkt) ||
+        respChannel.anyOf(check) || reqChannel.anyOf(check) ||
+        masterPort.trySatisfyFunctional(pkt);
+}
+
+QueueBridge::BridgeSlavePort::BridgeSlavePort(const std::string &_name,
+                                              QueueBridge &_bridge)
+    : QueuedSlavePort(_name, &_bridge, _bridge.respQueue), bridge(_bridge)
+{
+}
+
+bool
+QueueBridge::BridgeSlavePort::recvTimingReq(PacketPtr pkt)
+{
+    DPRINTF(QueueBridge, "recvTimingReq: %s addr 0x%x\n",
+            pkt->cmdString(), pkt->getAddr());
+
+    panic_if(pkt->cacheResponding(), "Should not see packets where cache "
+             "is responding");
+
+    // the packet only reaches us after the header and payload delays
+    Tick receive_delay = pkt->headerDelay + pkt->payloadDelay;
+    pkt->headerDelay = pkt->payloadDelay = 0;
+
+    bridge.reqChannel.send(pkt, receive_delay);
+
+    return true;
+}
+
+Tick
+QueueBridge::BridgeSlavePort::recvAtomic(PacketPtr pkt)
+{
+    panic_if(pkt->cacheResponding(), "Should not see packets where cache "
+             "is responding");
+
+    EventQueue::ScopedMigration migrate(bridge.masterSide.eventQueue(),
+                                        inParallelMode);
+
+    return 2 * bridge.delay + bridge.masterPort.sendAtomic(pkt);
+}
+
+void
+QueueBridge::BridgeSlavePort::recvFunctional(PacketPtr pkt)
+{
+    EventQueue::ScopedMigration migrate(bridge.masterSide.eventQueue(),
+                                        inParallelMode);
+
+    if (bridge.trySatisfyFunctional(pkt)) {
+        pkt->makeResponse();
+    } else {
+        bridge.masterPort.sendFunctional(pkt);
+    }
+}
+
+QueueBridge::BridgeMasterPort::BridgeMasterPort(const std::string &_name,
+                                                QueueBridge &_bridge)
+    : QueuedMasterPort(_name, &_bridge, _bridge.reqQueue,
+                       _bridge.snoopRespQueue),
+      bridge(_bridge)
+{
+}
+
+bool
+QueueBridge::BridgeMasterPort::recvTimingResp(PacketPtr pkt)
+{
+    DPRINTF(QueueBridge, "recvTimingResp: %s addr 0x%x\n",
+            pkt->cmdString(), pkt->getAddr());
+
+    Tick receive_delay = pkt->headerDelay + pkt->payloadDelay;
+    pkt->headerDelay = pkt->payloadDelay = 0;
+
+    bridge.respChannel.send(pkt, receive_delay);
+
+    return true;
+}
+
+QueueBridge *
+QueueBridgeParams::create()
+{
+    return new QueueBridge(this);
+}
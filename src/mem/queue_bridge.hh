@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_QUEUE_BRIDGE_HH__
+#define __MEM_QUEUE_BRIDGE_HH__
+
+#include "mem/mem_object.hh"
+#include "mem/qport.hh"
+#include "sim/cross_queue_channel.hh"
+
+struct QueueBridgeParams;
+
+/**
+ * A bridge between two main event queues, which lets a part of the
+ * memory system (typically a core and its private caches) run in its
+ * own thread. The slave side of the bridge runs in the bridge's event
+ * queue and the master side in master_eventq_index.
+ *
+ * Timing requests and responses cross through cross-queue channels,
+ * which are exchanged deterministically at the quantum barriers. The
+ * bridge delay is the lookahead of those channels, so it bounds (and
+ * by default sets) the simulation quantum. Each side queues the packets
+ * it received until its peer accepts them, so flow control never
+ * crosses the bridge.
+ *
+ * Atomic and functional accesses are forwarded synchronously, with the
+ * master side's event queue temporarily taken over by the calling
+ * thread (see EventQueue::ScopedMigration).
+ *
+ * The bridge does not forward snoops. A coherent crossbar resolves a
+ * snoop within the same call as the request that caused it, which a
+ * channel with a lookahead cannot do, so the caches above the bridge
+ * are not kept coherent with the rest of the system. In particular, a
+ * coherent shared crossbar and last-level cache behind bridged cores
+ * is not supported. Bridged CPUs are only supported for
+ * multi-programmed workloads in syscall emulation mode, where no two
+ * CPUs run the same process. The configuration scripts refuse anything
+ * else; a workload that clones threads onto other CPUs at run time is
+ * not detected, and is not supported either.
+ *
+ * The channels drain with the rest of the system. Checkpointing a
+ * bridge between two different event queues is refused, as the queues
+ * are not restored to a common tick.
+ */
+class QueueBridge : public MemObject
+{
+  protected:
+    class BridgeSlavePort : public QueuedSlavePort
+    {
+      public:
+        BridgeSlavePort(const std::string &_name, QueueBridge &_bridge);
+
+      protected:
+        bool recvTimingReq(PacketPtr pkt) override;
+        Tick recvAtomic(PacketPtr pkt) override;
+        void recvFunctional(PacketPtr pkt) override;
+        AddrRangeList getAddrRanges() const override {
+            return bridge.masterPort.getAddrRanges();
+        }
+
+        bool tryTiming(PacketPtr pkt) override { return true; }
+
+      private:
+        QueueBridge &bridge;
+    };
+
+    class BridgeMasterPort : public QueuedMasterPort
+    {
+      public:
+        BridgeMasterPort(const std::string &_name, QueueBridge &_bridge);
+
+      protected:
+        bool recvTimingResp(PacketPtr pkt) override;
+
+        void recvRangeChange() override {
+            bridge.slavePort.sendRangeChange();
+        }
+
+      private:
+        QueueBridge &bridge;
+    };
+
+    /** Check the packets in flight through the bridge. */
+    bool trySatisfyFunctional(PacketPtr pkt);
+
+    /** The master side's event queue. */
+    EventManager masterSide;
+
+    /** Latency of the bridge in each direction. */
+    const Tick delay;
+
+    BridgeSlavePort slavePort;
+    BridgeMasterPort masterPort;
+
+    /** Packets that crossed the bridge, waiting for their peer. */
+    ReqPacketQueue reqQueue;
+    RespPacketQueue respQueue;
+    SnoopRespPacketQueue snoopRespQueue;
+
+    /** Requests crossing from the slave side to the master side. */
+    CrossQueueChannel<PacketPtr> reqChannel;
+    /** Responses crossing from the master side to the slave side. */
+    CrossQueueChannel<PacketPtr> respChannel;
+
+  public:
+    QueueBridge(const QueueBridgeParams *p);
+
+    void init() override;
+
+    void serialize(CheckpointOut &cp) const override;
+
+    BaseMasterPort& getMasterPort(const std::string &if_name,
+                                  PortID idx = InvalidPortID) override;
+    BaseSlavePort& getSlavePort(const std::string &if_name,
+                                PortID idx = InvalidPortID) override;
+};
+
+#endif //__MEM_QUEUE_BRIDGE_HH__
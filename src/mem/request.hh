@@ -54,9 +54,12 @@
 
 #include <cassert>
 #include <climits>
+#include <memory>
+#include <utility>
 
 #include "base/flags.hh"
 #include "base/logging.hh"
+#include "base/slab_pool.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
 #include "sim/core.hh"
@@ -501,6 +504,19 @@ class Request
         }
     }
 
+    /**
+     * Create a shared request. The request and its reference count are
+     * allocated together from a per-thread pool, rather than from the
+     * heap as std::make_shared would do.
+     */
+    template <typename... Args>
+    static RequestPtr
+    create(Args&&... args)
+    {
+        return std::allocate_shared<Request>(SlabAllocator<Request>(),
+                                             std::forward<Args>(args)...);
+    }
+
     /**
      * Set up Context numbers.
      */
@@ -574,8 +590,8 @@ class Request
         assert(privateFlags.isSet(VALID_VADDR));
         assert(privateFlags.noneSet(VALID_PADDR));
         assert(split_addr > _vaddr && split_addr < _vaddr + _size);
-        req1 = std::make_shared<Request>(*this);
-        req2 = std::make_shared<Request>(*this);
+        req1 = create(*this);
+        req2 = create(*this);
         req1->_size = split_addr - _vaddr;
         req2->_vaddr = split_addr;
         req2->_size = _size - req1->_size;
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_REQUEST_MAP_HH__
+#define __MEM_REQUEST_MAP_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "mem/request.hh"
+
+/**
+ * @file
+ * Map from outstanding requests to a small value, such as the port a
+ * crossbar routes the response of a request to.
+ */
+
+/**
+ * Open-addressing hash map keyed by request. Entries live in a single
+ * array and are found by linear probing, so that adding and removing
+ * the entry of a request does not allocate, unlike with the nodes of
+ * an std::unordered_map. The map holds a reference to the requests of
+ * its entries, as the requests must not be reused while they are in
+ * the map.
+ *
+ * Adding and removing entries invalidates the iterators to the other
+ * entries.
+ */
+template <class T>
+class RequestMap
+{
+  public:
+    struct Entry
+    {
+        RequestPtr first;
+        T second;
+    };
+
+    typedef Entry *iterator;
+
+  private:
+    std::vector<Entry> entries;
+    size_t count;
+
+    size_t
+    home(const Request *req) const
+    {
+        const uint64_t key = reinterpret_cast<uintptr_t>(req);
+        return (key * 0x9e3779b97f4a7c15ULL >> 32) & (entries.size() - 1);
+    }
+
+    size_t next(size_t i) const { return (i + 1) & (entries.size() - 1); }
+
+    void
+    grow()
+    {
+        std::vector<Entry> old(entries.size() * 2);
+        old.swap(entries);
+        for (auto &entry : old) {
+            if (entry.first) {
+                size_t i = home(entry.first.get());
+                while (entries[i].first)
+                    i = next(i);
+                entries[i] = std::move(entry);
+            }
+        }
+    }
+
+  public:
+    RequestMap() : entries(64), count(0) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    iterator end() { return nullptr; }
+
+    iterator
+    find(const RequestPtr &req)
+    {
+        for (size_t i = home(req.get()); entries[i].first; i = next(i)) {
+            if (entries[i].first == req)
+                return &entries[i];
+        }
+        return end();
+    }
+
+    /**
+     * Add an entry for a request, if there is none.
+     * @return The entry of the request.
+     */
+    iterator
+    insert(const RequestPtr &req)
+    {
+        assert(req);
+
+        // keep at least half of the entries free for short probes
+        if (2 * (count + 1) > entries.size())
+            grow();
+
+        size_t i = home(req.get());
+        for (; entries[i].first; i = next(i)) {
+            if (entries[i].first == req)
+                return &entries[i];
+        }
+
+        entries[i].first = req;
+        entries[i].second = T();
+        count++;
+        return &entries[i];
+    }
+
+    T &operator[](const RequestPtr &req) { return insert(req)->second; }
+
+    void
+    erase(iterator it)
+    {
+        assert(it && it->first);
+        size_t hole = it - entries.data();
+        entries[hole].first.reset();
+        count--;
+
+        // move back the entries that were displaced past the hole, so
+        // that lookups do not need markers for removed entries
+        for (size_t i = next(hole); entries[i].first; i = next(i)) {
+            const size_t want = home(entries[i].first.get());
+            const bool past_hole = hole <= i ?
+                (want <= hole || want > i) : (want <= hole && want > i);
+            if (past_hole) {
+                entries[hole] = std::move(entries[i]);
+                entries[i].first.reset();
+                hole = i;
+            }
+        }
+    }
+
+    void
+    erase(const RequestPtr &req)
+    {
+        iterator it = find(req);
+        if (it != end())
+            erase(it);
+    }
+};
+
+#endif // __MEM_REQUEST_MAP_HH__
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "mem/request_map.hh"
+
+namespace {
+
+std::vector<RequestPtr>
+makeRequests(unsigned num_reqs)
+{
+    std::vector<RequestPtr> reqs;
+    for (unsigned i = 0; i < num_reqs; i++)
+        reqs.push_back(Request::create());
+    return reqs;
+}
+
+} // anonymous namespace
+
+TEST(RequestMap, InsertFindErase)
+{
+    std::vector<RequestPtr> reqs = makeRequests(3);
+    RequestMap<int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.end(), map.find(reqs[0]));
+
+    map[reqs[0]] = 1;
+    map[reqs[1]] = 2;
+    EXPECT_EQ(2, map.size());
+    ASSERT_NE(map.end(), map.find(reqs[0]));
+    EXPECT_EQ(reqs[0], map.find(reqs[0])->first);
+    EXPECT_EQ(1, map.find(reqs[0])->second);
+    EXPECT_EQ(2, map.find(reqs[1])->second);
+    EXPECT_EQ(map.end(), map.find(reqs[2]));
+
+    // inserting an existing request keeps its value
+    EXPECT_EQ(2, map.insert(reqs[1])->second);
+    EXPECT_EQ(2, map.size());
+
+    map.erase(map.find(reqs[0]));
+    EXPECT_EQ(map.end(), map.find(reqs[0]));
+    EXPECT_EQ(2, map.find(reqs[1])->second);
+
+    // erasing a request that is not in the map does nothing
+    map.erase(reqs[2]);
+    map.erase(reqs[1]);
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(RequestMap, HoldsRequests)
+{
+    RequestMap<int> map;
+    RequestPtr req = Request::create();
+    map[req] = 1;
+    EXPECT_EQ(2, req.use_count());
+    map.erase(req);
+    EXPECT_EQ(1, req.use_count());
+}
+
+TEST(RequestMap, Grow)
+{
+    // far more entries than the initial capacity
+    std::vector<RequestPtr> reqs = makeRequests(1000);
+    RequestMap<unsigned> map;
+    for (unsigned i = 0; i < reqs.size(); i++)
+        map[reqs[i]] = i;
+
+    EXPECT_EQ(reqs.size(), map.size());
+    for (unsigned i = 0; i < reqs.size(); i++) {
+        ASSERT_NE(map.end(), map.find(reqs[i]));
+        EXPECT_EQ(i, map.find(reqs[i])->second);
+    }
+}
+
+TEST(RequestMap, RandomAgainstUnorderedMap)
+{
+    // Mostly inserts and erases among a few requests, which exercises
+    // the backward shift of the entries displaced past an erased one
+    std::vector<RequestPtr> reqs = makeRequests(200);
+    RequestMap<int> map;
+    std::unordered_map<RequestPtr, int> ref;
+    std::mt19937 rng(1);
+
+    for (unsigned n = 0; n < 200000; n++) {
+        const RequestPtr &req = reqs[rng() % (n < 100000 ? 200 : 40)];
+        switch (rng() % 3) {
+          case 0: {
+              const int value = rng();
+              map[req] = value;
+              ref[req] = value;
+              break;
+          }
+
+          case 1: {
+              auto it = map.find(req);
+              auto ref_it = ref.find(req);
+              ASSERT_EQ(ref_it == ref.end(), it == map.end());
+              if (it != map.end()) {
+                  ASSERT_EQ(ref_it->second, it->second);
+                  map.erase(it);
+                  ref.erase(ref_it);
+              }
+              break;
+          }
+
+          default:
+            map.erase(req);
+            ref.erase(req);
+            break;
+        }
+        ASSERT_EQ(ref.size(), map.size());
+    }
+
+    for (const auto &entry : ref) {
+        ASSERT_NE(map.end(), map.find(entry.first));
+        EXPECT_EQ(entry.second, map.find(entry.first)->second);
+    }
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_COMMON_ARRIVALQUEUE_HH__
+#define __MEM_RUBY_COMMON_ARRIVALQUEUE_HH__
+
+#include <cassert>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * Queue of items kept sorted by arrival, the first to arrive at the
+ * head, in a ring that grows by powers of two. Items mostly arrive in
+ * order, so an item is inserted at the tail, or a few slots before it,
+ * and taken from the head, without reordering a heap or allocating
+ * once the ring has grown to the queue's occupancy. Items arriving
+ * together keep their order of insertion.
+ *
+ * @tparam T Type of the items.
+ * @tparam Later Comparison telling whether an item arrives after
+ *               another one.
+ */
+template <class T, class Later = std::greater<T> >
+class ArrivalQueue
+{
+  public:
+    ArrivalQueue() : m_ring(8), m_head(0), m_size(0) {}
+
+    unsigned int size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    //! The i-th item of the queue, in arrival order.
+    T &
+    operator[](unsigned int i)
+    {
+        return m_ring[(m_head + i) & (m_ring.size() - 1)];
+    }
+
+    const T &
+    operator[](unsigned int i) const
+    {
+        return m_ring[(m_head + i) & (m_ring.size() - 1)];
+    }
+
+    //! The first item to arrive. The queue must not be empty.
+    const T &front() const { return m_ring[m_head]; }
+
+    //! Insert an item according to its arrival.
+    void
+    insert(T item)
+    {
+        if (m_size == m_ring.size()) {
+            // grow the ring, starting it at the first slot
+            std::vector<T> ring(2 * m_ring.size());
+            for (unsigned int i = 0; i < m_size; ++i)
+                ring[i] = std::move((*this)[i]);
+            m_ring.swap(ring);
+            m_head = 0;
+        }
+
+        // search for the slot from the tail, moving the items arriving
+        // later back by one slot
+        unsigned int pos = m_size;
+        while (pos > 0 && m_later((*this)[pos - 1], item)) {
+            (*this)[pos] = std::move((*this)[pos - 1]);
+            --pos;
+        }
+        (*this)[pos] = std::move(item);
+        ++m_size;
+    }
+
+    //! Remove the first item to arrive. The queue must not be empty.
+    T
+    pop()
+    {
+        assert(m_size > 0);
+        T item = std::move(m_ring[m_head]);
+        m_ring[m_head] = T();
+        m_head = (m_head + 1) & (m_ring.size() - 1);
+        --m_size;
+        return item;
+    }
+
+    void
+    clear()
+    {
+        for (unsigned int i = 0; i < m_size; ++i)
+            (*this)[i] = T();
+        m_head = 0;
+        m_size = 0;
+    }
+
+  private:
+    std::vector<T> m_ring;
+    unsigned int m_head;
+    unsigned int m_size;
+    Later m_later;
+};
+
+#endif // __MEM_RUBY_COMMON_ARRIVALQUEUE_HH__
@@ -30,6 +30,28 @@
 
 using namespace std;
 
+Consumer::~Consumer()
+{
+    for (auto evt : m_wakeup_events) {
+        if (evt->scheduled())
+            em->deschedule(evt);
+        delete evt;
+    }
+}
+
+bool
+Consumer::alreadyScheduled(Tick time) const
+{
+    if (time == m_last_wakeup && time == em->clockEdge())
+        return true;
+
+    for (auto evt : m_wakeup_events) {
+        if (evt->scheduled() && evt->when() == time)
+            return true;
+    }
+    return false;
+}
+
 void
 Consumer::scheduleEvent(Cycles timeDelta)
 {
@@ -39,17 +61,25 @@ Consumer::scheduleEvent(Cycles timeDelta)
 void
 Consumer::scheduleEventAbsolute(Tick evt_time)
 {
-    if (!alreadyScheduled(evt_time)) {
-        // This wakeup is not redundant
-        auto *evt = new EventFunctionWrapper(
-            [this]{ wakeup(); }, "Consumer Event", true);
+    if (evt_time == m_last_wakeup && evt_time == em->clockEdge())
+        return;
+
+    // look for a wakeup at the same time, or else for an idle event
+    EventFunctionWrapper *idle = nullptr;
+    for (auto evt : m_wakeup_events) {
+        if (!evt->scheduled())
+            idle = evt;
+        else if (evt->when() == evt_time)
+            return;
+    }
 
-        em->schedule(evt, evt_time);
-        insertScheduledWakeupTime(evt_time);
+    // This wakeup is not redundant
+    if (!idle) {
+        idle = new EventFunctionWrapper(
+            [this]{ m_last_wakeup = curTick(); wakeup(); },
+            "Consumer Event");
+        m_wakeup_events.push_back(idle);
     }
 
-    Tick t = em->clockEdge();
-    set<Tick>::iterator bit = m_scheduled_wakeups.begin();
-    set<Tick>::iterator eit = m_scheduled_wakeups.lower_bound(t);
-    m_scheduled_wakeups.erase(bit,eit);
+    em->schedule(idle, evt_time);
 }
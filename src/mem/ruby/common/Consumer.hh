@@ -36,7 +36,7 @@
 #define __MEM_RUBY_COMMON_CONSUMER_HH__
 
 #include <iostream>
-#include <set>
+#include <vector>
 
 #include "sim/clocked_object.hh"
 
@@ -44,29 +44,17 @@ class Consumer
 {
   public:
     Consumer(ClockedObject *_em)
-        : em(_em)
+        : m_last_wakeup(MaxTick), em(_em)
     {
     }
 
-    virtual
-    ~Consumer()
-    { }
+    virtual ~Consumer();
 
     virtual void wakeup() = 0;
     virtual void print(std::ostream& out) const = 0;
     virtual void storeEventInfo(int info) {}
 
-    bool
-    alreadyScheduled(Tick time)
-    {
-        return m_scheduled_wakeups.find(time) != m_scheduled_wakeups.end();
-    }
-
-    void
-    insertScheduledWakeupTime(Tick time)
-    {
-        m_scheduled_wakeups.insert(time);
-    }
+    bool alreadyScheduled(Tick time) const;
 
     void scheduleEventAbsolute(Tick timeAbs);
 
@@ -74,7 +62,19 @@ class Consumer
     void scheduleEvent(Cycles timeDelta);
 
   private:
-    std::set<Tick> m_scheduled_wakeups;
+    /**
+     * Wakeup events, one per pending wakeup time. They are reused once
+     * processed, so that scheduling a wakeup neither allocates an event
+     * nor records its time in a separate set.
+     */
+    std::vector<EventFunctionWrapper*> m_wakeup_events;
+
+    /**
+     * Time of the last wakeup. Another wakeup at that time is redundant
+     * while it is the current clock edge.
+     */
+    Tick m_last_wakeup;
+
     ClockedObject *em;
 };
 
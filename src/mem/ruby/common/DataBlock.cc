@@ -33,17 +33,16 @@
 
 DataBlock::DataBlock(const DataBlock &cp)
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
+    alloc();
     memcpy(m_data, cp.m_data, RubySystem::getBlockSizeBytes());
-    m_alloc = true;
 }
 
 void
 DataBlock::alloc()
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
-    m_alloc = true;
-    clear();
+    const int size = RubySystem::getBlockSizeBytes();
+    m_alloc = size > INLINE_BLOCK_SIZE_BYTES;
+    m_data = m_alloc ? new uint8_t[size] : m_inline;
 }
 
 void
@@ -37,12 +37,17 @@
 
 class WriteMask;
 
+// Change for systems with cache lines larger than 64 bytes. Blocks of
+// larger lines still work, but take their data from the heap.
+const int INLINE_BLOCK_SIZE_BYTES = 64;
+
 class DataBlock
 {
   public:
     DataBlock()
     {
         alloc();
+        clear();
     }
 
     DataBlock(const DataBlock &cp);
@@ -71,8 +76,15 @@ class DataBlock
 
   private:
     void alloc();
+
+    // Data of the block: m_inline, a heap array if the block is larger
+    // than m_inline, or the storage the block was assigned to.
     uint8_t *m_data;
+    // Whether m_data is a heap array owned by the block
     bool m_alloc;
+    // Storage of the blocks that fit, so that the blocks copied around
+    // in messages do not allocate
+    uint8_t m_inline[INLINE_BLOCK_SIZE_BYTES];
 };
 
 inline void
@@ -30,24 +30,25 @@
 
 #include <algorithm>
 
+#include "base/bitfield.hh"
+
 NetDest::NetDest()
 {
-  resize();
+    clear();
 }
 
 void
 NetDest::add(MachineID newElement)
 {
-    assert(bitIndex(newElement.num) < m_bits[vecIndex(newElement)].getSize());
-    m_bits[vecIndex(newElement)].add(bitIndex(newElement.num));
+    assert(newElement.num < MachineType_base_count(newElement.type));
+    m_bits[wordIndex(newElement)] |= bitMask(newElement);
 }
 
 void
 NetDest::addNetDest(const NetDest& netDest)
 {
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].addSet(netDest.m_bits[i]);
+    for (int i = 0; i < numWords; i++) {
+        m_bits[i] |= netDest.m_bits[i];
     }
 }
 
@@ -57,30 +58,33 @@ NetDest::setNetDest(MachineType machine, const Set& set)
     // assure that there is only one set of destinations for this machine
     assert(MachineType_base_level((MachineType)(machine + 1)) -
            MachineType_base_level(machine) == 1);
-    m_bits[MachineType_base_level(machine)] = set;
+    std::fill_n(&m_bits[machineWord(machine)], wordsPerMachine, 0);
+    for (NodeID j = 0; j < NUMBER_BITS_PER_SET; j++) {
+        if (set.isElement(j)) {
+            MachineID mach = {machine, j};
+            m_bits[wordIndex(mach)] |= bitMask(mach);
+        }
+    }
 }
 
 void
 NetDest::remove(MachineID oldElement)
 {
-    m_bits[vecIndex(oldElement)].remove(bitIndex(oldElement.num));
+    m_bits[wordIndex(oldElement)] &= ~bitMask(oldElement);
 }
 
 void
 NetDest::removeNetDest(const NetDest& netDest)
 {
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].removeSet(netDest.m_bits[i]);
+    for (int i = 0; i < numWords; i++) {
+        m_bits[i] &= ~netDest.m_bits[i];
     }
 }
 
 void
 NetDest::clear()
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].clear();
-    }
+    std::fill_n(m_bits, numWords, 0);
 }
 
 void
@@ -95,9 +99,12 @@ NetDest::broadcast()
 void
 NetDest::broadcast(MachineType machineType)
 {
-    for (NodeID i = 0; i < MachineType_base_count(machineType); i++) {
-        MachineID mach = {machineType, i};
-        add(mach);
+    int count = MachineType_base_count(machineType);
+    assert(count <= NUMBER_BITS_PER_SET);
+    for (int i = machineWord(machineType); count > 0; i++) {
+        m_bits[i] |= count >= bitsPerWord ?
+            ~(uint64_t)0 : ((uint64_t)1 << count) - 1;
+        count -= bitsPerWord;
     }
 }
 
@@ -106,11 +113,16 @@ std::vector<NodeID>
 NetDest::getAllDest()
 {
     std::vector<NodeID> dest;
-    dest.clear();
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                int id = MachineType_base_number((MachineType)i) + j;
+    for (MachineType machine = MachineType_FIRST;
+         machine < MachineType_NUM; ++machine) {
+        const int first = machineWord(machine);
+        int base = -1;
+        for (int i = 0; i < wordsPerMachine; i++) {
+            uint64_t word = m_bits[first + i];
+            if (word && base < 0)
+                base = MachineType_base_number(machine);
+            for (; word; word &= word - 1) {
+                int id = base + i * bitsPerWord + findLsbSet(word);
                 dest.push_back((NodeID)id);
             }
         }
@@ -122,8 +134,8 @@ int
 NetDest::count() const
 {
     int counter = 0;
-    for (int i = 0; i < m_bits.size(); i++) {
-        counter += m_bits[i].count();
+    for (int i = 0; i < numWords; i++) {
+        counter += popCount(m_bits[i]);
     }
     return counter;
 }
@@ -131,19 +143,20 @@ NetDest::count() const
 NodeID
 NetDest::elementAt(MachineID index)
 {
-    return m_bits[vecIndex(index)].elementAt(bitIndex(index.num));
+    return isElement(index);
 }
 
 MachineID
 NetDest::smallestElement() const
 {
-    assert(count() > 0);
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (NodeID j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                MachineID mach = {MachineType_from_base_level(i), j};
-                return mach;
-            }
+    for (int i = 0; i < numWords; i++) {
+        if (m_bits[i]) {
+            MachineType machine =
+                MachineType_from_base_level(i / wordsPerMachine);
+            NodeID num = (i % wordsPerMachine) * bitsPerWord +
+                findLsbSet(m_bits[i]);
+            MachineID mach = {machine, num};
+            return mach;
         }
     }
     panic("No smallest element of an empty set.");
@@ -152,10 +165,11 @@ NetDest::smallestElement() const
 MachineID
 NetDest::smallestElement(MachineType machine) const
 {
-    int size = m_bits[MachineType_base_level(machine)].getSize();
-    for (NodeID j = 0; j < size; j++) {
-        if (m_bits[MachineType_base_level(machine)].isElement(j)) {
-            MachineID mach = {machine, j};
+    const int first = machineWord(machine);
+    for (int i = 0; i < wordsPerMachine; i++) {
+        if (m_bits[first + i]) {
+            NodeID num = i * bitsPerWord + findLsbSet(m_bits[first + i]);
+            MachineID mach = {machine, num};
             return mach;
         }
     }
@@ -167,8 +181,14 @@ NetDest::smallestElement(MachineType machine) const
 bool
 NetDest::isBroadcast() const
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isBroadcast()) {
+    for (MachineType machine = MachineType_FIRST;
+         machine < MachineType_NUM; ++machine) {
+        const int first = machineWord(machine);
+        int count = 0;
+        for (int i = 0; i < wordsPerMachine; i++) {
+            count += popCount(m_bits[first + i]);
+        }
+        if (count != MachineType_base_count(machine)) {
             return false;
         }
     }
@@ -179,8 +199,8 @@ NetDest::isBroadcast() const
 bool
 NetDest::isEmpty() const
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isEmpty()) {
+    for (int i = 0; i < numWords; i++) {
+        if (m_bits[i]) {
             return false;
         }
     }
@@ -191,10 +211,9 @@ NetDest::isEmpty() const
 NetDest
 NetDest::OR(const NetDest& orNetDest) const
 {
-    assert(m_bits.size() == orNetDest.getSize());
     NetDest result;
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].OR(orNetDest.m_bits[i]);
+    for (int i = 0; i < numWords; i++) {
+        result.m_bits[i] = m_bits[i] | orNetDest.m_bits[i];
     }
     return result;
 }
@@ -203,10 +222,9 @@ NetDest::OR(const NetDest& orNetDest) const
 NetDest
 NetDest::AND(const NetDest& andNetDest) const
 {
-    assert(m_bits.size() == andNetDest.getSize());
     NetDest result;
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].AND(andNetDest.m_bits[i]);
+    for (int i = 0; i < numWords; i++) {
+        result.m_bits[i] = m_bits[i] & andNetDest.m_bits[i];
     }
     return result;
 }
@@ -215,9 +233,8 @@ NetDest::AND(const NetDest& andNetDest) const
 bool
 NetDest::intersectionIsNotEmpty(const NetDest& other_netDest) const
 {
-    assert(m_bits.size() == other_netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].intersectionIsEmpty(other_netDest.m_bits[i])) {
+    for (int i = 0; i < numWords; i++) {
+        if (m_bits[i] & other_netDest.m_bits[i]) {
             return true;
         }
     }
@@ -225,12 +242,16 @@ NetDest::intersectionIsNotEmpty(const NetDest& other_netDest) const
 }
 
 bool
-NetDest::isSuperset(const NetDest& test) const
+NetDest::intersectionIsEmpty(const NetDest& other_netDest) const
 {
-    assert(m_bits.size() == test.getSize());
+    return !intersectionIsNotEmpty(other_netDest);
+}
 
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isSuperset(test.m_bits[i])) {
+bool
+NetDest::isSuperset(const NetDest& test) const
+{
+    for (int i = 0; i < numWords; i++) {
+        if (test.m_bits[i] & ~m_bits[i]) {
             return false;
         }
     }
@@ -240,28 +261,19 @@ NetDest::isSuperset(const NetDest& test) const
 bool
 NetDest::isElement(MachineID element) const
 {
-    return ((m_bits[vecIndex(element)])).isElement(bitIndex(element.num));
-}
-
-void
-NetDest::resize()
-{
-    m_bits.resize(MachineType_base_level(MachineType_NUM));
-    assert(m_bits.size() == MachineType_NUM);
-
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].setSize(MachineType_base_count((MachineType)i));
-    }
+    return m_bits[wordIndex(element)] & bitMask(element);
 }
 
 void
 NetDest::print(std::ostream& out) const
 {
-    out << "[NetDest (" << m_bits.size() << ") ";
+    out << "[NetDest (" << getSize() << ") ";
 
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            out << (bool) m_bits[i].isElement(j) << " ";
+    for (MachineType machine = MachineType_FIRST;
+         machine < MachineType_NUM; ++machine) {
+        for (NodeID j = 0; j < MachineType_base_count(machine); j++) {
+            MachineID mach = {machine, j};
+            out << isElement(mach) << " ";
         }
         out << " - ";
     }
@@ -271,10 +283,5 @@ NetDest::print(std::ostream& out) const
 bool
 NetDest::isEqual(const NetDest& n) const
 {
-    assert(m_bits.size() == n.m_bits.size());
-    for (unsigned int i = 0; i < m_bits.size(); ++i) {
-        if (!m_bits[i].isEqual(n.m_bits[i]))
-            return false;
-    }
-    return true;
+    return std::equal(m_bits, m_bits + numWords, n.m_bits);
 }
@@ -29,13 +29,16 @@
 #ifndef __MEM_RUBY_COMMON_NETDEST_HH__
 #define __MEM_RUBY_COMMON_NETDEST_HH__
 
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
 #include "mem/ruby/common/Set.hh"
 #include "mem/ruby/common/MachineID.hh"
 
-// NetDest specifies the network destination of a Message
+// NetDest specifies the network destination of a Message. It is a flat
+// bit vector of NUMBER_BITS_PER_SET bits per machine type, held inline
+// so that the messages copying it around do not allocate.
 class NetDest
 {
   public:
@@ -84,8 +87,7 @@ class NetDest
     MachineID smallestElement() const;
     MachineID smallestElement(MachineType machine) const;
 
-    void resize();
-    int getSize() const { return m_bits.size(); }
+    int getSize() const { return MachineType_NUM; }
 
     // get element for a index
     NodeID elementAt(MachineID index);
@@ -93,19 +95,33 @@ class NetDest
     void print(std::ostream& out) const;
 
   private:
-    // returns a value >= MachineType_base_level("this machine")
-    // and < MachineType_base_level("next highest machine")
+    static const int bitsPerWord = 64;
+    static const int wordsPerMachine =
+        (NUMBER_BITS_PER_SET + bitsPerWord - 1) / bitsPerWord;
+    static const int numWords = MachineType_NUM * wordsPerMachine;
+
+    // returns the first word of the bits of a machine type
     int
-    vecIndex(MachineID m) const
+    machineWord(MachineType type) const
     {
-        int vec_index = MachineType_base_level(m.type);
-        assert(vec_index < m_bits.size());
-        return vec_index;
+        assert(type >= MachineType_FIRST && type < MachineType_NUM);
+        return type * wordsPerMachine;
     }
 
-    NodeID bitIndex(NodeID index) const { return index; }
+    int
+    wordIndex(MachineID m) const
+    {
+        assert(m.num < NUMBER_BITS_PER_SET);
+        return machineWord(m.type) + m.num / bitsPerWord;
+    }
+
+    uint64_t
+    bitMask(MachineID m) const
+    {
+        return (uint64_t)1 << (m.num % bitsPerWord);
+    }
 
-    std::vector<Set> m_bits;  // a vector of bit vectors - i.e. Sets
+    uint64_t m_bits[numWords];
 };
 
 inline std::ostream&
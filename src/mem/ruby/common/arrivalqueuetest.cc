@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/ruby/common/ArrivalQueue.hh"
+
+namespace {
+
+struct TestMsg
+{
+    TestMsg(Tick _time, uint64_t _counter) : time(_time), counter(_counter)
+    {}
+
+    Tick time;
+    uint64_t counter;
+};
+
+typedef std::shared_ptr<TestMsg> TestMsgPtr;
+
+// as Message orders the messages of a MessageBuffer
+bool
+operator>(const TestMsgPtr &lhs, const TestMsgPtr &rhs)
+{
+    if (lhs->time == rhs->time)
+        return lhs->counter > rhs->counter;
+    return lhs->time > rhs->time;
+}
+
+/** The priority heap MessageBuffer used before ArrivalQueue. */
+class Heap
+{
+  public:
+    void
+    push(const TestMsgPtr &msg)
+    {
+        heap.push_back(msg);
+        std::push_heap(heap.begin(), heap.end(), std::greater<TestMsgPtr>());
+    }
+
+    TestMsgPtr
+    pop()
+    {
+        TestMsgPtr msg = heap.front();
+        std::pop_heap(heap.begin(), heap.end(), std::greater<TestMsgPtr>());
+        heap.pop_back();
+        return msg;
+    }
+
+    const TestMsgPtr &front() const { return heap.front(); }
+    size_t size() const { return heap.size(); }
+
+  private:
+    std::vector<TestMsgPtr> heap;
+};
+
+} // anonymous namespace
+
+TEST(ArrivalQueue, InOrder)
+{
+    ArrivalQueue<TestMsgPtr> queue;
+    for (int i = 0; i < 100; i++)
+        queue.insert(std::make_shared<TestMsg>(i, i));
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(100 - i, queue.size());
+        EXPECT_EQ(i, queue.front()->time);
+        EXPECT_EQ(i, queue[0]->time);
+        EXPECT_EQ(i, queue.pop()->time);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(ArrivalQueue, OutOfOrder)
+{
+    ArrivalQueue<TestMsgPtr> queue;
+    queue.insert(std::make_shared<TestMsg>(30, 0));
+    queue.insert(std::make_shared<TestMsg>(10, 1));
+    queue.insert(std::make_shared<TestMsg>(20, 2));
+    queue.insert(std::make_shared<TestMsg>(20, 3));
+    queue.insert(std::make_shared<TestMsg>(10, 0));
+
+    const Tick times[] = { 10, 10, 20, 20, 30 };
+    const uint64_t counters[] = { 0, 1, 2, 3, 0 };
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(times[i], queue[i]->time);
+        EXPECT_EQ(counters[i], queue[i]->counter);
+    }
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+}
+
+/**
+ * Enqueue, dequeue, recycle and reanalyze messages at random, the way
+ * MessageBuffer does, and check that the messages come out in the same
+ * order as from the heap.
+ */
+TEST(ArrivalQueue, MatchesHeap)
+{
+    std::mt19937_64 rng(5);
+    for (int run = 0; run < 50; run++) {
+        ArrivalQueue<TestMsgPtr> queue;
+        Heap heap;
+        Tick now = 0;
+        uint64_t counter = 0;
+        std::vector<TestMsgPtr> stalled;
+
+        for (int step = 0; step < 20000; step++) {
+            const unsigned action = rng() % 16;
+            if (action < 6) {
+                // enqueue, mostly with one of a few fixed latencies, as
+                // the network and the controllers do
+                Tick delay;
+                if (rng() % 8 == 0)
+                    delay = rng() % 5000;
+                else
+                    delay = (1 + rng() % 3) * 500;
+                TestMsgPtr msg = std::make_shared<TestMsg>(now + delay,
+                                                           ++counter);
+                queue.insert(msg);
+                heap.push(msg);
+            } else if (action < 11) {
+                if (heap.size() && heap.front()->time <= now) {
+                    ASSERT_EQ(heap.front(), queue.front());
+                    ASSERT_EQ(heap.pop(), queue.pop());
+                }
+            } else if (action == 11) {
+                // recycle the head, which keeps its counter
+                if (heap.size() && heap.front()->time <= now) {
+                    TestMsgPtr msg = heap.pop();
+                    ASSERT_EQ(msg, queue.pop());
+                    msg->time = now + 1000;
+                    queue.insert(msg);
+                    heap.push(msg);
+                }
+            } else if (action == 12) {
+                // stall the head
+                if (heap.size() && heap.front()->time <= now) {
+                    stalled.push_back(heap.pop());
+                    ASSERT_EQ(stalled.back(), queue.pop());
+                }
+            } else if (action == 13) {
+                // reanalyze the stalled messages, which arrive again now
+                for (auto &msg : stalled) {
+                    msg->time = now;
+                    msg->counter = ++counter;
+                    queue.insert(msg);
+                    heap.push(msg);
+                }
+                stalled.clear();
+            } else {
+                now += 500 * (rng() % 3);
+            }
+
+            ASSERT_EQ(heap.size(), queue.size());
+        }
+
+        while (heap.size())
+            ASSERT_EQ(heap.pop(), queue.pop());
+        EXPECT_TRUE(queue.empty());
+    }
+}
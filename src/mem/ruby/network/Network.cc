@@ -42,6 +42,7 @@
 
 #include "base/logging.hh"
 #include "mem/ruby/common/MachineID.hh"
+#include "mem/ruby/common/Set.hh"
 #include "mem/ruby/network/BasicLink.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
@@ -61,6 +62,16 @@ Network::Network(const Params *p)
     assert(m_nodes != 0);
     assert(m_virtual_networks != 0);
 
+    // NetDest has room for a fixed number of controllers of each type
+    for (MachineType type = MachineType_FIRST; type < MachineType_NUM;
+         ++type) {
+        fatal_if(MachineType_base_count(type) > NUMBER_BITS_PER_SET,
+                 "Number of bits(%d) < number of %s controllers(%d). "
+                 "Increase the number of bits and recompile.\n",
+                 NUMBER_BITS_PER_SET, MachineType_to_string(type),
+                 MachineType_base_count(type));
+    }
+
     m_topology_ptr = new Topology(p->routers.size(), p->ext_links,
                                   p->int_links);
 
@@ -53,6 +53,20 @@ class Credit : public flit
 
     bool is_free_signal() { return m_is_free_signal; }
 
+    // Credits have their own pool, see flit
+    static void *
+    operator new(size_t size)
+    {
+        assert(size == sizeof(Credit));
+        return SlabPool<Credit>::allocate();
+    }
+
+    static void
+    operator delete(void *p)
+    {
+        SlabPool<Credit>::deallocate(p);
+    }
+
   private:
     bool m_is_free_signal;
 };
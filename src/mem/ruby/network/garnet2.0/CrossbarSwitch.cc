@@ -46,6 +46,7 @@ CrossbarSwitch::CrossbarSwitch(Router *router)
     m_router = router;
     m_num_vcs = m_router->get_num_vcs();
     m_crossbar_activity = 0;
+    m_num_switch_flits = 0;
 }
 
 CrossbarSwitch::~CrossbarSwitch()
@@ -74,6 +75,10 @@ CrossbarSwitch::init()
 void
 CrossbarSwitch::wakeup()
 {
+    // nothing won the switch
+    if (m_num_switch_flits == 0)
+        return;
+
     DPRINTF(RubyNetwork, "CrossbarSwitch at Router %d woke up "
             "at time: %lld\n",
             m_router->get_id(), m_router->curCycle());
@@ -94,6 +99,7 @@ CrossbarSwitch::wakeup()
             // in the next cycle
             m_output_unit[outport]->insert_flit(t_flit);
             m_switch_buffer[inport]->getTopFlit();
+            m_num_switch_flits--;
             m_crossbar_activity++;
         }
     }
@@ -53,8 +53,12 @@ class CrossbarSwitch : public Consumer
     void init();
     void print(std::ostream& out) const {};
 
-    inline void update_sw_winner(int inport, flit *t_flit)
-    { m_switch_buffer[inport]->insert(t_flit); }
+    inline void
+    update_sw_winner(int inport, flit *t_flit)
+    {
+        m_switch_buffer[inport]->insert(t_flit);
+        m_num_switch_flits++;
+    }
 
     inline double get_crossbar_activity() { return m_crossbar_activity; }
 
@@ -65,6 +69,8 @@ class CrossbarSwitch : public Consumer
     int m_num_vcs;
     int m_num_inports;
     double m_crossbar_activity;
+    // Number of flits in all the switch buffers
+    int m_num_switch_flits;
     Router *m_router;
     std::vector<flitBuffer *> m_switch_buffer;
     std::vector<OutputUnit *> m_output_unit;
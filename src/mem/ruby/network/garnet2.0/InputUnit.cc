@@ -49,6 +49,7 @@ InputUnit::InputUnit(int id, PortDirection direction, Router *router)
     m_router = router;
     m_num_vcs = m_router->get_num_vcs();
     m_vc_per_vnet = m_router->get_vc_per_vnet();
+    m_num_buffered_flits = 0;
 
     m_num_buffer_reads.resize(m_num_vcs/m_vc_per_vnet);
     m_num_buffer_writes.resize(m_num_vcs/m_vc_per_vnet);
@@ -113,6 +114,7 @@ InputUnit::wakeup()
 
         // Buffer the flit
         m_vcs[vc]->insertFlit(t_flit);
+        m_num_buffered_flits++;
 
         int vnet = vc/m_vc_per_vnet;
         // number of writes same as reads
@@ -109,9 +109,15 @@ class InputUnit : public Consumer
     inline flit*
     getTopFlit(int vc)
     {
+        assert(m_num_buffered_flits > 0);
+        m_num_buffered_flits--;
         return m_vcs[vc]->getTopFlit();
     }
 
+    // Whether any VC holds a flit, so that the allocator can skip the
+    // idle input ports without looking at each of their VCs
+    inline bool has_buffered_flits() { return m_num_buffered_flits > 0; }
+
     inline bool
     need_stage(int vc, flit_stage stage, Cycles time)
     {
@@ -161,6 +167,8 @@ class InputUnit : public Consumer
 
     // Input Virtual channels
     std::vector<VirtualChannel *> m_vcs;
+    // Number of flits in all the VCs
+    int m_num_buffered_flits;
 
     // Statistical variables
     std::vector<double> m_num_buffer_writes;
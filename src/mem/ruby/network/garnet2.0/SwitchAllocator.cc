@@ -48,6 +48,7 @@ SwitchAllocator::SwitchAllocator(Router *router)
 
     m_input_arbiter_activity = 0;
     m_output_arbiter_activity = 0;
+    m_num_requests = 0;
 }
 
 void
@@ -86,6 +87,9 @@ SwitchAllocator::init()
  * There is no separate VCAllocator stage like the one in garnet1.0.
  * At the end of this function, the router is rescheduled to wakeup
  * next cycle for peforming SA for any flits ready next cycle.
+ * Input ports without buffered flits are skipped, and so is the second
+ * stage when no input placed a request, which is what most wakeups of
+ * a router find at low loads.
  */
 
 void
@@ -114,6 +118,9 @@ SwitchAllocator::arbitrate_inports()
     // Select a VC from each input in a round robin manner
     // Independent arbiter at each input port
     for (int inport = 0; inport < m_num_inports; inport++) {
+        if (!m_input_unit[inport]->has_buffered_flits())
+            continue;
+
         int invc = m_round_robin_invc[inport];
 
         for (int invc_iter = 0; invc_iter < m_num_vcs; invc_iter++) {
@@ -135,6 +142,7 @@ SwitchAllocator::arbitrate_inports()
                     m_input_arbiter_activity++;
                     m_port_requests[outport][inport] = true;
                     m_vc_winners[outport][inport]= invc;
+                    m_num_requests++;
 
                     // Update Round Robin pointer
                     m_round_robin_invc[inport]++;
@@ -169,6 +177,9 @@ SwitchAllocator::arbitrate_inports()
 void
 SwitchAllocator::arbitrate_outports()
 {
+    if (m_num_requests == 0)
+        return;
+
     // Now there are a set of input vc requests for output vcs.
     // Again do round robin arbitration on these requests
     // Independent arbiter at each output port
@@ -250,6 +261,7 @@ SwitchAllocator::arbitrate_outports()
 
                 // remove this request
                 m_port_requests[outport][inport] = false;
+                m_num_requests--;
 
                 // Update Round Robin pointer
                 m_round_robin_inport[outport]++;
@@ -358,6 +370,9 @@ SwitchAllocator::check_for_wakeup()
     Cycles nextCycle = m_router->curCycle() + Cycles(1);
 
     for (int i = 0; i < m_num_inports; i++) {
+        if (!m_input_unit[i]->has_buffered_flits())
+            continue;
+
         for (int j = 0; j < m_num_vcs; j++) {
             if (m_input_unit[i]->need_stage(j, SA_, nextCycle)) {
                 m_router->schedule_wakeup(Cycles(1));
@@ -381,6 +396,10 @@ SwitchAllocator::get_vnet(int invc)
 void
 SwitchAllocator::clear_request_vector()
 {
+    if (m_num_requests == 0)
+        return;
+
+    m_num_requests = 0;
     for (int i = 0; i < m_num_outports; i++) {
         for (int j = 0; j < m_num_inports; j++) {
             m_port_requests[i][j] = false;
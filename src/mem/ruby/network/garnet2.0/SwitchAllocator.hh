@@ -78,6 +78,10 @@ class SwitchAllocator : public Consumer
 
     double m_input_arbiter_activity, m_output_arbiter_activity;
 
+    // Number of requests placed by SA-I that are still in
+    // m_port_requests
+    int m_num_requests;
+
     Router *m_router;
     std::vector<int> m_round_robin_invc;
     std::vector<int> m_round_robin_inport;
@@ -37,6 +37,7 @@
 #include <cassert>
 #include <iostream>
 
+#include "base/slab_pool.hh"
 #include "base/types.hh"
 #include "mem/ruby/network/garnet2.0/CommonTypes.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
@@ -99,6 +100,21 @@ class flit
 
     bool functionalWrite(Packet *pkt);
 
+    // Flits are allocated from a pool, as the network interfaces create
+    // and destroy one per flit of every message
+    static void *
+    operator new(size_t size)
+    {
+        assert(size == sizeof(flit));
+        return SlabPool<flit>::allocate();
+    }
+
+    static void
+    operator delete(void *p)
+    {
+        SlabPool<flit>::deallocate(p);
+    }
+
   protected:
     int m_id;
     int m_vnet;
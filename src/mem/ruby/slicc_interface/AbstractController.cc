@@ -55,6 +55,7 @@ AbstractController::AbstractController(const Params *p)
       m_number_of_TBEs(p->number_of_TBEs),
       m_transitions_per_cycle(p->transitions_per_cycle),
       m_buffer_size(p->buffer_size), m_recycle_latency(p->recycle_latency),
+      m_lines_indexed(false),
       memoryPort(csprintf("%s.memory", name()), this, ""),
       addrRanges(p->addr_ranges.begin(), p->addr_ranges.end())
 {
@@ -65,6 +66,12 @@ AbstractController::AbstractController(const Params *p)
     }
 }
 
+LineHolderIndex *
+AbstractController::getLineHolderIndex() const
+{
+    return params()->ruby_system->getLineHolderIndex();
+}
+
 void
 AbstractController::init()
 {
@@ -240,7 +247,7 @@ void
 AbstractController::queueMemoryRead(const MachineID &id, Addr addr,
                                     Cycles latency)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         addr, RubySystem::getBlockSizeBytes(), 0, m_masterId);
 
     PacketPtr pkt = Packet::createRead(req);
@@ -264,7 +271,7 @@ void
 AbstractController::queueMemoryWrite(const MachineID &id, Addr addr,
                                      Cycles latency, const DataBlock &block)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         addr, RubySystem::getBlockSizeBytes(), 0, m_masterId);
 
     PacketPtr pkt = Packet::createWrite(req);
@@ -292,7 +299,7 @@ AbstractController::queueMemoryWritePartial(const MachineID &id, Addr addr,
                                             Cycles latency,
                                             const DataBlock &block, int size)
 {
-    RequestPtr req = std::make_shared<Request>(addr, size, 0, m_masterId);
+    RequestPtr req = Request::create(addr, size, 0, m_masterId);
 
     PacketPtr pkt = Packet::createWrite(req);
     uint8_t *newData = new uint8_t[size];
@@ -62,6 +62,7 @@
 
 class Network;
 class GPUCoalescer;
+class LineHolderIndex;
 
 // used to communicate that an in_port peeked the wrong message type
 class RejectException: public std::exception
@@ -112,6 +113,11 @@ class AbstractController : public MemObject, public Consumer
     virtual int functionalWrite(const Addr &addr, PacketPtr) = 0;
     int functionalMemoryWrite(PacketPtr);
 
+    //! Whether all the per-line state of the controller is in caches and
+    //! TBE tables recording their lines in the line holder index, so that
+    //! the controller can only hold the lines the index lists for it.
+    bool linesIndexed() const { return m_lines_indexed; }
+
     //! Function for enqueuing a prefetch request
     virtual void enqueuePrefetch(const Addr &, const RubyRequestType&)
     { fatal("Prefetches not implemented!");}
@@ -172,6 +178,8 @@ class AbstractController : public MemObject, public Consumer
     void wakeUpAllBuffers(Addr addr);
     void wakeUpAllBuffers();
 
+    LineHolderIndex *getLineHolderIndex() const;
+
   protected:
     const NodeID m_version;
     MachineID m_machineID;
@@ -196,6 +204,9 @@ class AbstractController : public MemObject, public Consumer
     const unsigned int m_buffer_size;
     Cycles m_recycle_latency;
 
+    //! Set by controllers whose lines are all in the line holder index
+    bool m_lines_indexed;
+
     //! Counter for the number of cycles when the transitions carried out
     //! were equal to the maximum allowed
     Stats::Scalar m_fully_busy_cycles;
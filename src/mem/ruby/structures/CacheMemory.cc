@@ -30,6 +30,7 @@
 #include "mem/ruby/structures/CacheMemory.hh"
 
 #include "base/intmath.hh"
+#include "base/tag_match.hh"
 #include "debug/RubyCache.hh"
 #include "debug/RubyCacheTrace.hh"
 #include "debug/RubyResourceStalls.hh"
@@ -69,6 +70,7 @@ CacheMemory::CacheMemory(const Params *p)
     m_is_instruction_only_cache = p->is_icache;
     m_resource_stalls = p->resourceStalls;
     m_block_size = p->block_size;  // may be 0 at this point. Updated in init()
+    m_line_index = nullptr;
 }
 
 void
@@ -84,6 +86,7 @@ CacheMemory::init()
 
     m_cache.resize(m_cache_num_sets,
                     std::vector<AbstractCacheEntry*>(m_cache_assoc, nullptr));
+    m_tags.assign(m_cache_num_sets * m_cache_assoc, invalidTag);
 }
 
 CacheMemory::~CacheMemory()
@@ -97,6 +100,8 @@ CacheMemory::~CacheMemory()
     }
 }
 
+const uint64_t CacheMemory::invalidTag;
+
 // convert a Address to its location in the cache
 int64_t
 CacheMemory::addressToCacheSet(Addr address) const
@@ -111,13 +116,10 @@ CacheMemory::addressToCacheSet(Addr address) const
 int
 CacheMemory::findTagInSet(int64_t cacheSet, Addr tag) const
 {
-    assert(tag == makeLineAddress(tag));
-    // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        if (m_cache[cacheSet][it->second]->m_Permission !=
-            AccessPermission_NotPresent)
-            return it->second;
+    int loc = findTagInSetIgnorePermissions(cacheSet, tag);
+    if (loc != -1 &&
+        m_cache[cacheSet][loc]->m_Permission != AccessPermission_NotPresent)
+        return loc;
     return -1; // Not found
 }
 
@@ -129,9 +131,9 @@ CacheMemory::findTagInSetIgnorePermissions(int64_t cacheSet,
 {
     assert(tag == makeLineAddress(tag));
     // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        return it->second;
+    int loc = findTag(&m_tags[cacheSet * m_cache_assoc], m_cache_assoc, tag);
+    if (loc != m_cache_assoc)
+        return loc;
     return -1; // Not found
 }
 
@@ -263,6 +265,10 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry, bool touch)
     std::vector<AbstractCacheEntry*> &set = m_cache[cacheSet];
     for (int i = 0; i < m_cache_assoc; i++) {
         if (!set[i] || set[i]->m_Permission == AccessPermission_NotPresent) {
+            if (set[i]) {
+                // the entry is reused for another line
+                removeFromLineIndex(set[i]->m_Address);
+            }
             if (set[i] && (set[i] != entry)) {
                 warn_once("This protocol contains a cache entry handling bug: "
                     "Entries in the cache should never be NotPresent! If\n"
@@ -276,7 +282,8 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry, bool touch)
             DPRINTF(RubyCache, "Allocate clearing lock for addr: %x\n",
                     address);
             set[i]->m_locked = -1;
-            m_tag_index[address] = i;
+            m_tags[cacheSet * m_cache_assoc + i] = address;
+            addToLineIndex(address);
             entry->setSetIndex(cacheSet);
             entry->setWayIndex(i);
 
@@ -301,10 +308,33 @@ CacheMemory::deallocate(Addr address)
     if (loc != -1) {
         delete m_cache[cacheSet][loc];
         m_cache[cacheSet][loc] = NULL;
-        m_tag_index.erase(address);
+        m_tags[cacheSet * m_cache_assoc + loc] = invalidTag;
+        removeFromLineIndex(address);
     }
 }
 
+void
+CacheMemory::addLineHolder(LineHolderIndex *index, AbstractController *cntrl)
+{
+    assert(!m_line_index || m_line_index == index);
+    m_line_index = index;
+    m_line_holders.push_back(cntrl);
+}
+
+void
+CacheMemory::addToLineIndex(Addr address)
+{
+    for (auto cntrl : m_line_holders)
+        m_line_index->add(address, cntrl);
+}
+
+void
+CacheMemory::removeFromLineIndex(Addr address)
+{
+    for (auto cntrl : m_line_holders)
+        m_line_index->remove(address, cntrl);
+}
+
 // Returns with the physical address of the conflicting cache line
 Addr
 CacheMemory::cacheProbe(Addr address) const
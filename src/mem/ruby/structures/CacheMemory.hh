@@ -31,7 +31,6 @@
 #define __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "base/statistics.hh"
@@ -43,6 +42,7 @@
 #include "mem/ruby/slicc_interface/RubySlicc_ComponentMapping.hh"
 #include "mem/ruby/structures/AbstractReplacementPolicy.hh"
 #include "mem/ruby/structures/BankedArray.hh"
+#include "mem/ruby/structures/LineHolderIndex.hh"
 #include "mem/ruby/system/CacheRecorder.hh"
 #include "params/RubyCache.hh"
 #include "sim/sim_object.hh"
@@ -73,6 +73,11 @@ class CacheMemory : public SimObject
     //   b) an unused line in the same cache "way"
     bool cacheAvail(Addr address) const;
 
+    // record the lines allocated in the cache in the index, as held by
+    // the controller. A cache shared by several controllers lists its
+    // lines under each of them.
+    void addLineHolder(LineHolderIndex *index, AbstractController *cntrl);
+
     // find an unused entry and sets the tag appropriate for the address
     AbstractCacheEntry* allocate(Addr address,
                                  AbstractCacheEntry* new_entry, bool touch);
@@ -160,6 +165,9 @@ class CacheMemory : public SimObject
     int findTagInSet(int64_t line, Addr tag) const;
     int findTagInSetIgnorePermissions(int64_t cacheSet, Addr tag) const;
 
+    void addToLineIndex(Addr address);
+    void removeFromLineIndex(Addr address);
+
     // Private copy constructor and assignment operator
     CacheMemory(const CacheMemory& obj);
     CacheMemory& operator=(const CacheMemory& obj);
@@ -170,9 +178,13 @@ class CacheMemory : public SimObject
 
     // The first index is the # of cache lines.
     // The second index is the the amount associativity.
-    std::unordered_map<Addr, int> m_tag_index;
     std::vector<std::vector<AbstractCacheEntry*> > m_cache;
 
+    // Line address held by each way, set after set, so that a lookup
+    // compares a whole set at once. Empty ways hold invalidTag.
+    std::vector<uint64_t> m_tags;
+    static const uint64_t invalidTag = ~uint64_t(0);
+
     AbstractReplacementPolicy *m_replacementPolicy_ptr;
 
     BankedArray dataArray;
@@ -185,6 +197,11 @@ class CacheMemory : public SimObject
     int m_start_index_bit;
     bool m_resource_stalls;
     int m_block_size;
+
+    // Index the lines of the cache are recorded in, if any, and the
+    // controllers they are recorded as held by
+    LineHolderIndex *m_line_index;
+    std::vector<AbstractController *> m_line_holders;
 };
 
 std::ostream& operator<<(std::ostream& out, const CacheMemory& obj);
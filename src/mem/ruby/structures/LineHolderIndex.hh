@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_STRUCTURES_LINEHOLDERINDEX_HH__
+#define __MEM_RUBY_STRUCTURES_LINEHOLDERINDEX_HH__
+
+#include <unordered_map>
+#include <utility>
+
+#include "base/types.hh"
+
+class AbstractController;
+
+/**
+ * Index of the controllers holding each line in one of their caches or
+ * TBE tables, maintained by those structures as they allocate and free
+ * entries. A controller is listed once per structure holding the line.
+ * RubySystem uses it to only ask the controllers holding a line for its
+ * permission on a functional access, instead of all of them.
+ */
+class LineHolderIndex
+{
+  public:
+    typedef std::unordered_multimap<Addr, AbstractController *> Map;
+    typedef std::pair<Map::const_iterator, Map::const_iterator> Range;
+
+    void add(Addr line, AbstractController *cntrl);
+    void remove(Addr line, AbstractController *cntrl);
+
+    /** The controllers holding a line. */
+    Range holders(Addr line) const { return m_holders.equal_range(line); }
+
+  private:
+    Map m_holders;
+};
+
+#endif // __MEM_RUBY_STRUCTURES_LINEHOLDERINDEX_HH__
@@ -33,16 +33,27 @@
 #include <unordered_map>
 
 #include "mem/ruby/common/Address.hh"
+#include "mem/ruby/structures/LineHolderIndex.hh"
 
 template<class ENTRY>
 class TBETable
 {
   public:
     TBETable(int number_of_TBEs)
-        : m_number_of_TBEs(number_of_TBEs)
+        : m_line_index(nullptr), m_line_holder(nullptr),
+          m_number_of_TBEs(number_of_TBEs)
     {
     }
 
+    // record the lines with a TBE in the index, as held by the controller
+    void
+    addLineHolder(LineHolderIndex *index, AbstractController *cntrl)
+    {
+        assert(!m_line_index);
+        m_line_index = index;
+        m_line_holder = cntrl;
+    }
+
     bool isPresent(Addr address) const;
     void allocate(Addr address);
     void deallocate(Addr address);
@@ -65,6 +76,9 @@ class TBETable
     // Data Members (m_prefix)
     std::unordered_map<Addr, ENTRY> m_map;
 
+    LineHolderIndex *m_line_index;
+    AbstractController *m_line_holder;
+
   private:
     int m_number_of_TBEs;
 };
@@ -94,6 +108,8 @@ TBETable<ENTRY>::allocate(Addr address)
     assert(!isPresent(address));
     assert(m_map.size() < m_number_of_TBEs);
     m_map[address] = ENTRY();
+    if (m_line_index)
+        m_line_index->add(address, m_line_holder);
 }
 
 template<class ENTRY>
@@ -103,6 +119,8 @@ TBETable<ENTRY>::deallocate(Addr address)
     assert(isPresent(address));
     assert(m_map.size() > 0);
     m_map.erase(address);
+    if (m_line_index)
+        m_line_index->remove(address, m_line_holder);
 }
 
 // looks an address up in the cache
@@ -31,6 +31,7 @@
 #include <fcntl.h>
 #include <zlib.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <list>
 
@@ -87,6 +88,8 @@ void
 RubySystem::registerAbstractController(AbstractController* cntrl)
 {
     m_abs_cntrl_vec.push_back(cntrl);
+    if (!cntrl->linesIndexed())
+        m_unindexed_cntrl_vec.push_back(cntrl);
 
     MachineID id = cntrl->getMachineID();
     m_abstract_controls[id.getType()][id.getNum()] = cntrl;
@@ -395,6 +398,25 @@ RubySystem::resetStats()
     m_start_cycle = curCycle();
 }
 
+const std::vector<AbstractController *> &
+RubySystem::lineHolders(Addr line_addr)
+{
+    m_line_holders = m_unindexed_cntrl_vec;
+
+    auto range = m_line_holder_index.holders(line_addr);
+    for (auto it = range.first; it != range.second; ++it) {
+        // A controller holding the line in several of its caches and TBE
+        // tables is listed once per structure
+        auto indexed = m_line_holders.begin() + m_unindexed_cntrl_vec.size();
+        if (std::find(indexed, m_line_holders.end(), it->second) ==
+            m_line_holders.end()) {
+            m_line_holders.push_back(it->second);
+        }
+    }
+
+    return m_line_holders;
+}
+
 bool
 RubySystem::functionalRead(PacketPtr pkt)
 {
@@ -402,7 +424,10 @@ RubySystem::functionalRead(PacketPtr pkt)
     Addr line_address = makeLineAddress(address);
 
     AccessPermission access_perm = AccessPermission_NotPresent;
-    int num_controllers = m_abs_cntrl_vec.size();
+    // Only the controllers that may hold the line are asked about it
+    const std::vector<AbstractController *> &cntrls =
+        lineHolders(line_address);
+    int num_controllers = cntrls.size();
 
     DPRINTF(RubySystem, "Functional Read request for %#x\n", address);
 
@@ -415,7 +440,7 @@ RubySystem::functionalRead(PacketPtr pkt)
     // In this loop we count the number of controllers that have the given
     // address in read only, read write and busy states.
     for (unsigned int i = 0; i < num_controllers; ++i) {
-        access_perm = m_abs_cntrl_vec[i]-> getAccessPermission(line_address);
+        access_perm = cntrls[i]->getAccessPermission(line_address);
         if (access_perm == AccessPermission_Read_Only)
             num_ro++;
         else if (access_perm == AccessPermission_Read_Write)
@@ -445,9 +470,9 @@ RubySystem::functionalRead(PacketPtr pkt)
     if (num_invalid == (num_controllers - 1) && num_backing_store == 1) {
         DPRINTF(RubySystem, "only copy in Backing_Store memory, read from it\n");
         for (unsigned int i = 0; i < num_controllers; ++i) {
-            access_perm = m_abs_cntrl_vec[i]->getAccessPermission(line_address);
+            access_perm = cntrls[i]->getAccessPermission(line_address);
             if (access_perm == AccessPermission_Backing_Store) {
-                m_abs_cntrl_vec[i]->functionalRead(line_address, pkt);
+                cntrls[i]->functionalRead(line_address, pkt);
                 return true;
             }
         }
@@ -462,10 +487,10 @@ RubySystem::functionalRead(PacketPtr pkt)
         // a read write copy of the given address. Any valid copy would suffice
         // for a functional read.
         for (unsigned int i = 0;i < num_controllers;++i) {
-            access_perm = m_abs_cntrl_vec[i]->getAccessPermission(line_address);
+            access_perm = cntrls[i]->getAccessPermission(line_address);
             if (access_perm == AccessPermission_Read_Only ||
                 access_perm == AccessPermission_Read_Write) {
-                m_abs_cntrl_vec[i]->functionalRead(line_address, pkt);
+                cntrls[i]->functionalRead(line_address, pkt);
                 return true;
             }
         }
@@ -484,21 +509,22 @@ RubySystem::functionalWrite(PacketPtr pkt)
     Addr addr(pkt->getAddr());
     Addr line_addr = makeLineAddress(addr);
     AccessPermission access_perm = AccessPermission_NotPresent;
-    int num_controllers = m_abs_cntrl_vec.size();
 
     DPRINTF(RubySystem, "Functional Write request for %#x\n", addr);
 
     uint32_t M5_VAR_USED num_functional_writes = 0;
 
-    for (unsigned int i = 0; i < num_controllers;++i) {
-        num_functional_writes +=
-            m_abs_cntrl_vec[i]->functionalWriteBuffers(pkt);
+    // Messages for the line can be in the buffers of any controller
+    for (auto cntrl : m_abs_cntrl_vec) {
+        num_functional_writes += cntrl->functionalWriteBuffers(pkt);
+    }
 
-        access_perm = m_abs_cntrl_vec[i]->getAccessPermission(line_addr);
+    // but only the controllers holding the line have a copy of it
+    for (auto cntrl : lineHolders(line_addr)) {
+        access_perm = cntrl->getAccessPermission(line_addr);
         if (access_perm != AccessPermission_Invalid &&
             access_perm != AccessPermission_NotPresent) {
-            num_functional_writes +=
-                m_abs_cntrl_vec[i]->functionalWrite(line_addr, pkt);
+            num_functional_writes += cntrl->functionalWrite(line_addr, pkt);
         }
     }
 
@@ -40,6 +40,7 @@
 #include "mem/packet.hh"
 #include "mem/ruby/profiler/Profiler.hh"
 #include "mem/ruby/slicc_interface/AbstractController.hh"
+#include "mem/ruby/structures/LineHolderIndex.hh"
 #include "mem/ruby/system/CacheRecorder.hh"
 #include "params/RubySystem.hh"
 #include "sim/clocked_object.hh"
@@ -93,6 +94,8 @@ class RubySystem : public ClockedObject
     void registerNetwork(Network*);
     void registerAbstractController(AbstractController*);
 
+    LineHolderIndex *getLineHolderIndex() { return &m_line_holder_index; }
+
     bool eventQueueEmpty() { return eventq->empty(); }
     void enqueueRubyEvent(Tick tick)
     {
@@ -117,6 +120,11 @@ class RubySystem : public ClockedObject
                                      uint64_t uncompressed_trace_size);
 
     void processRubyEvent();
+
+    // Controllers that may hold a line: those the line holder index lists
+    // for it, once each, and those whose lines are not indexed
+    const std::vector<AbstractController *> &lineHolders(Addr line_addr);
+
   private:
     // configuration parameters
     static bool m_randomization;
@@ -132,6 +140,10 @@ class RubySystem : public ClockedObject
 
     Network* m_network;
     std::vector<AbstractController *> m_abs_cntrl_vec;
+    std::vector<AbstractController *> m_unindexed_cntrl_vec;
+    LineHolderIndex m_line_holder_index;
+    // Result of lineHolders, kept to reuse its storage
+    std::vector<AbstractController *> m_line_holders;
     Cycles m_start_cycle;
 
   public:
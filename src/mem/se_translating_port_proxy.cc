@@ -44,6 +44,8 @@
 
 #include "mem/se_translating_port_proxy.hh"
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 
 #include "arch/isa_traits.hh"
@@ -67,18 +69,29 @@ SETranslatingPortProxy::~SETranslatingPortProxy()
 bool
 SETranslatingPortProxy::tryReadBlob(Addr addr, uint8_t *p, int size) const
 {
-    int prevSize = 0;
+    // Pages mapped to consecutive physical pages are read at once
+    Addr run_paddr = 0;
+    int run_size = 0;
 
     for (ChunkGenerator gen(addr, size, PageBytes); !gen.done(); gen.next()) {
         Addr paddr;
 
-        if (!pTable->translate(gen.addr(),paddr))
+        if (!pTable->translate(gen.addr(),paddr)) {
+            PortProxy::readBlobPhys(run_paddr, 0, p, run_size);
             return false;
+        }
 
-        PortProxy::readBlobPhys(paddr, 0, p + prevSize, gen.size());
-        prevSize += gen.size();
+        if (run_size && paddr != run_paddr + run_size) {
+            PortProxy::readBlobPhys(run_paddr, 0, p, run_size);
+            p += run_size;
+            run_size = 0;
+        }
+        if (!run_size)
+            run_paddr = paddr;
+        run_size += gen.size();
     }
 
+    PortProxy::readBlobPhys(run_paddr, 0, p, run_size);
     return true;
 }
 
@@ -94,7 +107,9 @@ bool
 SETranslatingPortProxy::tryWriteBlob(Addr addr, const uint8_t *p,
                                      int size) const
 {
-    int prevSize = 0;
+    // Pages mapped to consecutive physical pages are written at once
+    Addr run_paddr = 0;
+    int run_size = 0;
 
     for (ChunkGenerator gen(addr, size, PageBytes); !gen.done(); gen.next()) {
         Addr paddr;
@@ -109,15 +124,23 @@ SETranslatingPortProxy::tryWriteBlob(Addr addr, const uint8_t *p,
                     panic("Page table fault when accessing virtual address %#x "
                             "during functional write\n", gen.addr());
             } else {
+                PortProxy::writeBlobPhys(run_paddr, 0, p, run_size);
                 return false;
             }
             pTable->translate(gen.addr(), paddr);
         }
 
-        PortProxy::writeBlobPhys(paddr, 0, p + prevSize, gen.size());
-        prevSize += gen.size();
+        if (run_size && paddr != run_paddr + run_size) {
+            PortProxy::writeBlobPhys(run_paddr, 0, p, run_size);
+            p += run_size;
+            run_size = 0;
+        }
+        if (!run_size)
+            run_paddr = paddr;
+        run_size += gen.size();
     }
 
+    PortProxy::writeBlobPhys(run_paddr, 0, p, run_size);
     return true;
 }
 
@@ -132,6 +155,10 @@ SETranslatingPortProxy::writeBlob(Addr addr, const uint8_t *p, int size) const
 bool
 SETranslatingPortProxy::tryMemsetBlob(Addr addr, uint8_t val, int size) const
 {
+    // Pages mapped to consecutive physical pages are set at once
+    Addr run_paddr = 0;
+    int run_size = 0;
+
     for (ChunkGenerator gen(addr, size, PageBytes); !gen.done(); gen.next()) {
         Addr paddr;
 
@@ -141,13 +168,21 @@ SETranslatingPortProxy::tryMemsetBlob(Addr addr, uint8_t val, int size) const
                                      PageBytes);
                 pTable->translate(gen.addr(), paddr);
             } else {
+                PortProxy::memsetBlobPhys(run_paddr, 0, val, run_size);
                 return false;
             }
         }
 
-        PortProxy::memsetBlobPhys(paddr, 0, val, gen.size());
+        if (run_size && paddr != run_paddr + run_size) {
+            PortProxy::memsetBlobPhys(run_paddr, 0, val, run_size);
+            run_size = 0;
+        }
+        if (!run_size)
+            run_paddr = paddr;
+        run_size += gen.size();
     }
 
+    PortProxy::memsetBlobPhys(run_paddr, 0, val, run_size);
     return true;
 }
 
@@ -162,19 +197,19 @@ SETranslatingPortProxy::memsetBlob(Addr addr, uint8_t val, int size) const
 bool
 SETranslatingPortProxy::tryWriteString(Addr addr, const char *str) const
 {
-    uint8_t c;
+    // Write a page at a time, the terminating null included
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(str);
+    const int size = std::strlen(str) + 1;
 
-    Addr vaddr = addr;
-
-    do {
-        c = *str++;
+    for (ChunkGenerator gen(addr, size, PageBytes); !gen.done(); gen.next()) {
         Addr paddr;
 
-        if (!pTable->translate(vaddr++, paddr))
+        if (!pTable->translate(gen.addr(), paddr))
             return false;
 
-        PortProxy::writeBlob(paddr, &c, 1);
-    } while (c);
+        PortProxy::writeBlobPhys(paddr, 0, p, gen.size());
+        p += gen.size();
+    }
 
     return true;
 }
@@ -189,21 +224,31 @@ SETranslatingPortProxy::writeString(Addr addr, const char *str) const
 bool
 SETranslatingPortProxy::tryReadString(std::string &str, Addr addr) const
 {
-    uint8_t c;
+    // Read a chunk at a time, not crossing pages, until the null
+    const Addr chunk_size = 64;
+    uint8_t chunk[chunk_size];
 
     Addr vaddr = addr;
 
     while (true) {
         Addr paddr;
 
-        if (!pTable->translate(vaddr++, paddr))
+        if (!pTable->translate(vaddr, paddr))
             return false;
 
-        PortProxy::readBlob(paddr, &c, 1);
-        if (c == '\0')
+        const Addr size =
+            std::min(chunk_size, PageBytes - (vaddr & (PageBytes - 1)));
+        PortProxy::readBlobPhys(paddr, 0, chunk, size);
+
+        const void *end = std::memchr(chunk, '\0', size);
+        if (end) {
+            str.append(reinterpret_cast<const char *>(chunk),
+                       static_cast<const uint8_t *>(end) - chunk);
             break;
+        }
 
-        str += c;
+        str.append(reinterpret_cast<const char *>(chunk), size);
+        vaddr += size;
     }
 
     return true;
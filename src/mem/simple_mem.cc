@@ -282,6 +282,14 @@ SimpleMemory::MemoryPort::recvFunctional(PacketPtr pkt)
     memory.recvFunctional(pkt);
 }
 
+MemBackdoorPtr
+SimpleMemory::MemoryPort::recvBackdoorReq(Addr addr, bool write)
+{
+    // timing requests access the backing store on arrival, so it is
+    // always up to date
+    return memory.getBackdoor();
+}
+
 bool
 SimpleMemory::MemoryPort::recvTimingReq(PacketPtr pkt)
 {
@@ -99,6 +99,8 @@ class SimpleMemory : public AbstractMemory
 
         void recvFunctional(PacketPtr pkt);
 
+        MemBackdoorPtr recvBackdoorReq(Addr addr, bool write);
+
         bool recvTimingReq(PacketPtr pkt);
 
         void recvRespRetry();
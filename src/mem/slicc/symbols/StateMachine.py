@@ -164,6 +164,24 @@ class StateMachine(Symbol):
                                "single machine.");
                 self.EntryType = type
 
+    # Whether all the per-line state of the machine is in caches and TBE
+    # tables, which record the lines they hold in the line holder index of
+    # the RubySystem. Functional accesses only ask the machines the index
+    # lists for a line about it, and all the others.
+    def linesIndexed(self):
+        indexed_types = ("CacheMemory", "TBETable")
+        stateless_types = ("Sequencer", "DMASequencer", "GPUCoalescer",
+                           "VIPERCoalescer", "Prefetcher", "TimerTable",
+                           "WireBuffer")
+        types = [ param.type_ast.type for param in self.config_parameters ]
+        types += [ var.type for var in self.objects ]
+        for type in types:
+            if "primitive" in type or type.isEnumeration or "buffer" in type:
+                continue
+            if type.ident not in indexed_types + stateless_types:
+                return False
+        return True
+
     # Needs to be called before accessing the table
     def buildTable(self):
         assert self.table is None
@@ -660,6 +678,19 @@ $c_ident::init()
                 event = "%s_Event_%s" % (self.ident, trans.event.ident)
                 code('possibleTransition($state, $event);')
 
+        # Record the lines held by the caches and TBE tables
+        if self.linesIndexed():
+            code()
+            code('m_lines_indexed = true;')
+            for param in self.config_parameters:
+                if param.type_ast.type.ident == "CacheMemory":
+                    code('m_${{param.ident}}_ptr->addLineHolder('
+                         'getLineHolderIndex(), this);')
+            for var in self.objects:
+                if var.type.ident == "TBETable":
+                    code('m_${{var.ident}}_ptr->addLineHolder('
+                         'getLineHolderIndex(), this);')
+
         code.dedent()
         code('''
     AbstractController::init();
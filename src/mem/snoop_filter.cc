@@ -44,20 +44,156 @@
 
 #include "mem/snoop_filter.hh"
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/SnoopFilter.hh"
 #include "sim/system.hh"
 
+const Addr SnoopFilter::invalidAddr;
+
+SnoopFilter::SnoopFilter(const SnoopFilterParams *p) :
+    SimObject(p), assoc(p->assoc), setMask(0), setShift(0), usedWays(0),
+    useCount(0), reqLookupResult(nullptr), reqLookupAddr(0),
+    retryItem{0, 0}, evictedAddr(invalidAddr), evictedHolders(0),
+    linesize(p->system->cacheLineSize()), lookupLatency(p->lookup_latency),
+    maxEntryCount(p->max_capacity / p->system->cacheLineSize())
+{
+    if (bounded()) {
+        const unsigned num_sets = maxEntryCount / assoc;
+        fatal_if(num_sets == 0 || num_sets * assoc != maxEntryCount ||
+                 !isPowerOf2(num_sets),
+                 "%s: %d entries do not make a power of two number of "
+                 "sets of %d entries\n", name(), maxEntryCount, assoc);
+
+        ways.resize(maxEntryCount, SnoopWay{invalidAddr, 0, SnoopItem()});
+        setMask = num_sets - 1;
+        setShift = floorLog2(linesize);
+    }
+}
+
+SnoopFilter::SnoopItem*
+SnoopFilter::findEntry(Addr line_addr)
+{
+    tableLookups++;
+
+    if (!bounded()) {
+        // a hash lookup counts as a single probe; walking the bucket to
+        // count its entries would cost more than the lookup itself
+        tableProbes++;
+        auto sf_it = cachedLocations.find(line_addr);
+        return sf_it != cachedLocations.end() ? &sf_it->second : nullptr;
+    }
+
+    SnoopWay* set = &ways[((line_addr >> setShift) & setMask) * assoc];
+    for (unsigned i = 0; i < assoc; i++) {
+        if (set[i].lineAddr == line_addr) {
+            tableProbes += i + 1;
+            set[i].lastUse = ++useCount;
+            return &set[i].item;
+        }
+    }
+    tableProbes += assoc;
+    return nullptr;
+}
+
+SnoopFilter::SnoopItem*
+SnoopFilter::allocateEntry(Addr line_addr)
+{
+    if (!bounded())
+        return &cachedLocations.emplace(line_addr, SnoopItem()).first->second;
+
+    // use a free entry if there is one, and otherwise evict the least
+    // recently used line that has no outstanding requests, as their
+    // responses still have to find the entry
+    SnoopWay* set = &ways[((line_addr >> setShift) & setMask) * assoc];
+    SnoopWay* victim = nullptr;
+    for (unsigned i = 0; i < assoc; i++) {
+        if (set[i].lineAddr == invalidAddr) {
+            victim = &set[i];
+            break;
+        }
+        if (!set[i].item.requested &&
+            (!victim || set[i].lastUse < victim->lastUse)) {
+            victim = &set[i];
+        }
+    }
+
+    panic_if(!victim, "%s: all lines in the set of %#x have outstanding "
+             "requests, increase the snoop filter associativity\n",
+             name(), line_addr);
+
+    if (victim->lineAddr == invalidAddr) {
+        usedWays++;
+    } else {
+        // the previous eviction has to be dealt with by now
+        assert(evictedAddr == invalidAddr);
+        evictedAddr = victim->lineAddr;
+        evictedHolders = victim->item.holder;
+        evictions++;
+        DPRINTF(SnoopFilter, "%s:   Evicted SF entry %#x value %x.%x\n",
+                __func__, victim->lineAddr, victim->item.requested,
+                victim->item.holder);
+    }
+
+    victim->lineAddr = line_addr;
+    victim->lastUse = ++useCount;
+    victim->item = SnoopItem();
+    return &victim->item;
+}
+
 void
-SnoopFilter::eraseIfNullEntry(SnoopFilterCache::iterator& sf_it)
+SnoopFilter::eraseIfNullEntry(Addr line_addr, SnoopItem* sf_item)
 {
-    SnoopItem& sf_item = sf_it->second;
-    if (!(sf_item.requested | sf_item.holder)) {
-        cachedLocations.erase(sf_it);
-        DPRINTF(SnoopFilter, "%s:   Removed SF entry.\n",
-                __func__);
+    if (sf_item->requested | sf_item->holder)
+        return;
+
+    if (!bounded()) {
+        cachedLocations.erase(line_addr);
+    } else {
+        SnoopWay* set = &ways[((line_addr >> setShift) & setMask) * assoc];
+        for (unsigned i = 0; i < assoc; i++) {
+            if (&set[i].item == sf_item) {
+                set[i].lineAddr = invalidAddr;
+                usedWays--;
+                break;
+            }
+        }
     }
+    DPRINTF(SnoopFilter, "%s:   Removed SF entry.\n",
+            __func__);
+}
+
+size_t
+SnoopFilter::numEntries() const
+{
+    return bounded() ? usedWays : cachedLocations.size();
+}
+
+double
+SnoopFilter::hostMemory() const
+{
+    if (bounded())
+        return ways.capacity() * sizeof(SnoopWay);
+
+    // every entry of the hash map is a node of its own, linked from
+    // the previous node of its bucket
+    return cachedLocations.size() *
+        (sizeof(SnoopFilterCache::value_type) + sizeof(void*)) +
+        cachedLocations.bucket_count() * sizeof(void*);
+}
+
+bool
+SnoopFilter::takeEviction(Addr& addr, bool& is_secure, SnoopList& holders)
+{
+    if (evictedAddr == invalidAddr)
+        return false;
+
+    addr = evictedAddr & ~Addr(LineSecure);
+    is_secure = evictedAddr & LineSecure;
+    holders = maskToPortList(evictedHolders);
+    evictedAddr = invalidAddr;
+    return true;
 }
 
 std::pair<SnoopFilter::SnoopList, Cycles>
@@ -74,8 +210,9 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const SlavePort& slave_port)
         line_addr |= LineSecure;
     }
     SnoopMask req_port = portToMask(slave_port);
-    reqLookupResult = cachedLocations.find(line_addr);
-    bool is_hit = (reqLookupResult != cachedLocations.end());
+    reqLookupAddr = line_addr;
+    reqLookupResult = findEntry(line_addr);
+    bool is_hit = (reqLookupResult != nullptr);
 
     // If the snoop filter has no entry, and we should not allocate,
     // do not create a new snoop filter entry, simply return a NULL
@@ -85,8 +222,8 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const SlavePort& slave_port)
 
     // If no hit in snoop filter create a new element and update iterator
     if (!is_hit)
-        reqLookupResult = cachedLocations.emplace(line_addr, SnoopItem()).first;
-    SnoopItem& sf_item = reqLookupResult->second;
+        reqLookupResult = allocateEntry(line_addr);
+    SnoopItem& sf_item = *reqLookupResult;
     SnoopMask interested = sf_item.holder | sf_item.requested;
 
     // Store unmodified value of snoop filter item in temp storage in
@@ -152,25 +289,25 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const SlavePort& slave_port)
 void
 SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
 {
-    if (reqLookupResult != cachedLocations.end()) {
+    if (reqLookupResult) {
         // since we rely on the caller, do a basic check to ensure
         // that finishRequest is being called following lookupRequest
         Addr line_addr = (addr & ~(Addr(linesize - 1)));
         if (is_secure) {
             line_addr |= LineSecure;
         }
-        assert(reqLookupResult->first == line_addr);
+        assert(reqLookupAddr == line_addr);
         if (will_retry) {
             // Undo any changes made in lookupRequest to the snoop filter
             // entry if the request will come again. retryItem holds
             // the previous value of the snoopfilter entry.
-            reqLookupResult->second = retryItem;
+            *reqLookupResult = retryItem;
 
             DPRINTF(SnoopFilter, "%s:   restored SF value %x.%x\n",
                     __func__,  retryItem.requested, retryItem.holder);
         }
 
-        eraseIfNullEntry(reqLookupResult);
+        eraseIfNullEntry(reqLookupAddr, reqLookupResult);
     }
 }
 
@@ -185,10 +322,12 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = (sf_it != cachedLocations.end());
+    SnoopItem* sf_it = findEntry(line_addr);
+    bool is_hit = (sf_it != nullptr);
 
-    panic_if(!is_hit && (cachedLocations.size() >= maxEntryCount),
+    // a bounded filter evicts lines to stay within its capacity
+    panic_if(!is_hit && !bounded() &&
+             (cachedLocations.size() >= maxEntryCount),
              "snoop filter exceeded capacity of %d cache blocks\n",
              maxEntryCount);
 
@@ -198,7 +337,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (!is_hit)
         return snoopDown(lookupLatency);
 
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = *sf_it;
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__, sf_item.requested, sf_item.holder);
@@ -229,9 +368,9 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
         sf_item.holder = 0;
     }
 
-    eraseIfNullEntry(sf_it);
     DPRINTF(SnoopFilter, "%s:   new SF value %x.%x interest: %x \n",
             __func__, sf_item.requested, sf_item.holder, interested);
+    eraseIfNullEntry(line_addr, sf_it);
 
     return snoopSelected(maskToPortList(interested), lookupLatency);
 }
@@ -260,7 +399,9 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
     }
     SnoopMask rsp_mask = portToMask(rsp_port);
     SnoopMask req_mask = portToMask(req_port);
-    SnoopItem& sf_item = cachedLocations[line_addr];
+    SnoopItem* sf_it = findEntry(line_addr);
+    panic_if(!sf_it, "No SF entry for the line of the snoop response\n");
+    SnoopItem& sf_item = *sf_it;
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -306,14 +447,14 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = sf_it != cachedLocations.end();
+    SnoopItem* sf_it = findEntry(line_addr);
+    bool is_hit = sf_it != nullptr;
 
     // Nothing to do if it is not a hit
     if (!is_hit)
         return;
 
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = *sf_it;
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -326,7 +467,7 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     }
     DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
             __func__, sf_item.requested, sf_item.holder);
-    eraseIfNullEntry(sf_it);
+    eraseIfNullEntry(line_addr, sf_it);
 
 }
 
@@ -348,12 +489,12 @@ SnoopFilter::updateResponse(const Packet* cpkt, const SlavePort& slave_port)
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    if (sf_it == cachedLocations.end())
+    SnoopItem* sf_it = findEntry(line_addr);
+    if (!sf_it)
         return;
 
     SnoopMask slave_mask = portToMask(slave_port);
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = *sf_it;
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -371,7 +512,7 @@ SnoopFilter::updateResponse(const Packet* cpkt, const SlavePort& slave_port)
         if (cpkt->isInvalidate()) {
             sf_item.holder &= ~slave_mask;
         }
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(line_addr, sf_it);
     } else {
         // Any other response implies that a cache above will have the
         // block.
@@ -414,6 +555,36 @@ SnoopFilter::regStats()
         .name(name() + ".hit_multi_snoops")
         .desc("Number of snoops hitting in the snoop filter with multiple "\
               "(>1) holders of the requested data.");
+
+    tableLookups
+        .name(name() + ".table_lookups")
+        .desc("Number of line lookups in the snoop filter entries.");
+
+    tableProbes
+        .name(name() + ".table_probes")
+        .desc("Number of entries compared by the line lookups (one per "
+              "lookup when unbounded).");
+
+    avgTableProbes
+        .name(name() + ".avg_table_probes")
+        .desc("Average number of entries compared per line lookup.")
+        .precision(2);
+    avgTableProbes = tableProbes / tableLookups;
+
+    evictions
+        .name(name() + ".evictions")
+        .desc("Number of lines evicted by a bounded snoop filter, and "\
+              "invalidated in the caches above.");
+
+    trackedLines
+        .method(this, &SnoopFilter::numEntries)
+        .name(name() + ".tracked_lines")
+        .desc("Number of lines currently tracked.");
+
+    hostBytes
+        .method(this, &SnoopFilter::hostMemory)
+        .name(name() + ".host_bytes")
+        .desc("Estimated host memory used by the snoop filter entries.");
 }
 
 SnoopFilter *
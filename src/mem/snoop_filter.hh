@@ -47,6 +47,7 @@
 
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "mem/packet.hh"
 #include "mem/port.hh"
@@ -83,17 +84,20 @@
  *     upper cache dropped a line, making the snoop filter pessimistic for now
  * (4) ordering: there is no single point of order in the system.  Instead,
  *     requesting MSHRs track order between local requests and remote snoops
+ *
+ * By default the filter is unbounded, and keeps its entries in a hash
+ * map. With a non-zero associativity it instead models an inclusive
+ * directory of max_capacity bytes, organised in sets of assoc entries
+ * stored in a single array. Allocating an entry in a full set evicts
+ * the least recently used entry without outstanding requests, and the
+ * crossbar then invalidates the copies of the evicted line in the
+ * caches above (see takeEviction).
  */
 class SnoopFilter : public SimObject {
   public:
     typedef std::vector<QueuedSlavePort*> SnoopList;
 
-    SnoopFilter (const SnoopFilterParams *p) :
-        SimObject(p), reqLookupResult(cachedLocations.end()), retryItem{0, 0},
-        linesize(p->system->cacheLineSize()), lookupLatency(p->lookup_latency),
-        maxEntryCount(p->max_capacity / p->system->cacheLineSize())
-    {
-    }
+    SnoopFilter (const SnoopFilterParams *p);
 
     /**
      * Init a new snoop filter and tell it about all the slave ports
@@ -192,6 +196,19 @@ class SnoopFilter : public SimObject {
      */
     void updateResponse(const Packet *cpkt, const SlavePort& slave_port);
 
+    /**
+     * Get the line a bounded snoop filter evicted to make room for the
+     * last request passed to lookupRequest, if any. The copies of the
+     * line in the caches above have to be invalidated, as the filter
+     * no longer tracks them.
+     *
+     * @param addr      Address of the evicted line.
+     * @param is_secure Whether the line is in the secure address space.
+     * @param holders   Ports that may hold the line.
+     * @return Whether a line was evicted.
+     */
+    bool takeEviction(Addr& addr, bool& is_secure, SnoopList& holders);
+
     virtual void regStats();
 
   protected:
@@ -220,6 +237,17 @@ class SnoopFilter : public SimObject {
      */
     typedef std::unordered_map<Addr, SnoopItem> SnoopFilterCache;
 
+    /**
+     * Entry of a bounded snoop filter.
+     */
+    struct SnoopWay {
+        /** Line address, or invalidAddr for an unused entry. */
+        Addr lineAddr;
+        /** Value of useCount when the entry was last looked up. */
+        uint64_t lastUse;
+        SnoopItem item;
+    };
+
     /**
      * Simple factory methods for standard return values.
      */
@@ -253,24 +281,63 @@ class SnoopFilter : public SimObject {
 
   private:
 
+    /** Whether the filter has a bounded, set-associative organisation. */
+    bool bounded() const { return assoc != 0; }
+
+    /**
+     * Find the item of a line.
+     * @return The item, or nullptr if the line is not tracked.
+     */
+    SnoopItem* findEntry(Addr line_addr);
+
+    /**
+     * Add an item for a line that is not tracked, evicting another
+     * line if the filter is bounded and the set of the line is full.
+     */
+    SnoopItem* allocateEntry(Addr line_addr);
+
     /**
      * Removes snoop filter items which have no requesters and no holders.
      */
-    void eraseIfNullEntry(SnoopFilterCache::iterator& sf_it);
+    void eraseIfNullEntry(Addr line_addr, SnoopItem* sf_item);
+
+    /** Current number of tracked lines. */
+    size_t numEntries() const;
+
+    /** Host memory used by the tracking structures, in bytes. */
+    double hostMemory() const;
 
-    /** Simple hash set of cached addresses. */
+    /** Simple hash set of cached addresses, for an unbounded filter. */
     SnoopFilterCache cachedLocations;
+    /** Entries of a bounded filter, assoc consecutive ones per set. */
+    std::vector<SnoopWay> ways;
+    /** Associativity of a bounded filter, 0 for an unbounded one. */
+    const unsigned assoc;
+    /** Mask and shift selecting the set of a line in a bounded filter. */
+    Addr setMask;
+    unsigned setShift;
+    /** Number of used entries of a bounded filter. */
+    size_t usedWays;
+    /** Lookup counter providing the LRU order of the entries. */
+    uint64_t useCount;
+    /** Line address of unused entries. */
+    static const Addr invalidAddr = MaxAddr;
+
     /**
-     * Iterator used to store the result from lookupRequest until we
-     * call finishRequest.
+     * Item and line address used to store the result from
+     * lookupRequest until we call finishRequest.
      */
-    SnoopFilterCache::iterator reqLookupResult;
+    SnoopItem* reqLookupResult;
+    Addr reqLookupAddr;
     /**
      * Variable to temporarily store value of snoopfilter entry
      * incase finishRequest needs to undo changes made in lookupRequest
      * (because of crossbar retry)
      */
     SnoopItem retryItem;
+    /** Line evicted by the last lookupRequest, and its holders. */
+    Addr evictedAddr;
+    SnoopMask evictedHolders;
     /** List of all attached snooping slave ports. */
     SnoopList slavePorts;
     /** Track the mapping from port ids to the local mask ids. */
@@ -298,6 +365,13 @@ class SnoopFilter : public SimObject {
     Stats::Scalar totSnoops;
     Stats::Scalar hitSingleSnoops;
     Stats::Scalar hitMultiSnoops;
+
+    Stats::Scalar tableLookups;
+    Stats::Scalar tableProbes;
+    Stats::Formula avgTableProbes;
+    Stats::Scalar evictions;
+    Stats::Value trackedLines;
+    Stats::Value hostBytes;
 };
 
 inline SnoopFilter::SnoopMask
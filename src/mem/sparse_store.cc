@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/sparse_store.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+using namespace std;
+
+namespace SparseStore {
+
+namespace {
+
+const char magic[8] = { 'g', 'e', 'm', '5', 'p', 'm', 'e', 'm' };
+const uint32_t version = 1;
+
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t pageSize;
+    uint64_t size;
+};
+
+/** Pages compressed by a thread before the main thread writes them. */
+const uint64_t batchPages = 1024;
+
+unsigned
+numThreads(unsigned threads)
+{
+    if (threads == 0)
+        threads = thread::hardware_concurrency();
+    return max(threads, 1U);
+}
+
+/**
+ * Split [begin, end) in one contiguous chunk per thread, and call
+ * f(first, last, thread) for each chunk in parallel.
+ */
+template <class F>
+void
+forEachChunk(uint64_t begin, uint64_t end, unsigned threads, F f)
+{
+    const uint64_t chunk = divCeil(end - begin, threads);
+    vector<thread> workers;
+    for (unsigned t = 1; t < threads && begin + t * chunk < end; t++) {
+        workers.emplace_back(f, begin + t * chunk,
+                             min(begin + (t + 1) * chunk, end), t);
+    }
+    f(begin, min(begin + chunk, end), 0);
+    for (auto &worker : workers)
+        worker.join();
+}
+
+bool
+isZero(const uint8_t *data, uint64_t bytes)
+{
+    uint64_t word;
+    uint64_t i = 0;
+    for (; i + sizeof(word) <= bytes; i += sizeof(word)) {
+        memcpy(&word, data + i, sizeof(word));
+        if (word)
+            return false;
+    }
+    for (; i < bytes; i++) {
+        if (data[i])
+            return false;
+    }
+    return true;
+}
+
+uint64_t
+pageBytes(uint64_t page, uint64_t page_size, uint64_t size)
+{
+    return min(page_size, size - page * page_size);
+}
+
+} // anonymous namespace
+
+void
+write(const string &path, const uint8_t *pmem, uint64_t size,
+      bool compress, unsigned threads)
+{
+    ofstream file(path, ios::out | ios::binary | ios::trunc);
+    if (!file)
+        fatal("Can't open physical memory checkpoint file '%s'\n", path);
+
+    const uint64_t pages = divCeil(size, pageSize);
+    vector<uint32_t> lengths(pages, 0);
+
+    Header header;
+    memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.pageSize = pageSize;
+    header.size = size;
+
+    // The lengths are only known once the pages are compressed, leave
+    // room for them and fill them in at the end
+    const uint64_t lengths_bytes = pages * sizeof(uint32_t);
+    const uint64_t data_start =
+        roundUp(sizeof(header) + lengths_bytes, (uint64_t)pageSize);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    // write the padding, so that the file is complete even when there
+    // is no data after it
+    const vector<char> padding(data_start - sizeof(header), 0);
+    file.write(padding.data(), padding.size());
+
+    threads = numThreads(threads);
+    vector<vector<uint8_t>> buffers(threads);
+
+    auto encode = [&](uint64_t first, uint64_t last, unsigned t) {
+        vector<uint8_t> &buffer = buffers[t];
+        buffer.clear();
+        for (uint64_t page = first; page < last; page++) {
+            const uint8_t *src = pmem + page * pageSize;
+            const uint64_t bytes = pageBytes(page, pageSize, size);
+            if (isZero(src, bytes))
+                continue;
+
+            const size_t offset = buffer.size();
+            if (compress) {
+                uLongf dest_len = compressBound(bytes);
+                buffer.resize(offset + dest_len);
+                if (compress2(&buffer[offset], &dest_len, src, bytes,
+                              Z_BEST_SPEED) == Z_OK && dest_len < bytes) {
+                    buffer.resize(offset + dest_len);
+                    lengths[page] = dest_len;
+                    continue;
+                }
+                buffer.resize(offset);
+            }
+
+            // incompressible pages are stored raw
+            buffer.insert(buffer.end(), src, src + bytes);
+            lengths[page] = bytes;
+        }
+    };
+
+    for (uint64_t batch = 0; batch < pages; batch += threads * batchPages) {
+        forEachChunk(batch, min(batch + threads * batchPages, pages),
+                     threads, encode);
+        for (const auto &buffer : buffers) {
+            file.write(reinterpret_cast<const char *>(buffer.data()),
+                       buffer.size());
+        }
+    }
+
+    file.seekp(sizeof(header));
+    file.write(reinterpret_cast<const char *>(lengths.data()), lengths_bytes);
+    file.close();
+    if (!file)
+        fatal("Write failed on physical memory checkpoint file '%s'\n", path);
+}
+
+uint64_t
+read(const string &path, uint8_t *pmem, uint64_t size, bool lazy,
+     unsigned threads)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        fatal("Can't open physical memory checkpoint file '%s'\n", path);
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(Header))
+        fatal("Physical memory checkpoint file '%s' is truncated\n", path);
+
+    const uint64_t file_size = st.st_size;
+    const uint8_t *file_data = (const uint8_t *)mmap(NULL, file_size,
+                                                     PROT_READ, MAP_PRIVATE,
+                                                     fd, 0);
+    if (file_data == (const uint8_t *)MAP_FAILED)
+        fatal("Could not mmap physical memory checkpoint file '%s'\n", path);
+
+    Header header;
+    memcpy(&header, file_data, sizeof(header));
+    if (memcmp(header.magic, magic, sizeof(magic)) != 0 ||
+        header.version != version || !isPowerOf2(header.pageSize)) {
+        fatal("'%s' is not a sparse physical memory checkpoint file\n",
+              path);
+    }
+    if (header.size != size)
+        fatal("Memory range size has changed! Saw %lld, expected %lld\n",
+              header.size, size);
+
+    const uint64_t page_size = header.pageSize;
+    const uint64_t pages = divCeil(size, page_size);
+    const uint64_t data_start =
+        roundUp(sizeof(header) + pages * sizeof(uint32_t), page_size);
+    if (sizeof(header) + pages * sizeof(uint32_t) > file_size)
+        fatal("Physical memory checkpoint file '%s' is truncated\n", path);
+
+    vector<uint32_t> lengths(pages);
+    memcpy(lengths.data(), file_data + sizeof(header),
+           pages * sizeof(uint32_t));
+
+    vector<uint64_t> offsets(pages);
+    uint64_t offset = data_start;
+    for (uint64_t page = 0; page < pages; page++) {
+        if (lengths[page] > pageBytes(page, page_size, size))
+            fatal("Corrupt physical memory checkpoint file '%s'\n", path);
+        offsets[page] = offset;
+        offset += lengths[page];
+    }
+    // files of memories that were all zero used to end with the
+    // lengths, without padding
+    if (offset > data_start && offset > file_size)
+        fatal("Physical memory checkpoint file '%s' is truncated\n", path);
+
+    uint64_t mapped_pages = 0;
+    const uint64_t host_page_size = sysconf(_SC_PAGESIZE);
+    if (lazy && page_size % host_page_size == 0) {
+        auto mappable = [&](uint64_t p) {
+            return lengths[p] == page_size &&
+                offsets[p] % host_page_size == 0;
+        };
+
+        // Map each run of whole raw pages at once. Consecutive raw
+        // pages are also consecutive in the file.
+        uint64_t page = 0;
+        while (page < pages) {
+            if (!mappable(page)) {
+                page++;
+                continue;
+            }
+
+            const uint64_t first = page;
+            while (page < pages && mappable(page))
+                page++;
+
+            const uint64_t bytes = (page - first) * page_size;
+            void *addr = mmap(pmem + first * page_size, bytes,
+                              PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_FIXED, fd, offsets[first]);
+            if (addr == MAP_FAILED)
+                fatal("Could not mmap physical memory checkpoint file "
+                      "'%s'\n", path);
+
+            fill(lengths.begin() + first, lengths.begin() + page, 0);
+            mapped_pages += page - first;
+        }
+    } else if (lazy) {
+        warn("Page size %d of '%s' is not a multiple of the host page "
+             "size, reading it all\n", page_size, path);
+    }
+
+    atomic<bool> corrupt(false);
+    auto decode = [&](uint64_t first, uint64_t last, unsigned t) {
+        for (uint64_t page = first; page < last; page++) {
+            if (lengths[page] == 0)
+                continue;
+
+            uint8_t *dest = pmem + page * page_size;
+            const uint8_t *src = file_data + offsets[page];
+            const uint64_t bytes = pageBytes(page, page_size, size);
+            if (lengths[page] == bytes) {
+                memcpy(dest, src, bytes);
+                continue;
+            }
+
+            uLongf dest_len = bytes;
+            if (uncompress(dest, &dest_len, src, lengths[page]) != Z_OK ||
+                dest_len != bytes) {
+                corrupt = true;
+            }
+        }
+    };
+    forEachChunk(0, pages, numThreads(threads), decode);
+
+    if (corrupt)
+        fatal("Corrupt physical memory checkpoint file '%s'\n", path);
+
+    // The pages mapped over the memory keep the file referenced
+    munmap(const_cast<uint8_t *>(file_data), file_size);
+    close(fd);
+
+    return mapped_pages;
+}
+
+} // namespace SparseStore
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_SPARSE_STORE_HH__
+#define __MEM_SPARSE_STORE_HH__
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @file
+ * Sparse checkpoint files of a backing store of the physical memory.
+ *
+ * The memory is cut into pages that are stored independently. Zero
+ * pages take no space, and the other pages are either deflated or kept
+ * raw. A file starts with a header and the stored length of each page,
+ * followed by the data of the non-zero pages in address order:
+ *
+ *   char     magic[8]        "gem5pmem"
+ *   uint32_t version
+ *   uint32_t page_size
+ *   uint64_t size            bytes of memory, the last page may be partial
+ *   uint32_t lengths[pages]  0: zero page, page bytes: raw, else deflated
+ *   padding up to page_size
+ *   data
+ *
+ * Values are in host byte order, like the rest of a checkpoint.
+ */
+
+namespace SparseStore {
+
+/** Size of the pages of the files written. */
+const uint32_t pageSize = 4096;
+
+/**
+ * Write a memory to a sparse file.
+ *
+ * @param path File to write.
+ * @param pmem Host pointer to the memory.
+ * @param size Bytes of memory.
+ * @param compress Deflate the non-zero pages. Pages are otherwise all
+ *                 stored raw and aligned in the file, so that restoring
+ *                 them can be lazy.
+ * @param threads Host threads compressing pages, 0 for one per core.
+ */
+void write(const std::string &path, const uint8_t *pmem, uint64_t size,
+           bool compress, unsigned threads);
+
+/**
+ * Read a memory from a sparse file. The memory must be zero, as the
+ * zero pages are left untouched.
+ *
+ * @param path File to read.
+ * @param pmem Host pointer to the memory, which must be page aligned.
+ * @param size Bytes of memory, which must be those of the file.
+ * @param lazy Map the raw pages of the file copy-on-write over the
+ *             memory instead of copying them, so that they are only
+ *             read from the file when first touched. The file must then
+ *             not change until the end of the simulation.
+ * @param threads Host threads decompressing pages, 0 for one per core.
+ * @return Pages mapped from the file rather than read.
+ */
+uint64_t read(const std::string &path, uint8_t *pmem, uint64_t size,
+              bool lazy, unsigned threads);
+
+} // namespace SparseStore
+
+#endif // __MEM_SPARSE_STORE_HH__
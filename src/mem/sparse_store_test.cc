@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mem/sparse_store.hh"
+
+namespace {
+
+/** Zeroed, page aligned memory, as the backing store of a memory. */
+class Memory
+{
+  public:
+    Memory(uint64_t _size) : size(_size)
+    {
+        data = (uint8_t *)mmap(NULL, size, PROT_READ | PROT_WRITE,
+                               MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+        EXPECT_NE(MAP_FAILED, (void *)data);
+    }
+
+    ~Memory() { munmap(data, size); }
+
+    uint8_t *data;
+    const uint64_t size;
+};
+
+/** Temporary file, removed when done. */
+class TempFile
+{
+  public:
+    TempFile()
+    {
+        char name[] = "/tmp/sparse_store_test.XXXXXX";
+        int fd = mkstemp(name);
+        EXPECT_LE(0, fd);
+        close(fd);
+        path = name;
+    }
+
+    ~TempFile() { unlink(path.c_str()); }
+
+    std::string path;
+};
+
+const uint64_t pageSize = SparseStore::pageSize;
+
+/**
+ * Fill a memory with, page by page: random data, zeros, a repeated
+ * pattern that deflates well, zeros again, and then random pages up to
+ * the last one, which may be partial and may be left zero.
+ */
+void
+fill(Memory &mem, bool zero_last)
+{
+    std::mt19937_64 rng(mem.size);
+    const uint64_t pages = (mem.size + pageSize - 1) / pageSize;
+    for (uint64_t page = 0; page < pages; page++) {
+        uint8_t *data = mem.data + page * pageSize;
+        const uint64_t bytes = std::min(pageSize, mem.size - page * pageSize);
+        if (page == 1 || page == 3 || (zero_last && page == pages - 1))
+            continue;
+        for (uint64_t i = 0; i < bytes; i++)
+            data[i] = page == 2 ? i % 7 : rng();
+    }
+}
+
+/** Write a memory, and check that reading it back restores it. */
+uint64_t
+roundTrip(uint64_t size, bool zero_last, bool compress, bool lazy,
+          unsigned threads)
+{
+    Memory mem(size);
+    fill(mem, zero_last);
+    TempFile file;
+    SparseStore::write(file.path, mem.data, size, compress, threads);
+
+    Memory restored(size);
+    const uint64_t mapped = SparseStore::read(file.path, restored.data,
+                                              size, lazy, threads);
+    EXPECT_EQ(0, memcmp(mem.data, restored.data, size));
+
+    // the memory is a copy: writing to it does not change the file
+    memset(restored.data, 0x5a, size);
+    Memory again(size);
+    SparseStore::read(file.path, again.data, size, false, threads);
+    EXPECT_EQ(0, memcmp(mem.data, again.data, size));
+
+    return mapped;
+}
+
+} // anonymous namespace
+
+TEST(SparseStore, Deflated)
+{
+    for (unsigned threads : { 1, 3 }) {
+        EXPECT_EQ(0, roundTrip(8 * pageSize, false, true, false, threads));
+        EXPECT_EQ(0, roundTrip(8 * pageSize + 100, false, true, false,
+                               threads));
+        EXPECT_EQ(0, roundTrip(8 * pageSize + 100, true, true, false,
+                               threads));
+    }
+}
+
+TEST(SparseStore, Raw)
+{
+    for (unsigned threads : { 1, 3 }) {
+        EXPECT_EQ(0, roundTrip(8 * pageSize, false, false, false, threads));
+        EXPECT_EQ(0, roundTrip(8 * pageSize + 100, false, false, false,
+                               threads));
+        EXPECT_EQ(0, roundTrip(8 * pageSize + 100, true, false, false,
+                               threads));
+    }
+}
+
+TEST(SparseStore, LazyMmap)
+{
+    // the zero pages are left alone, and a partial last page is read
+    const bool mappable = pageSize % sysconf(_SC_PAGESIZE) == 0;
+    for (unsigned threads : { 1, 3 }) {
+        EXPECT_EQ(mappable ? 6 : 0,
+                  roundTrip(8 * pageSize, false, false, true, threads));
+        EXPECT_EQ(mappable ? 6 : 0,
+                  roundTrip(8 * pageSize + 100, false, false, true,
+                            threads));
+        EXPECT_EQ(mappable ? 6 : 0,
+                  roundTrip(8 * pageSize + 100, true, false, true,
+                            threads));
+    }
+}
+
+TEST(SparseStore, AllZero)
+{
+    // zero pages take no space
+    const uint64_t size = 64 * pageSize + 100;
+    for (bool compress : { false, true }) {
+        Memory mem(size);
+        TempFile file;
+        SparseStore::write(file.path, mem.data, size, compress, 1);
+
+        struct stat st;
+        ASSERT_EQ(0, stat(file.path.c_str(), &st));
+        EXPECT_EQ(pageSize, st.st_size);
+
+        Memory restored(size);
+        EXPECT_EQ(0, SparseStore::read(file.path, restored.data, size, true,
+                                       1));
+        EXPECT_EQ(0, memcmp(mem.data, restored.data, size));
+    }
+}
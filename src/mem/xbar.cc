@@ -49,6 +49,8 @@
 
 #include "mem/xbar.hh"
 
+#include <algorithm>
+
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
@@ -65,7 +67,9 @@ BaseXBar::BaseXBar(const BaseXBarParams *p)
                           p->port_master_connection_count, false),
       gotAllAddrRanges(false), defaultPortID(InvalidPortID),
       useDefaultRange(p->use_default_range)
-{}
+{
+    decodeCache.resize(decodeCacheSize, DecodeEntry{MaxAddr, InvalidPortID});
+}
 
 BaseXBar::~BaseXBar()
 {
@@ -327,9 +331,26 @@ BaseXBar::findPort(AddrRange addr_range)
     // ranges of all connected slave modules
     assert(gotAllAddrRanges);
 
+    // Check the decode cache, for accesses within a page
+    const Addr page = addr_range.start() >> decodePageShift;
+    const bool one_page = page == addr_range.end() >> decodePageShift;
+    DecodeEntry& entry = decodeCache[page & (decodeCacheSize - 1)];
+    if (one_page && entry.page == page) {
+        decodeCacheHits++;
+        return entry.port;
+    }
+    decodeCacheMisses++;
+
     // Check the address map interval tree
     auto i = portMap.contains(addr_range);
     if (i != portMap.end()) {
+        // remember the page if all of it goes to this port
+        if (one_page &&
+            RangeSize(page << decodePageShift, 1ULL << decodePageShift)
+            .isSubset(i->first)) {
+            entry.page = page;
+            entry.port = i->second;
+        }
         return i->second;
     }
 
@@ -363,6 +384,10 @@ BaseXBar::recvRangeChange(PortID master_port_id)
     // connected slave module
     gotAddrRanges[master_port_id] = true;
 
+    // the decoded pages may now go elsewhere
+    std::fill(decodeCache.begin(), decodeCache.end(),
+              DecodeEntry{MaxAddr, InvalidPortID});
+
     // update the global flag
     if (!gotAllAddrRanges) {
         // take a logical AND of all the ports and see if we got
@@ -577,6 +602,22 @@ BaseXBar::regStats()
             pktSize.ysubname(j, masterPorts[j]->getSlavePort().name());
         }
     }
+
+    decodeCacheHits
+        .name(name() + ".decode_cache_hits")
+        .desc("Port lookups served by the decode cache");
+
+    decodeCacheMisses
+        .name(name() + ".decode_cache_misses")
+        .desc("Port lookups that missed in the decode cache");
+
+    decodeCacheHitRate
+        .name(name() + ".decode_cache_hit_rate")
+        .desc("Fraction of port lookups served by the decode cache")
+        .flags(nozero | nonan);
+
+    decodeCacheHitRate =
+        decodeCacheHits / (decodeCacheHits + decodeCacheMisses);
 }
 
 template <typename SrcType, typename DstType>
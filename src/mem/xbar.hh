@@ -52,12 +52,13 @@
 #define __MEM_XBAR_HH__
 
 #include <deque>
-#include <unordered_map>
+#include <vector>
 
 #include "base/addr_range_map.hh"
 #include "base/types.hh"
 #include "mem/mem_object.hh"
 #include "mem/qport.hh"
+#include "mem/request_map.hh"
 #include "params/BaseXBar.hh"
 #include "sim/stats.hh"
 
@@ -321,13 +322,35 @@ class BaseXBar : public MemObject
 
     AddrRangeMap<PortID, 3> portMap;
 
+    /** A page and the port it decodes to, see decodeCache. */
+    struct DecodeEntry
+    {
+        Addr page;
+        PortID port;
+    };
+
+    /** Number of entries of the decode cache, a power of two. */
+    static const unsigned decodeCacheSize = 256;
+
+    /** Size of the pages of the decode cache, as a shift. */
+    static const unsigned decodePageShift = 12;
+
+    /**
+     * Direct-mapped cache of the port that recently accessed pages
+     * decode to, looked up before the port map. Only pages entirely
+     * within the range of a port (and thus not interleaved at a finer
+     * granularity) are cached, so an access within such a page can
+     * only go to that port. It is flushed on any range change.
+     */
+    std::vector<DecodeEntry> decodeCache;
+
     /**
      * Remember where request packets came from so that we can route
      * responses to the appropriate port. This relies on the fact that
      * the underlying Request pointer inside the Packet stays
      * constant.
      */
-    std::unordered_map<RequestPtr, PortID> routeTo;
+    RequestMap<PortID> routeTo;
 
     /** all contigous ranges seen by this crossbar */
     AddrRangeList xbarRanges;
@@ -406,6 +429,11 @@ class BaseXBar : public MemObject
     Stats::Vector2d pktCount;
     Stats::Vector2d pktSize;
 
+    /** Port lookups served by the decode cache, and the others. */
+    Stats::Scalar decodeCacheHits;
+    Stats::Scalar decodeCacheMisses;
+    Stats::Formula decodeCacheHitRate;
+
   public:
 
     virtual ~BaseXBar();
@@ -100,6 +100,10 @@ def parse_options():
         help="Reduce verbosity")
     option('-v', "--verbose", action="count", default=0,
         help="Increase verbosity")
+    option("--eventq-backend", metavar="{list,wheel}",
+        choices=["list", "wheel"], default="list",
+        help="Data structure ordering the main event queues " \
+        "[Default: %default]")
 
     # Statistics options
     group("Statistics Options")
@@ -133,6 +137,13 @@ def parse_options():
         help="End debug output at TICK")
     option("--debug-file", metavar="FILE", default="cout",
         help="Sets the output file for debug [Default: %default]")
+    option("--debug-format", metavar="FORMAT", default="text",
+        choices=["text", "binary"],
+        help="Format of the debug output, binary traces are rendered by "
+             "util/trace_render [Default: %default]")
+    option("--debug-ring", metavar="N", type='int', default=0,
+        help="Only keep the last N debug records of each thread, and write "
+             "them when gem5 exits or crashes (binary format only)")
     option("--debug-ignore", metavar="EXPR", action='append', split=':',
         help="Ignore EXPR sim objects")
     option("--remote-gdb-port", type='int', default=7000,
@@ -220,6 +231,7 @@ def main(*args):
         fatal("Tracing is not enabled.  Compile with TRACING_ON")
 
     # Set the main event queue for the main thread.
+    event.setEventQueueBackend(options.eventq_backend)
     event.mainq = event.getEventQueue(0)
     event.setEventQueue(event.mainq)
 
@@ -397,7 +409,14 @@ def main(*args):
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    if options.debug_format == "binary":
+        if options.debug_file in ("cout", "cerr", "stdout", "stderr"):
+            fatal("Binary debug output needs a --debug-file")
+        trace.binaryOutput(options.debug_file, options.debug_ring)
+    else:
+        if options.debug_ring:
+            fatal("--debug-ring needs --debug-format=binary")
+        trace.output(options.debug_file)
 
     for ignore in options.debug_ignore:
         check_tracing()
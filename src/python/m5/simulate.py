@@ -218,6 +218,18 @@ def memInvalidate(root):
     for obj in root.descendants():
         obj.memInvalidate()
 
+# Format of the checkpoint files written by checkpoint()
+_checkpoint_format = 'ini'
+
+def setCheckpointFormat(format):
+    """Select the format of the m5.cpt files of the checkpoints written
+    from now on: 'ini' text, or 'binary' (see src/sim/binary_checkpoint.hh
+    and util/cpt_binary.py). Both formats can be restored."""
+    global _checkpoint_format
+    if format not in ('ini', 'binary'):
+        raise ValueError("Unknown checkpoint format '%s'" % format)
+    _checkpoint_format = format
+
 def checkpoint(dir):
     root = objects.Root.getInstance()
     if not isinstance(root, objects.Root):
@@ -226,7 +238,7 @@ def checkpoint(dir):
     drain()
     memWriteback(root)
     print("Writing checkpoint")
-    _m5.core.serializeAll(dir)
+    _m5.core.serializeAll(dir, _checkpoint_format == 'binary')
 
 def _changeMemoryMode(system, mode):
     if not isinstance(system, (objects.Root, objects.System)):
@@ -369,6 +381,68 @@ def fork(simout="%(parent)s.f%(fork_seq)i"):
 
     return pid
 
+def forkSamples(points, sample, max_children=1,
+                simout="%(parent)s.f%(fork_seq)i"):
+    """Sample a simulation in forked children.
+
+    This function runs the simulation up to each of the given ticks in
+    turn, and forks a child there. The child calls sample, e.g., to
+    switch to a detailed CPU and measure a region of interest, and
+    exits with its return value as exit status, while the parent
+    carries on to the next tick. Memory is copy-on-write between the
+    processes, so forking is a cheap snapshot of the simulation. The
+    parent stops early if the simulation exits for another reason than
+    reaching a tick, and waits for all the children before returning.
+
+    Keyword Arguments:
+      points -- Increasing absolute ticks of the samples.
+      sample -- Function taking the sample number, run in the children.
+      max_children -- Maximum number of children running at once.
+      simout -- Output directory of the children, see fork().
+
+    Return Value:
+      Tuple of the last exit event of the parent and of the exit
+      statuses of the children, in sample order. The status of a child
+      killed by a signal is minus the signal number.
+    """
+
+    children = {}
+    statuses = []
+
+    def wait():
+        pid, status = os.wait()
+        if pid in children:
+            statuses[children.pop(pid)] = os.WEXITSTATUS(status) \
+                if os.WIFEXITED(status) else -os.WTERMSIG(status)
+
+    exit_event = None
+    for index, point in enumerate(points):
+        if point > _m5.core.curTick():
+            exit_event = simulate(point - _m5.core.curTick())
+            if exit_event.getCause() != "simulate() limit reached":
+                break
+
+        while len(children) >= max_children:
+            wait()
+
+        statuses.append(None)
+        pid = fork(simout)
+        if pid == 0:
+            try:
+                status = sample(index)
+            except:
+                import traceback
+                traceback.print_exc()
+                status = 1
+            sys.exit(status or 0)
+
+        children[pid] = index
+
+    while children:
+        wait()
+
+    return exit_event, statuses
+
 from _m5.core import disableAllListeners, listenersDisabled
 from _m5.core import listenersLoopbackOnly
 from _m5.core import curTick
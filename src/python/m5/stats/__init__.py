@@ -115,11 +115,28 @@ def _textFactory(fn, desc=True):
 
     return _m5.stats.initText(fn, desc)
 
+@_url_factory
+def _binaryFactory(fn, threaded=True):
+    """Output stats in a compact binary format.
+
+    Binary stat files describe the statistics once and then store the
+    values of each dump as one row of numbers, which makes frequent
+    dumps cheap. The rows are written by a background thread unless
+    the threaded parameter is set to False. Use m5.stats.binary to
+    read the files.
+
+    Example: binary://stats.bin?threaded=False
+
+    """
+
+    return _m5.stats.initBinary(fn, threaded)
+
 factories = {
     # Default to the text factory if we're given a naked path
     "" : _textFactory,
     "file" : _textFactory,
     "text" : _textFactory,
+    "binary" : _binaryFactory,
 }
 
 def addStatVisitor(url):
@@ -0,0 +1,217 @@
+# Copyright (c) 2026 The Regents of The University of Michigan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Reader for binary statistics files
+
+Binary stat files are written by the binary:// stat output (see
+base/stats/binary.hh for the layout). They hold a schema describing the
+statistics followed by one row of values per dump. This module has no
+dependency on the simulator, so it can be used from analysis scripts,
+either by importing it or by running it on a file to list its contents:
+
+    python binary.py m5out/stats.bin
+
+Example:
+
+    stats = StatsFile("m5out/stats.bin")
+    ipc = stats["system.cpu.ipc"].values     # one row per dump
+    print(stats.ticks, ipc[:, 0])
+
+Values are numpy arrays when numpy is available, and lists of
+array.array rows otherwise.
+"""
+
+import array
+import struct
+import sys
+from collections import OrderedDict
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+KINDS = ("scalar", "vector", "dist", "vector_dist", "vector2d",
+         "formula", "sparse_hist")
+
+class Stat(object):
+    """A statistic and its values at each dump
+
+    Attributes:
+      name, desc: Name and description of the statistic.
+      kind: One of KINDS.
+      dims: Shape of the statistic (e.g. (x, y) for a 2d vector).
+      columns: Name of each value of a dump, e.g. vector subnames.
+      dumps: Index (into StatsFile.ticks) of the dumps holding it.
+      values: One row of values per dump in dumps; a 2d array when
+              the statistic kept the same shape over all of them.
+    """
+
+    def __init__(self, name, desc, kind, dims, columns):
+        self.name = name
+        self.desc = desc
+        self.kind = kind
+        self.dims = dims
+        self.columns = columns
+        self.dumps = []
+        self.values = []
+
+    def __repr__(self):
+        return "Stat(%s, %s, %d dumps)" % (self.name, self.kind,
+                                           len(self.dumps))
+
+class StatsFile(object):
+    """Contents of a binary stat file
+
+    Attributes:
+      ticks: Tick of each dump.
+      stats: Statistics by name, in file order.
+    """
+
+    MAGIC = b"gem5stat"
+    VERSION = 1
+
+    def __init__(self, path):
+        self.ticks = []
+        self.stats = OrderedDict()
+
+        with open(path, "rb") as f:
+            data = f.read()
+
+        if data[:8] != self.MAGIC:
+            raise ValueError("%s is not a binary stat file" % path)
+
+        order = "<" if struct.unpack("<I", data[12:16])[0] == 0x01020304 \
+            else ">"
+        version, = struct.unpack(order + "I", data[8:12])
+        if version != self.VERSION:
+            raise ValueError("%s: unsupported version %d" % (path, version))
+
+        self._order = order
+        schema = []
+        pos = 16
+        while pos < len(data):
+            rtype = data[pos:pos + 1]
+            length, = struct.unpack(order + "Q", data[pos + 1:pos + 9])
+            payload = data[pos + 9:pos + 9 + length]
+            if len(payload) < length:
+                # last record was cut short, e.g. by a crash
+                break
+            pos += 9 + length
+
+            if rtype == b"S":
+                schema = self._parseSchema(payload)
+            elif rtype == b"D":
+                self._parseDump(payload, schema)
+            else:
+                raise ValueError("%s: bad record type %r" % (path, rtype))
+
+        for stat in self.stats.values():
+            self._finish(stat)
+
+    def __getitem__(self, name):
+        return self.stats[name]
+
+    def __contains__(self, name):
+        return name in self.stats
+
+    def __iter__(self):
+        return iter(self.stats.values())
+
+    def _unpack(self, fmt, payload, pos):
+        fmt = self._order + fmt
+        return struct.unpack_from(fmt, payload, pos), \
+            pos + struct.calcsize(fmt)
+
+    def _string(self, payload, pos):
+        (length,), pos = self._unpack("I", payload, pos)
+        return payload[pos:pos + length].decode("utf-8"), pos + length
+
+    def _parseSchema(self, payload):
+        schema = []
+        (num_stats,), pos = self._unpack("I", payload, 0)
+        for i in range(num_stats):
+            name, pos = self._string(payload, pos)
+            desc, pos = self._string(payload, pos)
+            (kind, num_dims), pos = self._unpack("BI", payload, pos)
+            dims, pos = self._unpack("%dQ" % num_dims, payload, pos)
+            (num_columns,), pos = self._unpack("I", payload, pos)
+            columns = []
+            for j in range(num_columns):
+                column, pos = self._string(payload, pos)
+                columns.append(column)
+
+            stat = self.stats.get(name)
+            if stat is None:
+                stat = Stat(name, desc, KINDS[kind], dims, columns)
+                self.stats[name] = stat
+            else:
+                stat.dims = dims
+                stat.columns = columns
+            schema.append((stat, num_columns))
+        return schema
+
+    def _parseDump(self, payload, schema):
+        (tick, num_values), pos = self._unpack("QQ", payload, 0)
+        if numpy is not None:
+            dtype = numpy.dtype(numpy.float64).newbyteorder(self._order)
+            values = numpy.frombuffer(payload, dtype, num_values, pos)
+        else:
+            values = array.array("d")
+            raw = payload[pos:pos + 8 * num_values]
+            if hasattr(values, "frombytes"):
+                values.frombytes(raw)
+            else:
+                values.fromstring(raw)
+            if self._order != ("<" if sys.byteorder == "little" else ">"):
+                values.byteswap()
+
+        dump = len(self.ticks)
+        self.ticks.append(tick)
+        offset = 0
+        for stat, num_columns in schema:
+            stat.dumps.append(dump)
+            stat.values.append(values[offset:offset + num_columns])
+            offset += num_columns
+
+    def _finish(self, stat):
+        if numpy is None or not stat.values:
+            return
+        if all(len(row) == len(stat.values[0]) for row in stat.values):
+            stat.values = numpy.array(stat.values)
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit("usage: %s <stats.bin>" % sys.argv[0])
+
+    stats = StatsFile(sys.argv[1])
+    print("%d dumps, ticks %s" % (len(stats.ticks), stats.ticks))
+    for stat in stats:
+        last = list(stat.values[-1]) if len(stat.dumps) else []
+        print("%s %s %s" % (stat.name, stat.kind, last))
+
+if __name__ == "__main__":
+    main()
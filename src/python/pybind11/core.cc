@@ -263,7 +263,8 @@ pybind_init_core(py::module &m_native)
      * Serialization helpers
      */
     m_core
-        .def("serializeAll", &Serializable::serializeAll)
+        .def("serializeAll", &Serializable::serializeAll,
+             py::arg("cpt_dir"), py::arg("binary") = false)
         .def("unserializeGlobals", &Serializable::unserializeGlobals)
         .def("getCheckpoint", [](const std::string &cpt_dir) {
             return new CheckpointIn(cpt_dir, pybindSimObjectResolver);
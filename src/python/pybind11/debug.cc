@@ -48,6 +48,7 @@
 #include <map>
 #include <vector>
 
+#include "base/binary_logger.hh"
 #include "base/debug.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
@@ -70,6 +71,13 @@ output(const char *filename)
     Trace::setDebugLogger(new Trace::OstreamLogger(*file_stream->stream()));
 }
 
+static void
+binaryOutput(const char *filename, uint64_t ring_records)
+{
+    Trace::setDebugLogger(
+        new Trace::BinaryLogger(simout.resolve(filename), ring_records));
+}
+
 static void
 ignore(const char *expr)
 {
@@ -112,6 +120,7 @@ pybind_init_debug(py::module &m_native)
     py::module m_trace = m_native.def_submodule("trace");
     m_trace
         .def("output", &output)
+        .def("binaryOutput", &binaryOutput)
         .def("ignore", &ignore)
         .def("enable", &Trace::enable)
         .def("disable", &Trace::disable)
@@ -65,8 +65,10 @@ class Root(SimObject):
     eventq_index = 0
 
     # Simulation Quantum for multiple main event queue simulation.
-    # Needs to be set explicitly for a multi-eventq simulation.
-    sim_quantum = Param.Tick(0, "simulation quantum")
+    # Needs to be set explicitly for a multi-eventq simulation, unless the
+    # queues only communicate through cross-queue channels (QueueBridge).
+    sim_quantum = Param.Tick(0, "simulation quantum (0: the smallest "
+                             "cross-queue channel latency)")
 
     full_system = Param.Bool("if this is a full system simulation")
 
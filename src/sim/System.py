@@ -51,6 +51,12 @@ from SimpleMemory import *
 class MemoryMode(Enum): vals = ['invalid', 'atomic', 'timing',
                                 'atomic_noncaching']
 
+# Formats of the checkpoint files of the physical memory. gzip is a
+# single compressed stream, sparse skips the zero pages and deflates the
+# other pages one by one, and sparse_raw skips the zero pages and keeps
+# the other pages raw so that they can be mapped into memory on restore.
+class PhysMemStoreFormat(Enum): vals = ['gzip', 'sparse', 'sparse_raw']
+
 class System(MemObject):
     type = 'System'
     cxx_header = "sim/system.hh"
@@ -76,6 +82,19 @@ class System(MemObject):
     mmap_using_noreserve = Param.Bool(False, "mmap the backing store " \
                                           "without reserving swap")
 
+    store_format = Param.PhysMemStoreFormat('gzip',
+        "Format of the checkpoint files of the physical memory")
+    store_threads = Param.Unsigned(0, "Host threads (de)compressing sparse "
+                                   "physical memory checkpoints, 0 for one "
+                                   "per host core")
+    # Restoring a sparse checkpoint with this flag maps its raw pages
+    # into the backing store copy-on-write, so that they are read from
+    # the checkpoint only when touched. The checkpoint files must then
+    # not change while the simulation runs.
+    store_restore_mmap = Param.Bool(False, "Restore the raw pages of "
+                                    "sparse physical memory checkpoints "
+                                    "lazily by mapping them")
+
     # The memory ranges are to be populated when creating the system
     # such that these can be passed from the I/O subsystem through an
     # I/O bridge or cache
@@ -0,0 +1,438 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/binary_checkpoint.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/Checkpoint.hh"
+
+using namespace std;
+
+namespace BinaryCheckpoint {
+
+const char magic[8] = { 'g', 'e', 'm', '5', 'c', 'p', 't', 'b' };
+
+namespace {
+
+const uint32_t version = 1;
+
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t sections;
+    uint64_t indexOffset;
+};
+
+/** Index of the pointer to the Writer of a stream in its pword array. */
+const int writerIndex = ios_base::xalloc();
+
+bool
+hostIsLittle()
+{
+    const uint16_t one = 1;
+    return *reinterpret_cast<const uint8_t *>(&one) == 1;
+}
+
+/**
+ * Cursor over part of the mapped file, which fails on reads beyond
+ * its end.
+ */
+class Cursor
+{
+  private:
+    const string &path;
+    const uint8_t *pos;
+    const uint8_t *end;
+
+  public:
+    Cursor(const string &path, const uint8_t *begin, uint64_t bytes)
+        : path(path), pos(begin), end(begin + bytes)
+    {}
+
+    bool done() const { return pos == end; }
+
+    const uint8_t *
+    skip(uint64_t bytes)
+    {
+        if (bytes > (uint64_t)(end - pos))
+            fatal("Binary checkpoint '%s' is truncated\n", path);
+        const uint8_t *start = pos;
+        pos += bytes;
+        return start;
+    }
+
+    template <class T>
+    T
+    get()
+    {
+        T value;
+        copyLittle(&value, skip(sizeof(T)), sizeof(T), 1);
+        return value;
+    }
+
+    string
+    name()
+    {
+        const uint16_t length = get<uint16_t>();
+        return string(reinterpret_cast<const char *>(skip(length)), length);
+    }
+};
+
+template <class T>
+void
+showValue(ostream &os, const uint8_t *data)
+{
+    T value;
+    copyLittle(&value, data, sizeof(T), 1);
+    os << value;
+}
+
+} // anonymous namespace
+
+unsigned
+typeSize(Type type)
+{
+    static const unsigned sizes[NumTypes] = {
+        0, 1, 1, 1, 2, 2, 4, 4, 8, 8, 4, 8
+    };
+    return sizes[type];
+}
+
+bool
+isBinary(const string &path)
+{
+    ifstream file(path, ios::in | ios::binary);
+    char start[sizeof(magic)];
+    return file.read(start, sizeof(start)) &&
+        memcmp(start, magic, sizeof(magic)) == 0;
+}
+
+void
+copyLittle(void *dest, const void *src, unsigned size, uint64_t count)
+{
+    static const bool little = hostIsLittle();
+    memcpy(dest, src, size * count);
+    if (!little && size > 1) {
+        uint8_t *bytes = static_cast<uint8_t *>(dest);
+        for (uint64_t i = 0; i < count; i++)
+            reverse(bytes + i * size, bytes + (i + 1) * size);
+    }
+}
+
+Writer::Writer(ostream &_os)
+    : os(_os), offset(0)
+{
+    Header header;
+    memset(&header, 0, sizeof(header));
+    put(&header, sizeof(header));
+    os.pword(writerIndex) = this;
+}
+
+Writer::~Writer()
+{
+    os.pword(writerIndex) = nullptr;
+}
+
+Writer *
+Writer::get(ostream &os)
+{
+    return static_cast<Writer *>(os.pword(writerIndex));
+}
+
+void
+Writer::put(const void *data, uint64_t bytes)
+{
+    os.write(static_cast<const char *>(data), bytes);
+    offset += bytes;
+}
+
+void
+Writer::closeSection()
+{
+    if (!index.empty())
+        index.back().bytes = offset - index.back().offset;
+}
+
+void
+Writer::section(const string &name)
+{
+    closeSection();
+    index.push_back({ name, offset, 0 });
+}
+
+void
+Writer::entry(const string &name, Type type, uint64_t count)
+{
+    if (index.empty())
+        panic("Binary checkpoint entry %s is outside of any section\n", name);
+    if (name.size() > UINT16_MAX)
+        panic("Binary checkpoint entry name %s is too long\n", name);
+
+    const uint16_t length = name.size();
+    uint8_t le[sizeof(count)];
+    copyLittle(le, &length, sizeof(length), 1);
+    put(le, sizeof(length));
+    put(name.data(), length);
+    put(&type, sizeof(type));
+    copyLittle(le, &count, sizeof(count), 1);
+    put(le, sizeof(count));
+}
+
+void
+Writer::values(const void *data, unsigned size, uint64_t count)
+{
+    static const bool little = hostIsLittle();
+    if (little) {
+        put(data, size * count);
+        return;
+    }
+
+    uint8_t le[sizeof(uint64_t)];
+    for (uint64_t i = 0; i < count; i++) {
+        copyLittle(le, static_cast<const uint8_t *>(data) + i * size, size,
+                   1);
+        put(le, size);
+    }
+}
+
+void
+Writer::text(const string &value)
+{
+    const uint32_t length = value.size();
+    values(&length, sizeof(length), 1);
+    put(value.data(), length);
+}
+
+void
+Writer::finish()
+{
+    closeSection();
+
+    const uint32_t sections = index.size();
+    const uint64_t index_offset = offset;
+
+    for (const auto &section : index) {
+        if (section.name.size() > UINT16_MAX)
+            panic("Checkpoint section name %s is too long\n", section.name);
+        const uint16_t length = section.name.size();
+        values(&length, sizeof(length), 1);
+        put(section.name.data(), length);
+        values(&section.offset, sizeof(section.offset), 1);
+        values(&section.bytes, sizeof(section.bytes), 1);
+    }
+
+    Header header;
+    memcpy(header.magic, magic, sizeof(magic));
+    copyLittle(&header.version, &version, sizeof(version), 1);
+    copyLittle(&header.sections, &sections, sizeof(sections), 1);
+    copyLittle(&header.indexOffset, &index_offset, sizeof(index_offset), 1);
+    os.seekp(0);
+    os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    os.seekp(offset);
+}
+
+Reader::Reader(const string &_path)
+    : path(_path), fileData(nullptr), fileSize(0)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        fatal("Can't open binary checkpoint '%s'\n", path);
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+        fatal("Can't stat binary checkpoint '%s'\n", path);
+    fileSize = st.st_size;
+    if (fileSize < sizeof(Header))
+        fatal("Binary checkpoint '%s' is truncated\n", path);
+
+    void *data = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        fatal("Could not mmap binary checkpoint '%s'\n", path);
+    fileData = static_cast<const uint8_t *>(data);
+
+    Cursor header(path, fileData, sizeof(Header));
+    if (memcmp(header.skip(sizeof(magic)), magic, sizeof(magic)) != 0)
+        fatal("'%s' is not a binary checkpoint\n", path);
+    const uint32_t file_version = header.get<uint32_t>();
+    if (file_version != version)
+        fatal("Binary checkpoint '%s' has version %d, expected %d\n", path,
+              file_version, version);
+    const uint32_t num_sections = header.get<uint32_t>();
+    const uint64_t index_offset = header.get<uint64_t>();
+    if (index_offset < sizeof(Header) || index_offset > fileSize)
+        fatal("Binary checkpoint '%s' is truncated\n", path);
+
+    Cursor index(path, fileData + index_offset, fileSize - index_offset);
+    for (uint32_t i = 0; i < num_sections; i++) {
+        const string name = index.name();
+        const uint64_t offset = index.get<uint64_t>();
+        const uint64_t bytes = index.get<uint64_t>();
+        if (offset < sizeof(Header) || offset > index_offset ||
+            bytes > index_offset - offset) {
+            fatal("Corrupt section %s in binary checkpoint '%s'\n", name,
+                  path);
+        }
+        sections[name].extents.push_back({ offset, bytes });
+    }
+
+    DPRINTF(Checkpoint, "Indexed %d sections of %s\n", num_sections, path);
+}
+
+Reader::~Reader()
+{
+    munmap(const_cast<uint8_t *>(fileData), fileSize);
+}
+
+void
+Reader::decode(Section &section)
+{
+    for (const auto &extent : section.extents) {
+        Cursor cursor(path, fileData + extent.offset, extent.bytes);
+        while (!cursor.done()) {
+            const string name = cursor.name();
+            Entry entry;
+            const uint8_t type = cursor.get<uint8_t>();
+            if (type >= NumTypes)
+                fatal("Corrupt entry %s in binary checkpoint '%s'\n", name,
+                      path);
+            entry.type = static_cast<Type>(type);
+            entry.count = cursor.get<uint64_t>();
+
+            if (entry.type == Text) {
+                entry.data = cursor.skip(0);
+                for (uint64_t i = 0; i < entry.count; i++)
+                    cursor.skip(cursor.get<uint32_t>());
+                entry.bytes = cursor.skip(0) - entry.data;
+            } else {
+                const unsigned size = typeSize(entry.type);
+                if (entry.count > extent.bytes / size)
+                    fatal("Binary checkpoint '%s' is truncated\n", path);
+                entry.bytes = entry.count * size;
+                entry.data = cursor.skip(entry.bytes);
+            }
+
+            section.entries[name] = entry;
+        }
+    }
+    section.decoded = true;
+}
+
+const Entry *
+Reader::find(const string &section_name, const string &entry_name)
+{
+    auto s = sections.find(section_name);
+    if (s == sections.end())
+        return nullptr;
+
+    Section &section = s->second;
+    if (!section.decoded)
+        decode(section);
+
+    auto e = section.entries.find(entry_name);
+    return e == section.entries.end() ? nullptr : &e->second;
+}
+
+bool
+Reader::sectionExists(const string &section) const
+{
+    return sections.find(section) != sections.end();
+}
+
+string
+Reader::toText(const Entry &entry)
+{
+    ostringstream os;
+    const uint8_t *data = entry.data;
+    for (uint64_t i = 0; i < entry.count; i++) {
+        if (i > 0)
+            os << " ";
+
+        switch (entry.type) {
+          case Text: {
+            uint32_t length;
+            copyLittle(&length, data, sizeof(length), 1);
+            os.write(reinterpret_cast<const char *>(data + sizeof(length)),
+                     length);
+            data += sizeof(length) + length;
+            continue;
+          }
+          case Bool:
+            os << (*data ? "true" : "false");
+            break;
+          case Int8:
+            os << (int)(int8_t)*data;
+            break;
+          case UInt8:
+            os << (unsigned)*data;
+            break;
+          case Int16:
+            showValue<int16_t>(os, data);
+            break;
+          case UInt16:
+            showValue<uint16_t>(os, data);
+            break;
+          case Int32:
+            showValue<int32_t>(os, data);
+            break;
+          case UInt32:
+            showValue<uint32_t>(os, data);
+            break;
+          case Int64:
+            showValue<int64_t>(os, data);
+            break;
+          case UInt64:
+            showValue<uint64_t>(os, data);
+            break;
+          case Float:
+            showValue<float>(os, data);
+            break;
+          case Double:
+            showValue<double>(os, data);
+            break;
+          default:
+            panic("Unknown binary checkpoint type %d\n", entry.type);
+        }
+        data += typeSize(entry.type);
+    }
+    return os.str();
+}
+
+} // namespace BinaryCheckpoint
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_BINARY_CHECKPOINT_HH__
+#define __SIM_BINARY_CHECKPOINT_HH__
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file
+ * Binary checkpoint files, an alternative to the INI text of m5.cpt.
+ *
+ * A file holds the same sections and entries as the INI file would,
+ * but values of the basic types are stored as raw little-endian
+ * arrays instead of decimal text. Values of other types are stored as
+ * their text. The sections are followed by an index of their offsets,
+ * so that restoring only decodes the sections it looks up:
+ *
+ *   char     magic[8]        "gem5cptb"
+ *   uint32_t version
+ *   uint32_t sections
+ *   uint64_t index_offset
+ *   sections, each a sequence of entries:
+ *     uint16_t name_length, char name[name_length]
+ *     uint8_t  type          a BinaryCheckpoint::Type
+ *     uint64_t count         number of values
+ *     values                 count * size of the type bytes, or for
+ *                            text, a uint32_t length and the chars of
+ *                            each value
+ *   index, for each section:
+ *     uint16_t name_length, char name[name_length]
+ *     uint64_t offset, uint64_t bytes
+ *
+ * util/cpt_binary.py converts between the two formats.
+ */
+
+namespace BinaryCheckpoint {
+
+enum Type : uint8_t {
+    Text,
+    Bool,
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Int64,
+    UInt64,
+    Float,
+    Double,
+    NumTypes
+};
+
+/** An entry of a file being restored, which points into the file. */
+struct Entry
+{
+    Type type;
+    uint64_t count;
+    const uint8_t *data;
+    uint64_t bytes;
+};
+
+/** Bytes of a value of a type, 0 for text. */
+unsigned typeSize(Type type);
+
+/** Magic string at the start of the files. */
+extern const char magic[8];
+
+/** Check whether a file starts like a binary checkpoint. */
+bool isBinary(const std::string &path);
+
+/** Copy values between host and little-endian byte order. */
+void copyLittle(void *dest, const void *src, unsigned size, uint64_t count);
+
+/**
+ * Writer of a binary checkpoint into the output stream of the
+ * serialization. The writer attaches itself to the stream, where
+ * paramOut() and friends look for it.
+ */
+class Writer
+{
+  private:
+    struct IndexEntry
+    {
+        std::string name;
+        uint64_t offset;
+        uint64_t bytes;
+    };
+
+    std::ostream &os;
+
+    /** Offset of the stream, bytes written so far. */
+    uint64_t offset;
+
+    std::vector<IndexEntry> index;
+
+    void put(const void *data, uint64_t bytes);
+    void closeSection();
+
+  public:
+    /** Write the header and attach to a stream. */
+    Writer(std::ostream &os);
+
+    /** Detach from the stream. */
+    ~Writer();
+
+    /** Writer attached to a stream, or nullptr for INI streams. */
+    static Writer *get(std::ostream &os);
+
+    /** Start a section, the following entries go in it. */
+    void section(const std::string &name);
+
+    /**
+     * Start an entry, and then write its values with values() or
+     * text(), count of them in all.
+     */
+    void entry(const std::string &name, Type type, uint64_t count);
+
+    /** Write values of the type of the entry, in host byte order. */
+    void values(const void *data, unsigned size, uint64_t count);
+
+    /** Write a text value. */
+    void text(const std::string &value);
+
+    /** Write the index, and update the header. */
+    void finish();
+};
+
+/**
+ * A binary checkpoint file being restored. The file is mapped, and a
+ * section is only decoded the first time one of its entries is looked
+ * up.
+ */
+class Reader
+{
+  private:
+    struct Extent
+    {
+        uint64_t offset;
+        uint64_t bytes;
+    };
+
+    struct Section
+    {
+        /** Where the section is in the file. It may appear more than
+         * once, in which case the later entries win, as with INI. */
+        std::vector<Extent> extents;
+
+        bool decoded = false;
+        std::unordered_map<std::string, Entry> entries;
+    };
+
+    std::string path;
+    const uint8_t *fileData;
+    uint64_t fileSize;
+
+    std::unordered_map<std::string, Section> sections;
+
+    void decode(Section &section);
+
+  public:
+    Reader(const std::string &path);
+    ~Reader();
+
+    Reader(const Reader &) = delete;
+    Reader &operator=(const Reader &) = delete;
+
+    /** Look an entry up, nullptr if there is none. */
+    const Entry *find(const std::string &section, const std::string &entry);
+
+    bool sectionExists(const std::string &section) const;
+
+    /**
+     * Text of an entry, as it would be in an INI file: its values in
+     * text separated by spaces.
+     */
+    static std::string toText(const Entry &entry);
+};
+
+} // namespace BinaryCheckpoint
+
+#endif // __SIM_BINARY_CHECKPOINT_HH__
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/cross_queue_channel.hh"
+
+CrossQueueChannelBase::CrossQueueChannelBase(const std::string &name,
+                                             EventQueue *src,
+                                             EventQueue *dst, Tick latency)
+    : _name(name), src(src), dst(dst), _latency(latency)
+{
+    channels().push_back(this);
+}
+
+CrossQueueChannelBase::~CrossQueueChannelBase()
+{
+    auto &all = channels();
+    all.erase(std::find(all.begin(), all.end(), this));
+}
+
+std::vector<CrossQueueChannelBase *> &
+CrossQueueChannelBase::channels()
+{
+    static std::vector<CrossQueueChannelBase *> all;
+    return all;
+}
+
+void
+CrossQueueChannelBase::deliverAll(EventQueue *dst)
+{
+    for (auto channel : channels()) {
+        if (channel->dst == dst)
+            channel->deliver();
+    }
+}
+
+DrainState
+CrossQueueChannelBase::drain()
+{
+    return empty() ? DrainState::Drained : DrainState::Draining;
+}
+
+Tick
+CrossQueueChannelBase::lookahead()
+{
+    Tick min_latency = MaxTick;
+    for (auto channel : channels()) {
+        if (channel->src != channel->dst)
+            min_latency = std::min(min_latency, channel->latency());
+    }
+    return min_latency;
+}
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_CROSS_QUEUE_CHANNEL_HH__
+#define __SIM_CROSS_QUEUE_CHANNEL_HH__
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "base/logging.hh"
+#include "base/types.hh"
+#include "sim/core.hh"
+#include "sim/drain.hh"
+#include "sim/eventq_impl.hh"
+
+/**
+ * @file sim/cross_queue_channel.hh
+ *
+ * Deterministic one-way message channels between event queues.
+ *
+ * When the main event queues run in parallel, objects in different
+ * queues must not call each other directly. A channel instead takes
+ * messages in the sending queue's thread and buffers them until the
+ * next global barrier (see GlobalSyncEvent), where the thread owning
+ * the receiving queue moves them into its queue. Every message takes at
+ * least the channel's latency to arrive, which is the lookahead that
+ * allows the queues to run a quantum apart: as long as the quantum does
+ * not exceed the smallest channel latency, a message never arrives in
+ * the receiver's past.
+ *
+ * The sender's buffer is only written by the sending thread and only
+ * read at the barrier, so no locking is needed. Channels are drained in
+ * the order they were created, and their messages are delivered in
+ * arrival order (send order for equal arrival ticks), which keeps the
+ * simulation deterministic regardless of thread timing.
+ *
+ * Outside parallel mode, or when both ends are in the same queue,
+ * messages are handed to the receiving queue as soon as they are sent.
+ *
+ * A channel is drained once all its messages have arrived.
+ */
+class CrossQueueChannelBase : public Drainable
+{
+  public:
+    /**
+     * @param name Name of the channel, used for its delivery event.
+     * @param src Queue from which the messages are sent.
+     * @param dst Queue in which the messages are received.
+     * @param latency Minimum time, in ticks, a message takes to arrive.
+     */
+    CrossQueueChannelBase(const std::string &name, EventQueue *src,
+                          EventQueue *dst, Tick latency);
+
+    virtual ~CrossQueueChannelBase();
+
+    const std::string &name() const { return _name; }
+
+    EventQueue *source() const { return src; }
+
+    EventQueue *destination() const { return dst; }
+
+    Tick latency() const { return _latency; }
+
+    /** Whether no message is in flight. */
+    virtual bool empty() const = 0;
+
+    DrainState drain() override;
+
+    /**
+     * Move the messages sent to the given queue since the last barrier
+     * into the queue. Must be called by the thread owning the queue
+     * while all threads are held at a global barrier.
+     */
+    static void deliverAll(EventQueue *dst);
+
+    /**
+     * Smallest latency of all channels between two different queues,
+     * or MaxTick if there are none.
+     */
+    static Tick lookahead();
+
+  protected:
+    /** Schedule the delivery of the buffered messages. */
+    virtual void deliver() = 0;
+
+    const std::string _name;
+    EventQueue *const src;
+    EventQueue *const dst;
+    const Tick _latency;
+
+  private:
+    /** All channels, in creation order. */
+    static std::vector<CrossQueueChannelBase *> &channels();
+};
+
+/**
+ * A channel carrying messages of type T, which are passed to a handler
+ * in the receiving queue's thread when they arrive.
+ */
+template <class T>
+class CrossQueueChannel : public CrossQueueChannelBase
+{
+  public:
+    typedef std::function<void(const T &)> Handler;
+
+  private:
+    struct Message
+    {
+        Tick when;
+        T data;
+    };
+
+    /** Messages sent since the last barrier (sender's side). */
+    std::vector<Message> sent;
+
+    /** Messages waiting to arrive, by arrival tick (receiver's side). */
+    std::deque<Message> ready;
+
+    Handler handler;
+
+    EventFunctionWrapper arriveEvent;
+
+    void
+    arrive()
+    {
+        while (!ready.empty() && ready.front().when <= curTick()) {
+            T data = ready.front().data;
+            ready.pop_front();
+            handler(data);
+        }
+
+        if (empty() && drainState() == DrainState::Draining)
+            signalDrainDone();
+
+        // the handler may have sent more messages already
+        if (!ready.empty() && !arriveEvent.scheduled())
+            dst->schedule(&arriveEvent, ready.front().when);
+    }
+
+  protected:
+    void
+    deliver() override
+    {
+        for (auto &msg : sent) {
+            panic_if(msg.when < dst->getCurTick(),
+                     "%s: message arrives in the past, the quantum "
+                     "exceeds the channel latency\n", name());
+            auto pos = std::upper_bound(ready.begin(), ready.end(), msg,
+                [](const Message &a, const Message &b) {
+                    return a.when < b.when;
+                });
+            ready.insert(pos, msg);
+        }
+        sent.clear();
+
+        if (ready.empty())
+            return;
+
+        if (!arriveEvent.scheduled())
+            dst->schedule(&arriveEvent, ready.front().when);
+        else if (arriveEvent.when() > ready.front().when)
+            dst->reschedule(&arriveEvent, ready.front().when);
+    }
+
+  public:
+    CrossQueueChannel(const std::string &name, EventQueue *src,
+                      EventQueue *dst, Tick latency, const Handler &handler)
+        : CrossQueueChannelBase(name, src, dst, latency), handler(handler),
+          arriveEvent([this]{ arrive(); }, name)
+    {}
+
+    ~CrossQueueChannel()
+    {
+        if (arriveEvent.scheduled())
+            dst->deschedule(&arriveEvent);
+    }
+
+    /**
+     * Send a message from the current queue. It arrives after the
+     * channel latency plus the given extra delay.
+     */
+    void
+    send(const T &data, Tick extra_delay = 0)
+    {
+        sent.push_back(Message{src->getCurTick() + _latency + extra_delay,
+                               data});
+        if (!inParallelMode || src == dst)
+            deliver();
+    }
+
+    bool empty() const override { return sent.empty() && ready.empty(); }
+
+    /**
+     * Whether any message in flight satisfies the given predicate. Only
+     * safe from one end of the channel while the queue at the other end
+     * is locked (see EventQueue::ScopedMigration).
+     */
+    bool
+    anyOf(const std::function<bool(const T &)> &pred) const
+    {
+        for (auto &msg : sent) {
+            if (pred(msg.data))
+                return true;
+        }
+        for (auto &msg : ready) {
+            if (pred(msg.data))
+                return true;
+        }
+        return false;
+    }
+};
+
+#endif // __SIM_CROSS_QUEUE_CHANNEL_HH__
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/event_wheel.hh"
+
+#include <algorithm>
+
+#include "base/bitfield.hh"
+#include "base/logging.hh"
+
+EventWheel::EventWheel(unsigned slot_ticks_log2, unsigned num_slots_log2)
+    : slotShift(slot_ticks_log2), numSlots(uint64_t(1) << num_slots_log2),
+      slotMask(numSlots - 1), baseSlot(0), baseTick(0),
+      slotLast(numSlots, NULL), occupied(numSlots / 64, 0)
+{
+    fatal_if(num_slots_log2 < 6, "An event wheel needs at least 64 slots\n");
+}
+
+EventWheel::Key
+EventWheel::key(const Event *event)
+{
+    return Key(event->when(), event->priority());
+}
+
+bool
+EventWheel::findOccupied(uint64_t hi, uint64_t lo, uint64_t &found) const
+{
+    assert(hi >= lo);
+
+    uint64_t slot = hi;
+    while (true) {
+        unsigned idx = slot & slotMask;
+        unsigned bit = idx % 64;
+        uint64_t bits = occupied[idx / 64];
+        if (bit != 63)
+            bits &= (uint64_t(2) << bit) - 1;
+
+        if (bits) {
+            uint64_t candidate = slot - (bit - findMsbSet(bits));
+            if (candidate < lo)
+                return false;
+            found = candidate;
+            return true;
+        }
+
+        // continue with the last slot of the previous word
+        if (slot - lo <= bit)
+            return false;
+        slot -= bit + 1;
+    }
+}
+
+Event *
+EventWheel::findPrevBin(Event *head, const Event *event) const
+{
+    assert(head && *head < *event);
+
+    uint64_t found;
+
+    if (!inWheel(event->when())) {
+        // Every bin past the wheel is in the overflow map, and every bin
+        // on the wheel sorts before them.
+        auto it = overflow.lower_bound(key(event));
+        if (it != overflow.begin())
+            return (--it)->second;
+
+        bool M5_VAR_USED any = findOccupied(baseSlot + numSlots - 1,
+                                            baseSlot, found);
+        assert(any);
+        return slotLast[found & slotMask];
+    }
+
+    // Start from the youngest bin of the closest occupied slot before the
+    // event's own, or from the head if there is none (in which case the
+    // head shares the event's slot). Either way, only the bins in the
+    // event's slot are left to walk over.
+    uint64_t slot = event->when() >> slotShift;
+    Event *prev = head;
+    if (slot > baseSlot && findOccupied(slot - 1, baseSlot, found))
+        prev = slotLast[found & slotMask];
+
+    while (prev->nextBin && *prev->nextBin < *event)
+        prev = prev->nextBin;
+
+    return prev;
+}
+
+void
+EventWheel::addToSlot(Event *top)
+{
+    unsigned idx = slotIndex(top->when());
+    Event *&last = slotLast[idx];
+    if (!last || *last < *top)
+        last = top;
+    setOccupied(idx);
+}
+
+void
+EventWheel::binAdded(Event *top)
+{
+    assert(top->when() >= baseTick);
+
+    if (inWheel(top->when()))
+        addToSlot(top);
+    else
+        overflow[key(top)] = top;
+}
+
+void
+EventWheel::binTopChanged(Event *old_top, Event *new_top)
+{
+    assert(*old_top == *new_top);
+
+    if (inWheel(new_top->when())) {
+        Event *&last = slotLast[slotIndex(new_top->when())];
+        if (last == old_top)
+            last = new_top;
+    } else {
+        auto it = overflow.find(key(new_top));
+        assert(it != overflow.end() && it->second == old_top);
+        it->second = new_top;
+    }
+}
+
+void
+EventWheel::binRemoved(Event *top, Event *prev)
+{
+    if (!inWheel(top->when())) {
+        overflow.erase(key(top));
+        return;
+    }
+
+    unsigned idx = slotIndex(top->when());
+    if (slotLast[idx] != top)
+        return;
+
+    if (prev && (prev->when() >> slotShift) == (top->when() >> slotShift)) {
+        slotLast[idx] = prev;
+    } else {
+        slotLast[idx] = NULL;
+        clearOccupied(idx);
+    }
+}
+
+void
+EventWheel::advance(Tick when)
+{
+    // Nothing is scheduled before when, so the slots the wheel moves
+    // past are empty and can be reused for its new far end.
+    baseSlot = when >> slotShift;
+    baseTick = baseSlot << slotShift;
+
+    auto it = overflow.begin();
+    while (it != overflow.end() && inWheel(it->first.first)) {
+        addToSlot(it->second);
+        it = overflow.erase(it);
+    }
+}
+
+void
+EventWheel::rebuild(Tick base, Event *head)
+{
+    std::fill(slotLast.begin(), slotLast.end(), (Event *)NULL);
+    std::fill(occupied.begin(), occupied.end(), 0);
+    overflow.clear();
+
+    baseSlot = base >> slotShift;
+    baseTick = baseSlot << slotShift;
+
+    for (Event *bin = head; bin; bin = bin->nextBin)
+        binAdded(bin);
+}
+
+bool
+EventWheel::verify(Event *head) const
+{
+    std::vector<Event *> last(numSlots, NULL);
+    size_t num_overflow = 0;
+
+    for (Event *bin = head; bin; bin = bin->nextBin) {
+        if (bin->when() < baseTick)
+            return false;
+
+        if (inWheel(bin->when())) {
+            last[slotIndex(bin->when())] = bin;
+        } else {
+            auto it = overflow.find(key(bin));
+            if (it == overflow.end() || it->second != bin)
+                return false;
+            num_overflow++;
+        }
+    }
+
+    if (num_overflow != overflow.size())
+        return false;
+
+    for (unsigned idx = 0; idx < numSlots; idx++) {
+        bool is_set = occupied[idx / 64] & (uint64_t(1) << (idx % 64));
+        if (slotLast[idx] != last[idx] || is_set != (last[idx] != NULL))
+            return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_EVENT_WHEEL_HH__
+#define __SIM_EVENT_WHEEL_HH__
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "base/types.hh"
+#include "sim/eventq.hh"
+
+/**
+ * Calendar index over the bins of an EventQueue.
+ *
+ * The event queue itself stays a sorted list of bins (one bin per
+ * when/priority pair, each a LIFO stack of events), so servicing and
+ * the ordering semantics are unchanged. What is slow about that list is
+ * finding where a new bin goes, which is linear in the number of bins.
+ * The wheel removes that walk: near-future bins are hashed into
+ * fixed-width tick slots that each remember their youngest bin, and
+ * bins past the end of the wheel are kept in an ordered overflow map
+ * that feeds the wheel as time advances. Finding a bin's predecessor
+ * then only touches the bins in its own slot.
+ *
+ * The wheel only holds pointers to the tops of bins. The owning queue
+ * must report every bin that is added or removed and every change of a
+ * bin's top event.
+ */
+class EventWheel
+{
+  public:
+    /**
+     * @param slot_ticks_log2 log2 of the number of ticks per slot.
+     * @param num_slots_log2 log2 of the number of slots.
+     */
+    EventWheel(unsigned slot_ticks_log2 = 9, unsigned num_slots_log2 = 12);
+
+    /**
+     * Make sure the wheel covers events scheduled at or after the
+     * given tick, given the queue's current head bin. Moves the wheel
+     * forward (and overflow bins onto it) as time advances, and
+     * rebuilds it in the rare case the queue goes back in time.
+     */
+    void
+    prepare(Tick when, Event *head)
+    {
+        if (when < baseTick)
+            rebuild(when, head);
+        else if ((when >> slotShift) > baseSlot)
+            advance(when);
+    }
+
+    /**
+     * Find the last bin that sorts strictly before the given event. The
+     * event must sort after the head bin.
+     */
+    Event *findPrevBin(Event *head, const Event *event) const;
+
+    /** A new bin topped by the given event was linked into the queue. */
+    void binAdded(Event *top);
+
+    /** A bin got a new top event (pushed onto it or popped off it). */
+    void binTopChanged(Event *old_top, Event *new_top);
+
+    /**
+     * A bin was unlinked from the queue.
+     * @param top The event that was the top of the bin.
+     * @param prev The top of the bin preceding it, or NULL.
+     */
+    void binRemoved(Event *top, Event *prev);
+
+    /** Discard the index and re-create it from the given bin list. */
+    void rebuild(Tick base, Event *head);
+
+    /** Check the index against the given bin list. */
+    bool verify(Event *head) const;
+
+  private:
+    typedef std::pair<Tick, Event::Priority> Key;
+
+    static Key key(const Event *event);
+
+    /** Whether the given tick falls before the end of the wheel. */
+    bool
+    inWheel(Tick when) const
+    {
+        return (when >> slotShift) < baseSlot + numSlots;
+    }
+
+    unsigned slotIndex(Tick when) const
+    { return (when >> slotShift) & slotMask; }
+
+    void setOccupied(unsigned idx)
+    { occupied[idx / 64] |= (uint64_t(1) << (idx % 64)); }
+
+    void clearOccupied(unsigned idx)
+    { occupied[idx / 64] &= ~(uint64_t(1) << (idx % 64)); }
+
+    /**
+     * Find the youngest occupied absolute slot in [lo, hi].
+     * @return Whether one was found.
+     */
+    bool findOccupied(uint64_t hi, uint64_t lo, uint64_t &found) const;
+
+    /** Place a bin that lies on the wheel into its slot. */
+    void addToSlot(Event *top);
+
+    /** Move the start of the wheel forward to the slot holding when. */
+    void advance(Tick when);
+
+    const unsigned slotShift;
+    const uint64_t numSlots;
+    const uint64_t slotMask;
+
+    /** Absolute slot number (tick >> slotShift) of the first slot. */
+    uint64_t baseSlot;
+    /** First tick covered by the wheel. */
+    Tick baseTick;
+
+    /** Top event of the youngest bin in each slot, or NULL. */
+    std::vector<Event *> slotLast;
+    /** One bit per slot, set when the slot holds a bin. */
+    std::vector<uint64_t> occupied;
+
+    /** Bins scheduled past the end of the wheel, by when and priority. */
+    std::map<Key, Event *> overflow;
+};
+
+#endif // __SIM_EVENT_WHEEL_HH__
@@ -43,6 +43,7 @@
 #include "cpu/smt.hh"
 #include "debug/Checkpoint.hh"
 #include "sim/core.hh"
+#include "sim/event_wheel.hh"
 #include "sim/eventq_impl.hh"
 
 using namespace std;
@@ -60,18 +61,33 @@ vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
 
+//! Backend of the main event queues allocated from now on.
+static EventQueue::Backend mainEventQueueBackend = EventQueue::ListBackend;
+
 EventQueue *
 getEventQueue(uint32_t index)
 {
     while (numMainEventQueues <= index) {
         numMainEventQueues++;
         mainEventQueue.push_back(
-            new EventQueue(csprintf("MainEventQueue-%d", index)));
+            new EventQueue(csprintf("MainEventQueue-%d", index),
+                           mainEventQueueBackend));
     }
 
     return mainEventQueue[index];
 }
 
+void
+setEventQueueBackend(const std::string &name)
+{
+    if (name == "list")
+        mainEventQueueBackend = EventQueue::ListBackend;
+    else if (name == "wheel")
+        mainEventQueueBackend = EventQueue::WheelBackend;
+    else
+        fatal("Unknown event queue backend '%s'\n", name);
+}
+
 #ifndef NDEBUG
 Counter Event::instanceCounter = 0;
 #endif
@@ -114,27 +130,67 @@ Event::insertBefore(Event *event, Event *curr)
     return event;
 }
 
+void
+EventQueue::wheelInserted(Event *event, Event *curr)
+{
+    if (curr && *event == *curr)
+        wheel->binTopChanged(curr, event);
+    else
+        wheel->binAdded(event);
+}
+
+void
+EventQueue::wheelRemoved(Event *top, Event *new_top, Event *prev)
+{
+    // nothing changes when an event below the top of a bin goes away
+    if (new_top == top)
+        return;
+
+    if (new_top && *new_top == *top)
+        wheel->binTopChanged(top, new_top);
+    else
+        wheel->binRemoved(top, prev);
+}
+
 void
 EventQueue::insert(Event *event)
 {
+    if (wheel) {
+        wheel->prepare(head ? std::min(head->when(), event->when()) :
+                       event->when(), head);
+    }
+
     // Deal with the head case
     if (!head || *event <= *head) {
+        Event *curr = head;
         head = Event::insertBefore(event, head);
+        if (wheel)
+            wheelInserted(event, curr);
         return;
     }
 
     // Figure out either which 'in bin' list we are on, or where a new list
     // needs to be inserted
-    Event *prev = head;
-    Event *curr = head->nextBin;
-    while (curr && *curr < *event) {
-        prev = curr;
-        curr = curr->nextBin;
+    Event *prev;
+    Event *curr;
+    if (wheel) {
+        prev = wheel->findPrevBin(head, event);
+        curr = prev->nextBin;
+    } else {
+        prev = head;
+        curr = head->nextBin;
+        while (curr && *curr < *event) {
+            prev = curr;
+            curr = curr->nextBin;
+        }
     }
 
     // Note: this operation may render all nextBin pointers on the
     // prev 'in bin' list stale (except for the top one)
     prev->nextBin = Event::insertBefore(event, curr);
+
+    if (wheel)
+        wheelInserted(event, curr);
 }
 
 Event *
@@ -179,16 +235,26 @@ EventQueue::remove(Event *event)
     // deal with an event on the head's 'in bin' list (event has the same
     // time as the head)
     if (*head == *event) {
+        Event *top = head;
         head = Event::removeItem(event, head);
+        if (wheel)
+            wheelRemoved(top, head, NULL);
         return;
     }
 
     // Find the 'in bin' list that this event belongs on
-    Event *prev = head;
-    Event *curr = head->nextBin;
-    while (curr && *curr < *event) {
-        prev = curr;
-        curr = curr->nextBin;
+    Event *prev;
+    Event *curr;
+    if (wheel) {
+        prev = wheel->findPrevBin(head, event);
+        curr = prev->nextBin;
+    } else {
+        prev = head;
+        curr = head->nextBin;
+        while (curr && *curr < *event) {
+            prev = curr;
+            curr = curr->nextBin;
+        }
     }
 
     if (!curr || *curr != *event)
@@ -198,6 +264,9 @@ EventQueue::remove(Event *event)
     // we remove an item, it returns the new top item (which may be
     // unchanged)
     prev->nextBin = Event::removeItem(event, curr);
+
+    if (wheel)
+        wheelRemoved(curr, prev->nextBin, prev);
 }
 
 Event *
@@ -220,6 +289,9 @@ EventQueue::serviceOne()
         head = head->nextBin;
     }
 
+    if (wheel)
+        wheelRemoved(event, head, NULL);
+
     // handle action
     if (!event->squashed()) {
         // forward current cycle to the time when this event occurs.
@@ -354,6 +426,11 @@ EventQueue::debugVerify() const
         nextBin = nextBin->nextBin;
     }
 
+    if (wheel && !wheel->verify(head)) {
+        warn("Event wheel out of sync with the event list\n");
+        return false;
+    }
+
     return true;
 }
 
@@ -362,6 +439,8 @@ EventQueue::replaceHead(Event* s)
 {
     Event* t = head;
     head = s;
+    if (wheel)
+        wheel->rebuild(s ? s->when() : 0, head);
     return t;
 }
 
@@ -413,8 +492,13 @@ Event::dump() const
     }
 }
 
-EventQueue::EventQueue(const string &n)
-    : objName(n), head(NULL), _curTick(0)
+EventQueue::EventQueue(const string &n, Backend backend)
+    : objName(n), head(NULL), _curTick(0),
+      wheel(backend == WheelBackend ? new EventWheel() : NULL)
+{
+}
+
+EventQueue::~EventQueue()
 {
 }
 
@@ -53,6 +53,7 @@
 #include "sim/serialize.hh"
 
 class EventQueue;       // forward declaration
+class EventWheel;
 class BaseGlobalEvent;
 
 //! Simulation Quantum for multiple eventq simulation.
@@ -82,6 +83,10 @@ extern bool inParallelMode;
 //! is with in bounds.
 EventQueue *getEventQueue(uint32_t index);
 
+//! Select the data structure ("list" or "wheel") used to order the
+//! events of queues allocated from now on by getEventQueue().
+void setEventQueueBackend(const std::string &name);
+
 inline EventQueue *curEventQueue() { return _curEventQueue; }
 inline void curEventQueue(EventQueue *q) { _curEventQueue = q; }
 
@@ -186,6 +191,7 @@ class EventBase
 class Event : public EventBase, public Serializable
 {
     friend class EventQueue;
+    friend class EventWheel;
 
   private:
     // The event queue is now a linked list of linked lists.  The
@@ -493,6 +499,10 @@ class EventQueue
     Event *head;
     Tick _curTick;
 
+    //! Calendar index over the bins of the queue, or NULL to find
+    //! insertion points by walking the bin list.
+    std::unique_ptr<EventWheel> wheel;
+
     //! Mutex to protect async queue.
     std::mutex async_queue_mutex;
 
@@ -526,6 +536,13 @@ class EventQueue
     void insert(Event *event);
     void remove(Event *event);
 
+    //! Keep the wheel up to date after an event was pushed on top of
+    //! curr's bin, or linked in as a new bin before it.
+    void wheelInserted(Event *event, Event *curr);
+    //! Keep the wheel up to date after an event was unlinked from the
+    //! bin topped by top, which is preceded by the bin topped by prev.
+    void wheelRemoved(Event *top, Event *new_top, Event *prev);
+
     //! Function for adding events to the async queue. The added events
     //! are added to main event queue later. Threads, other than the
     //! owning thread, should call this function instead of insert().
@@ -602,7 +619,15 @@ class EventQueue
         EventQueue &eq;
     };
 
-    EventQueue(const std::string &n);
+    /** Data structures available to order the events of a queue. */
+    enum Backend {
+        /** Walk the sorted list of bins to find insertion points. */
+        ListBackend,
+        /** Index the list of bins with an EventWheel. */
+        WheelBackend,
+    };
+
+    EventQueue(const std::string &n, Backend backend = ListBackend);
 
     virtual const std::string name() const { return objName; }
     void name(const std::string &st) { objName = st; }
@@ -711,7 +736,7 @@ class EventQueue
      */
     void checkpointReschedule(Event *event);
 
-    virtual ~EventQueue() { }
+    virtual ~EventQueue();
 };
 
 void dumpMainQueue();
@@ -31,6 +31,8 @@
 
 #include "sim/global_event.hh"
 
+#include "sim/cross_queue_channel.hh"
+
 std::mutex BaseGlobalEvent::globalQMutex;
 
 BaseGlobalEvent::BaseGlobalEvent(Priority p, Flags f)
@@ -131,6 +133,9 @@ GlobalEvent::BarrierEvent::process()
         _globalEvent->process();
     }
 
+    // no queue is running, pick up the messages sent to this one
+    CrossQueueChannelBase::deliverAll(curEventQueue());
+
     // second barrier to force all queues to wait for event processing
     // to finish before continuing
     globalBarrier();
@@ -145,6 +150,9 @@ GlobalSyncEvent::BarrierEvent::process()
         _globalEvent->process();
     }
 
+    // no queue is running, pick up the messages sent to this one
+    CrossQueueChannelBase::deliverAll(curEventQueue());
+
     // second barrier to force all queues to wait for event processing
     // to finish before continuing
     globalBarrier();
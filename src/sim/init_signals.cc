@@ -58,6 +58,7 @@
 #include "base/atomicio.hh"
 #include "base/cprintf.hh"
 #include "base/logging.hh"
+#include "base/trace.hh"
 #include "sim/async.hh"
 #include "sim/backtrace.hh"
 #include "sim/core.hh"
@@ -153,6 +154,8 @@ abortHandler(int sigtype)
         STATIC_ERR("Program aborted\n\n");
     }
 
+    // write out the debug messages held back, e.g., a ring of them
+    Trace::getDebugLogger()->crashFlush();
     print_backtrace();
     raiseFatalSignal(sigtype);
 }
@@ -163,6 +166,7 @@ segvHandler(int sigtype)
 {
     STATIC_ERR("gem5 has encountered a segmentation fault!\n\n");
 
+    Trace::getDebugLogger()->crashFlush();
     print_backtrace();
     raiseFatalSignal(SIGSEGV);
 }
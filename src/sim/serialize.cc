@@ -54,7 +54,9 @@
 #include <cerrno>
 #include <fstream>
 #include <list>
+#include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "arch/generic/vec_reg.hh"
@@ -65,6 +67,7 @@
 #include "base/str.hh"
 #include "base/trace.hh"
 #include "debug/Checkpoint.hh"
+#include "sim/binary_checkpoint.hh"
 #include "sim/eventq.hh"
 #include "sim/sim_events.hh"
 #include "sim/sim_exit.hh"
@@ -165,6 +168,144 @@ parseParam(const string &s, string &value)
     return true;
 }
 
+//
+// Binary checkpoints store the values of the integer, bool and
+// floating-point types raw, and those of the other types as the text
+// showParam() makes of them. Values are read raw when the checkpoint
+// has them with the exact type asked for, and through their text
+// otherwise.
+//
+
+constexpr BinaryCheckpoint::Type
+binaryIntType(size_t size, bool is_signed)
+{
+    return size == 1 ? (is_signed ? BinaryCheckpoint::Int8 :
+                        BinaryCheckpoint::UInt8) :
+        size == 2 ? (is_signed ? BinaryCheckpoint::Int16 :
+                     BinaryCheckpoint::UInt16) :
+        size == 4 ? (is_signed ? BinaryCheckpoint::Int32 :
+                     BinaryCheckpoint::UInt32) :
+        size == 8 ? (is_signed ? BinaryCheckpoint::Int64 :
+                     BinaryCheckpoint::UInt64) :
+        BinaryCheckpoint::Text;
+}
+
+template <class T>
+constexpr BinaryCheckpoint::Type
+binaryType()
+{
+    return std::is_same<T, bool>::value ? BinaryCheckpoint::Bool :
+        std::is_same<T, float>::value ? BinaryCheckpoint::Float :
+        std::is_same<T, double>::value ? BinaryCheckpoint::Double :
+        std::is_integral<T>::value ?
+        binaryIntType(sizeof(T), std::is_signed<T>::value) :
+        BinaryCheckpoint::Text;
+}
+
+static_assert(sizeof(bool) == 1, "Binary checkpoints store bools as bytes");
+
+/** Whether the values of a type are stored raw. */
+template <class T>
+using IsRaw = std::integral_constant<
+    bool, binaryType<T>() != BinaryCheckpoint::Text>;
+
+template <class T>
+void
+binaryValueOut(BinaryCheckpoint::Writer &w, const T &value, std::true_type)
+{
+    w.values(&value, sizeof(T), 1);
+}
+
+template <class T>
+void
+binaryValueOut(BinaryCheckpoint::Writer &w, const T &value, std::false_type)
+{
+    ostringstream os;
+    showParam(os, value);
+    w.text(os.str());
+}
+
+template <class T, class Iterator>
+void
+binaryParamOut(BinaryCheckpoint::Writer &w, const string &name,
+               Iterator begin, Iterator end, uint64_t count)
+{
+    w.entry(name, binaryType<T>(), count);
+    for (; begin != end; ++begin)
+        binaryValueOut<T>(w, *begin, IsRaw<T>());
+}
+
+template <class T>
+void
+binaryParamOut(BinaryCheckpoint::Writer &w, const string &name,
+               const T *values, uint64_t count, std::true_type)
+{
+    w.entry(name, binaryType<T>(), count);
+    w.values(values, sizeof(T), count);
+}
+
+template <class T>
+void
+binaryParamOut(BinaryCheckpoint::Writer &w, const string &name,
+               const T *values, uint64_t count, std::false_type)
+{
+    binaryParamOut<T>(w, name, values, values + count, count);
+}
+
+template <class T>
+void
+binaryParamOut(BinaryCheckpoint::Writer &w, const string &name,
+               const vector<T> &values)
+{
+    binaryParamOut(w, name, values.data(), values.size(), IsRaw<T>());
+}
+
+void
+binaryParamOut(BinaryCheckpoint::Writer &w, const string &name,
+               const vector<bool> &values)
+{
+    binaryParamOut<bool>(w, name, values.begin(), values.end(),
+                         values.size());
+}
+
+/**
+ * Find an entry of a binary checkpoint whose values are stored raw
+ * with type T, nullptr if there is none.
+ */
+template <class T>
+const BinaryCheckpoint::Entry *
+findRaw(CheckpointIn &cp, const string &section, const string &name)
+{
+    if (!IsRaw<T>::value)
+        return nullptr;
+    const BinaryCheckpoint::Entry *entry = cp.findBinary(section, name);
+    return entry && entry->type == binaryType<T>() ? entry : nullptr;
+}
+
+template <class T>
+T
+rawValue(const BinaryCheckpoint::Entry &entry, uint64_t i, std::true_type)
+{
+    T value;
+    BinaryCheckpoint::copyLittle(&value, entry.data + i * sizeof(T),
+                                 sizeof(T), 1);
+    return value;
+}
+
+template <class T>
+T
+rawValue(const BinaryCheckpoint::Entry &entry, uint64_t i, std::false_type)
+{
+    panic("Values of this type are not stored raw\n");
+}
+
+template <class T>
+T
+rawValue(const BinaryCheckpoint::Entry &entry, uint64_t i)
+{
+    return rawValue<T>(entry, i, IsRaw<T>());
+}
+
 int Serializable::ckptMaxCount = 0;
 int Serializable::ckptCount = 0;
 int Serializable::ckptPrevCount = -1;
@@ -174,6 +315,11 @@ template <class T>
 void
 paramOut(CheckpointOut &os, const string &name, const T &param)
 {
+    if (BinaryCheckpoint::Writer *w = BinaryCheckpoint::Writer::get(os)) {
+        binaryParamOut(*w, name, &param, 1, IsRaw<T>());
+        return;
+    }
+
     os << name << "=";
     showParam(os, param);
     os << "\n";
@@ -183,6 +329,11 @@ template <class T>
 void
 arrayParamOut(CheckpointOut &os, const string &name, const vector<T> &param)
 {
+    if (BinaryCheckpoint::Writer *w = BinaryCheckpoint::Writer::get(os)) {
+        binaryParamOut(*w, name, param);
+        return;
+    }
+
     typename vector<T>::size_type size = param.size();
     os << name << "=";
     if (size > 0)
@@ -198,6 +349,12 @@ template <class T>
 void
 arrayParamOut(CheckpointOut &os, const string &name, const list<T> &param)
 {
+    if (BinaryCheckpoint::Writer *w = BinaryCheckpoint::Writer::get(os)) {
+        binaryParamOut<T>(*w, name, param.begin(), param.end(),
+                          param.size());
+        return;
+    }
+
     typename list<T>::const_iterator it = param.begin();
 
     os << name << "=";
@@ -216,6 +373,12 @@ template <class T>
 void
 arrayParamOut(CheckpointOut &os, const string &name, const set<T> &param)
 {
+    if (BinaryCheckpoint::Writer *w = BinaryCheckpoint::Writer::get(os)) {
+        binaryParamOut<T>(*w, name, param.begin(), param.end(),
+                          param.size());
+        return;
+    }
+
     typename set<T>::const_iterator it = param.begin();
 
     os << name << "=";
@@ -235,6 +398,12 @@ void
 paramIn(CheckpointIn &cp, const string &name, T &param)
 {
     const string &section(Serializable::currentSection());
+    const BinaryCheckpoint::Entry *entry = findRaw<T>(cp, section, name);
+    if (entry && entry->count == 1) {
+        param = rawValue<T>(*entry, 0);
+        return;
+    }
+
     string str;
     if (!cp.find(section, name, str) || !parseParam(str, param)) {
         fatal("Can't unserialize '%s:%s'\n", section, name);
@@ -246,6 +415,12 @@ bool
 optParamIn(CheckpointIn &cp, const string &name, T &param, bool warn)
 {
     const string &section(Serializable::currentSection());
+    const BinaryCheckpoint::Entry *entry = findRaw<T>(cp, section, name);
+    if (entry && entry->count == 1) {
+        param = rawValue<T>(*entry, 0);
+        return true;
+    }
+
     string str;
     if (!cp.find(section, name, str) || !parseParam(str, param)) {
         if (warn)
@@ -261,6 +436,11 @@ void
 arrayParamOut(CheckpointOut &os, const string &name,
               const T *param, unsigned size)
 {
+    if (BinaryCheckpoint::Writer *w = BinaryCheckpoint::Writer::get(os)) {
+        binaryParamOut(*w, name, param, size, IsRaw<T>());
+        return;
+    }
+
     os << name << "=";
     if (size > 0)
         showParam(os, param[0]);
@@ -277,6 +457,12 @@ void
 arrayParamIn(CheckpointIn &cp, const string &name, T *param, unsigned size)
 {
     const string &section(Serializable::currentSection());
+    const BinaryCheckpoint::Entry *entry = findRaw<T>(cp, section, name);
+    if (entry && entry->count == size) {
+        BinaryCheckpoint::copyLittle(param, entry->data, sizeof(T), size);
+        return;
+    }
+
     string str;
     if (!cp.find(section, name, str)) {
         fatal("Can't unserialize '%s:%s'\n", section, name);
@@ -321,6 +507,14 @@ void
 arrayParamIn(CheckpointIn &cp, const string &name, vector<T> &param)
 {
     const string &section(Serializable::currentSection());
+    if (const BinaryCheckpoint::Entry *entry =
+            findRaw<T>(cp, section, name)) {
+        param.resize(entry->count);
+        for (uint64_t i = 0; i < entry->count; i++)
+            param[i] = rawValue<T>(*entry, i);
+        return;
+    }
+
     string str;
     if (!cp.find(section, name, str)) {
         fatal("Can't unserialize '%s:%s'\n", section, name);
@@ -363,6 +557,14 @@ void
 arrayParamIn(CheckpointIn &cp, const string &name, list<T> &param)
 {
     const string &section(Serializable::currentSection());
+    if (const BinaryCheckpoint::Entry *entry =
+            findRaw<T>(cp, section, name)) {
+        param.clear();
+        for (uint64_t i = 0; i < entry->count; i++)
+            param.push_back(rawValue<T>(*entry, i));
+        return;
+    }
+
     string str;
     if (!cp.find(section, name, str)) {
         fatal("Can't unserialize '%s:%s'\n", section, name);
@@ -393,6 +595,14 @@ void
 arrayParamIn(CheckpointIn &cp, const string &name, set<T> &param)
 {
     const string &section(Serializable::currentSection());
+    if (const BinaryCheckpoint::Entry *entry =
+            findRaw<T>(cp, section, name)) {
+        param.clear();
+        for (uint64_t i = 0; i < entry->count; i++)
+            param.insert(rawValue<T>(*entry, i));
+        return;
+    }
+
     string str;
     if (!cp.find(section, name, str)) {
         fatal("Can't unserialize '%s:%s'\n", section, name);
@@ -592,22 +802,32 @@ Serializable::unserializeSection(CheckpointIn &cp, const char *name)
 }
 
 void
-Serializable::serializeAll(const string &cpt_dir)
+Serializable::serializeAll(const string &cpt_dir, bool binary)
 {
     string dir = CheckpointIn::setDir(cpt_dir);
     if (mkdir(dir.c_str(), 0775) == -1 && errno != EEXIST)
             fatal("couldn't mkdir %s\n", dir);
 
     string cpt_file = dir + CheckpointIn::baseFilename;
-    ofstream outstream(cpt_file.c_str());
-    time_t t = time(NULL);
+    ofstream outstream(cpt_file.c_str(), binary ? ios::out | ios::binary :
+                       ios::out);
     if (!outstream.is_open())
         fatal("Unable to open file %s for writing\n", cpt_file.c_str());
-    outstream << "## checkpoint generated: " << ctime(&t);
 
-    globals.serializeSection(outstream, "Globals");
+    if (binary) {
+        BinaryCheckpoint::Writer writer(outstream);
+        globals.serializeSection(outstream, "Globals");
+        SimObject::serializeAll(outstream);
+        writer.finish();
+    } else {
+        time_t t = time(NULL);
+        outstream << "## checkpoint generated: " << ctime(&t);
+        globals.serializeSection(outstream, "Globals");
+        SimObject::serializeAll(outstream);
+    }
 
-    SimObject::serializeAll(outstream);
+    if (!outstream)
+        fatal("Write failed on checkpoint file %s\n", cpt_file.c_str());
 }
 
 void
@@ -642,7 +862,10 @@ Serializable::ScopedCheckpointSection::nameOut(CheckpointOut &cp)
 {
     DPRINTF(Checkpoint, "ScopedCheckpointSection::nameOut: %s\n",
             Serializable::currentSection());
-    cp << "\n[" << Serializable::currentSection() << "]\n";
+    if (BinaryCheckpoint::Writer *w = BinaryCheckpoint::Writer::get(cp))
+        w->section(Serializable::currentSection());
+    else
+        cp << "\n[" << Serializable::currentSection() << "]\n";
 }
 
 void
@@ -683,9 +906,16 @@ CheckpointIn::dir()
 
 
 CheckpointIn::CheckpointIn(const string &cpt_dir, SimObjectResolver &resolver)
-    : db(new IniFile), objNameResolver(resolver), cptDir(setDir(cpt_dir))
+    : db(nullptr), binary(nullptr), objNameResolver(resolver),
+      cptDir(setDir(cpt_dir))
 {
     string filename = cptDir + "/" + CheckpointIn::baseFilename;
+    if (BinaryCheckpoint::isBinary(filename)) {
+        binary = new BinaryCheckpoint::Reader(filename);
+        return;
+    }
+
+    db = new IniFile;
     if (!db->load(filename)) {
         fatal("Can't load checkpoint file '%s'\n", filename);
     }
@@ -694,20 +924,36 @@ CheckpointIn::CheckpointIn(const string &cpt_dir, SimObjectResolver &resolver)
 CheckpointIn::~CheckpointIn()
 {
     delete db;
+    delete binary;
 }
 
 bool
 CheckpointIn::entryExists(const string &section, const string &entry)
 {
+    if (binary)
+        return binary->find(section, entry) != nullptr;
     return db->entryExists(section, entry);
 }
 
 bool
 CheckpointIn::find(const string &section, const string &entry, string &value)
 {
+    if (binary) {
+        const BinaryCheckpoint::Entry *e = binary->find(section, entry);
+        if (!e)
+            return false;
+        value = BinaryCheckpoint::Reader::toText(*e);
+        return true;
+    }
     return db->find(section, entry, value);
 }
 
+const BinaryCheckpoint::Entry *
+CheckpointIn::findBinary(const string &section, const string &entry)
+{
+    return binary ? binary->find(section, entry) : nullptr;
+}
+
 
 bool
 CheckpointIn::findObj(const string &section, const string &entry,
@@ -715,7 +961,7 @@ CheckpointIn::findObj(const string &section, const string &entry,
 {
     string path;
 
-    if (!db->find(section, entry, path))
+    if (!find(section, entry, path))
         return false;
 
     value = objNameResolver.resolveSimObject(path);
@@ -726,5 +972,7 @@ CheckpointIn::findObj(const string &section, const string &entry,
 bool
 CheckpointIn::sectionExists(const string &section)
 {
+    if (binary)
+        return binary->sectionExists(section);
     return db->sectionExists(section);
 }
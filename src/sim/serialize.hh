@@ -62,6 +62,10 @@
 
 class CheckpointIn;
 class IniFile;
+namespace BinaryCheckpoint {
+class Reader;
+struct Entry;
+}
 class Serializable;
 class SimObject;
 class SimObjectResolver;
@@ -335,7 +339,14 @@ class Serializable
     static int ckptCount;
     static int ckptMaxCount;
     static int ckptPrevCount;
-    static void serializeAll(const std::string &cpt_dir);
+    /**
+     * Write a checkpoint of all the objects.
+     *
+     * @param cpt_dir Checkpoint directory.
+     * @param binary Write m5.cpt as a binary checkpoint instead of INI
+     *               text, see sim/binary_checkpoint.hh.
+     */
+    static void serializeAll(const std::string &cpt_dir, bool binary = false);
     static void unserializeGlobals(CheckpointIn &cp);
 
   private:
@@ -349,7 +360,9 @@ class CheckpointIn
 {
   private:
 
+    /** The checkpoint, either INI text or binary. */
     IniFile *db;
+    BinaryCheckpoint::Reader *binary;
 
     SimObjectResolver &objNameResolver;
 
@@ -365,6 +378,13 @@ class CheckpointIn
     bool findObj(const std::string &section, const std::string &entry,
                  SimObject *&value);
 
+    /**
+     * Find an entry of a binary checkpoint, to read its values without
+     * going through their text. Returns nullptr for INI checkpoints.
+     */
+    const BinaryCheckpoint::Entry *findBinary(const std::string &section,
+                                              const std::string &entry);
+
 
     bool entryExists(const std::string &section, const std::string &entry);
     bool sectionExists(const std::string &section);
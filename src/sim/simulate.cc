@@ -40,6 +40,7 @@
 #include "base/pollevent.hh"
 #include "base/types.hh"
 #include "sim/async.hh"
+#include "sim/cross_queue_channel.hh"
 #include "sim/eventq_impl.hh"
 #include "sim/sim_events.hh"
 #include "sim/sim_exit.hh"
@@ -115,10 +116,21 @@ simulate(Tick num_cycles)
 
     GlobalSyncEvent *quantum_event = NULL;
     if (numMainEventQueues > 1) {
+        // Messages between queues must not arrive before the receiving
+        // queue may have run, so the quantum is bounded by the smallest
+        // channel latency, and defaults to it.
+        Tick lookahead = CrossQueueChannelBase::lookahead();
+        if (simQuantum == 0 && lookahead != MaxTick)
+            simQuantum = lookahead;
+
         if (simQuantum == 0) {
             fatal("Quantum for multi-eventq simulation not specified");
         }
 
+        fatal_if(simQuantum > lookahead, "Quantum for multi-eventq "
+                 "simulation (%d) exceeds the lookahead of the cross-queue "
+                 "channels (%d)", simQuantum, lookahead);
+
         quantum_event = new GlobalSyncEvent(curTick() + simQuantum, simQuantum,
                             EventBase::Progress_Event_Pri, 0);
 
@@ -54,9 +54,11 @@
 
 #include "base/callback.hh"
 #include "base/hostinfo.hh"
+#include "base/slab_pool.hh"
 #include "base/statistics.hh"
 #include "base/time.hh"
 #include "cpu/base.hh"
+#include "mem/packet.hh"
 #include "sim/global_event.hh"
 
 using namespace std;
@@ -114,6 +116,13 @@ struct Global
     Stats::Value hostMemory;
     Stats::Value hostSeconds;
 
+    Stats::Value hostPacketPoolHits;
+    Stats::Value hostPacketPoolMisses;
+    Stats::Value hostRequestPoolHits;
+    Stats::Value hostRequestPoolMisses;
+    Stats::Value hostDataPoolHits;
+    Stats::Value hostDataPoolMisses;
+
     Stats::Value simInsts;
     Stats::Value simOps;
 
@@ -190,6 +199,43 @@ Global::Global()
         .precision(2)
         ;
 
+    hostPacketPoolHits
+        .functor(SlabPoolCounters<Packet>::hits)
+        .name("host_packet_pool_hits")
+        .desc("Packets allocated from the packet pool free lists")
+        ;
+
+    hostPacketPoolMisses
+        .functor(SlabPoolCounters<Packet>::misses)
+        .name("host_packet_pool_misses")
+        .desc("Packet allocations that took a new slab from the heap")
+        ;
+
+    hostRequestPoolHits
+        .functor(SlabPoolCounters<Request>::hits)
+        .name("host_request_pool_hits")
+        .desc("Requests allocated from the request pool free lists")
+        ;
+
+    hostRequestPoolMisses
+        .functor(SlabPoolCounters<Request>::misses)
+        .name("host_request_pool_misses")
+        .desc("Request allocations that took a new slab from the heap")
+        ;
+
+    hostDataPoolHits
+        .functor(SlabPoolCounters<Packet::DataBuffer>::hits)
+        .name("host_data_pool_hits")
+        .desc("Packet data buffers allocated from the pool free lists")
+        ;
+
+    hostDataPoolMisses
+        .functor(SlabPoolCounters<Packet::DataBuffer>::misses)
+        .name("host_data_pool_misses")
+        .desc("Packet data buffer allocations that took a new slab from "
+              "the heap")
+        ;
+
     hostTickRate
         .name("host_tick_rate")
         .desc("Simulator tick rate (ticks/s)")
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Microbenchmark comparing the event queue backends.
+ *
+ * Replays a schedule trace on an event queue of each backend, checks
+ * that both service the events in the same order and reports the time
+ * each took. The trace is read from the file given as the first
+ * argument, or generated if there is none. Each line of a trace holds
+ * one operation:
+ *
+ *   s <id> <when> <priority>  schedule (or move) event id; the
+ *                             priority of an event is the one given
+ *                             the first time it is scheduled
+ *   d <id>                    deschedule event id, if scheduled
+ *   x <tick>                  service all events up to tick
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "sim/eventq_impl.hh"
+
+using namespace std;
+
+struct TraceOp
+{
+    char type;
+    unsigned id;
+    Tick when;
+    Event::Priority priority;
+};
+
+class TraceEvent : public Event
+{
+  private:
+    unsigned id;
+    vector<unsigned> &serviced;
+
+  public:
+    TraceEvent(unsigned _id, Priority p, vector<unsigned> &_serviced)
+        : Event(p), id(_id), serviced(_serviced)
+    {}
+
+    void process() { serviced.push_back(id); }
+};
+
+vector<TraceOp>
+read_trace(const char *path, unsigned &num_events)
+{
+    ifstream in(path);
+    if (!in)
+        fatal("Can't open trace file '%s'\n", path);
+
+    vector<TraceOp> trace;
+    num_events = 0;
+
+    TraceOp op = { 0, 0, 0, Event::Default_Pri };
+    while (in >> op.type) {
+        int priority = Event::Default_Pri;
+        switch (op.type) {
+          case 's':
+            in >> op.id >> op.when >> priority;
+            op.priority = priority;
+            break;
+          case 'd':
+            in >> op.id;
+            break;
+          case 'x':
+            in >> op.when;
+            break;
+          default:
+            fatal("Bad operation '%c' in trace file\n", op.type);
+        }
+        if (op.type != 'x' && op.id >= num_events)
+            num_events = op.id + 1;
+        trace.push_back(op);
+    }
+
+    return trace;
+}
+
+/**
+ * Generate a trace resembling a detailed simulation: a set of clocked
+ * objects ticking at a few different periods, plus a spread of
+ * latencies (cache and memory responses) and a few far-away timers.
+ */
+vector<TraceOp>
+make_trace(unsigned num_events, unsigned num_steps)
+{
+    static const Tick periods[] = { 500, 500, 1000, 333, 1500 };
+    static const Event::Priority priorities[] = {
+        Event::CPU_Tick_Pri, Event::Default_Pri, Event::Default_Pri,
+        Event::Delayed_Writeback_Pri, Event::Stat_Event_Pri,
+    };
+
+    mt19937_64 rng(1);
+    vector<TraceOp> trace;
+    Tick now = 0;
+
+    for (unsigned step = 0; step < num_steps; step++) {
+        for (unsigned i = 0; i < 16; i++) {
+            TraceOp op;
+            op.type = 's';
+            op.id = rng() % num_events;
+            op.priority = priorities[op.id % 5];
+
+            unsigned kind = rng() % 100;
+            if (kind < 60)
+                op.when = now + periods[rng() % 5] * (1 + rng() % 4);
+            else if (kind < 95)
+                op.when = now + 1000 * (1 + rng() % 200);
+            else
+                op.when = now + 1000000 * (1 + rng() % 1000);
+
+            if (kind % 8 == 0)
+                op.type = 'd';
+            trace.push_back(op);
+        }
+
+        now += 500;
+        TraceOp op = { 'x', 0, now, Event::Default_Pri };
+        trace.push_back(op);
+    }
+
+    return trace;
+}
+
+double
+replay(const vector<TraceOp> &trace, unsigned num_events,
+       EventQueue::Backend backend, vector<unsigned> &serviced)
+{
+    EventQueue eq("eventqtime", backend);
+    curEventQueue(&eq);
+
+    vector<Event::Priority> priorities(num_events, Event::Default_Pri);
+    vector<bool> seen(num_events, false);
+    for (const auto &op : trace) {
+        if (op.type == 's' && !seen[op.id]) {
+            priorities[op.id] = op.priority;
+            seen[op.id] = true;
+        }
+    }
+
+    vector<unique_ptr<TraceEvent>> events;
+    for (unsigned i = 0; i < num_events; i++)
+        events.emplace_back(new TraceEvent(i, priorities[i], serviced));
+
+    auto start = chrono::steady_clock::now();
+
+    for (const auto &op : trace) {
+        switch (op.type) {
+          case 's': {
+              TraceEvent *event = events[op.id].get();
+              Tick when = max(op.when, eq.getCurTick());
+              if (event->scheduled())
+                  eq.reschedule(event, when);
+              else
+                  eq.schedule(event, when);
+              break;
+          }
+          case 'd':
+            if (events[op.id]->scheduled())
+                eq.deschedule(events[op.id].get());
+            break;
+          case 'x':
+            eq.serviceEvents(max(op.when, eq.getCurTick()));
+            break;
+        }
+    }
+
+    eq.serviceEvents(MaxTick);
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    curEventQueue(NULL);
+    return elapsed.count();
+}
+
+int
+main(int argc, char *argv[])
+{
+    unsigned num_events;
+    vector<TraceOp> trace;
+
+    if (argc > 1) {
+        trace = read_trace(argv[1], num_events);
+    } else {
+        num_events = 20000;
+        trace = make_trace(num_events, 200000);
+    }
+
+    vector<unsigned> list_serviced, wheel_serviced;
+    double list_time = replay(trace, num_events, EventQueue::ListBackend,
+                              list_serviced);
+    double wheel_time = replay(trace, num_events, EventQueue::WheelBackend,
+                               wheel_serviced);
+
+    if (list_serviced != wheel_serviced) {
+        cprintf("event order differs between backends!\n");
+        return 1;
+    }
+
+    cprintf("%d operations, %d events serviced\n", trace.size(),
+            list_serviced.size());
+    cprintf("list:  %.3fs\n", list_time);
+    cprintf("wheel: %.3fs (%.2fx)\n", wheel_time, list_time / wheel_time);
+
+    return 0;
+}
@@ -1,6 +1,50 @@
+def checkBinary(path):
+    """Read back the binary stats and check them against the test's"""
+    from _m5.drain import DrainManager
+    import m5.stats
+    from m5.stats.binary import StatsFile
+
+    # wait for the background thread to write the dump
+    drain_manager = DrainManager.instance()
+    assert drain_manager.tryDrain()
+    drain_manager.resume()
+
+    stats = StatsFile(path)
+    assert stats.ticks == [m5.curTick()]
+
+    displayed = [ stat.name for stat in m5.stats.stats_list
+                  if stat.flags & m5.stats.flags.display ]
+    assert [ stat.name for stat in stats ] == displayed
+
+    def values(name):
+        return list(stats[name].values[0])
+
+    assert values("Stat01") == [ 7 ]
+    assert values("Stat17") == [ 9.8 ]
+    assert values("Stat19") == [ 1, 100000 ]
+    assert values("vector_op_test_formula") == [ 1e-5, 1e5 ]
+
+    stat16 = stats["Stat16"]
+    assert stat16.kind == "vector2d"
+    assert tuple(stat16.dims) == (2, 9)
+    assert stat16.columns[:2] == [ "sub0.y0", "sub0.y1" ]
+    assert values("Stat16") == [ 2, 3, 0, 0, 0, 0, 0, 0, 0,
+                                 1, 18, 0, 0, 4, 5, 6, 7, 8 ]
+
+    stat13 = stats["Stat13"]
+    assert stat13.kind == "vector_dist"
+    assert stat13.dims[0] == 4
+    assert stat13.columns[0] == "0.samples"
+    assert values("Stat13")[0] == 6
+
+    print("binary stats match")
+
 def main():
     from _m5.stattest import stattest_init, stattest_run
     import m5.stats
+    import os
+    import shutil
+    import tempfile
 
     stattest_init()
 
@@ -8,6 +52,11 @@ def main():
     m5.stats.initSimStats()
     m5.stats.addStatVisitor("cout")
 
+    # Write the binary format too, and read it back after the dump
+    binary_dir = tempfile.mkdtemp()
+    binary_path = os.path.join(binary_dir, "stats.bin")
+    m5.stats.addStatVisitor("binary://%s" % binary_path)
+
     # We're done registering statistics.  Enable the stats package now.
     m5.stats.enable()
 
@@ -17,3 +66,6 @@ def main():
     stattest_run()
 
     m5.stats.dump()
+
+    checkBinary(binary_path)
+    shutil.rmtree(binary_dir)
@@ -155,6 +155,7 @@ generic_configs = (
     'memcheck',
     'memtest',
     'memtest-filter',
+    'memtest-bounded-filter',
     'tgen-simple-mem',
     'tgen-dram-ctrl',
     'dram-lowp',
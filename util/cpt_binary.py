@@ -0,0 +1,229 @@
+#!/usr/bin/env python2
+
+# Copyright (c) 2026 The Regents of The University of Michigan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script converts m5.cpt checkpoint files between the INI text format
+# and the binary format described in src/sim/binary_checkpoint.hh. gem5
+# restores both formats, so converting is only needed to read or edit a
+# binary checkpoint by hand, or to use a tool that only knows about INI.
+# util/cpt_upgrader.py uses it to upgrade binary checkpoints.
+#
+# Example, converting a binary checkpoint to INI and back:
+#
+#   util/cpt_binary.py -o m5.cpt.ini cpt.1000/m5.cpt
+#   util/cpt_binary.py -o cpt.1000/m5.cpt m5.cpt.ini
+#
+# Converting from INI stores every value as text, as the types of the
+# values are not known. gem5 parses text values when restoring, as it does
+# for INI checkpoints.
+
+from __future__ import print_function
+
+import struct
+import sys
+
+MAGIC = b'gem5cptb'
+VERSION = 1
+
+HEADER = struct.Struct('<8sIIQ')
+
+# Types of the values of the entries, the formats of the raw ones
+TEXT = 0
+BOOL = 1
+FORMATS = [ None, '?', 'b', 'B', 'h', 'H', 'i', 'I', 'q', 'Q', 'f', 'd' ]
+FLOAT_TYPES = (10, 11)
+
+def is_binary(path):
+    with open(path, 'rb') as f:
+        return f.read(len(MAGIC)) == MAGIC
+
+def _show(entry_type, value):
+    """Text of a value, as gem5 writes it in INI checkpoints."""
+    if entry_type == TEXT:
+        return value
+    if entry_type == BOOL:
+        return 'true' if value else 'false'
+    if entry_type in FLOAT_TYPES:
+        # iostreams print floating-point values like %g
+        return '%g' % value
+    return str(value)
+
+class Entry(object):
+    def __init__(self, name, entry_type, values):
+        self.name = name
+        self.type = entry_type
+        self.values = values
+
+    def text(self):
+        return ' '.join(_show(self.type, v) for v in self.values)
+
+def read_binary(path):
+    """Read a binary checkpoint, as a list of (section, entries) pairs in
+    file order. A section may appear more than once."""
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    magic, version, num_sections, index_offset = \
+        HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise ValueError("%s is not a binary checkpoint" % path)
+    if version != VERSION:
+        raise ValueError("%s has version %d, expected %d" %
+                         (path, version, VERSION))
+
+    def name_at(pos):
+        length, = struct.unpack_from('<H', data, pos)
+        pos += 2
+        return data[pos:pos + length].decode('utf-8'), pos + length
+
+    sections = []
+    pos = index_offset
+    for i in range(num_sections):
+        name, pos = name_at(pos)
+        offset, size = struct.unpack_from('<QQ', data, pos)
+        pos += 16
+        sections.append((name, offset, size))
+
+    result = []
+    for name, offset, size in sections:
+        entries = []
+        pos = offset
+        while pos < offset + size:
+            entry_name, pos = name_at(pos)
+            entry_type, count = struct.unpack_from('<BQ', data, pos)
+            pos += 9
+            if entry_type == TEXT:
+                values = []
+                for j in range(count):
+                    length, = struct.unpack_from('<I', data, pos)
+                    pos += 4
+                    values.append(data[pos:pos + length].decode('utf-8'))
+                    pos += length
+            else:
+                fmt = '<%d%s' % (count, FORMATS[entry_type])
+                values = list(struct.unpack_from(fmt, data, pos))
+                pos += struct.calcsize(fmt)
+            entries.append(Entry(entry_name, entry_type, values))
+        result.append((name, entries))
+    return result
+
+def write_binary(path, sections):
+    """Write a binary checkpoint from a list of (section, entries) pairs."""
+    def name_bytes(name):
+        name = name.encode('utf-8')
+        return struct.pack('<H', len(name)) + name
+
+    chunks = [ HEADER.pack(b'\0' * len(MAGIC), 0, 0, 0) ]
+    offset = HEADER.size
+    index = []
+    for name, entries in sections:
+        start = offset
+        for entry in entries:
+            chunk = [ name_bytes(entry.name),
+                      struct.pack('<BQ', entry.type, len(entry.values)) ]
+            if entry.type == TEXT:
+                for value in entry.values:
+                    value = value.encode('utf-8')
+                    chunk.append(struct.pack('<I', len(value)) + value)
+            else:
+                chunk.append(struct.pack('<%d%s' % (len(entry.values),
+                                                    FORMATS[entry.type]),
+                                         *entry.values))
+            chunk = b''.join(chunk)
+            chunks.append(chunk)
+            offset += len(chunk)
+        index.append(name_bytes(name) +
+                     struct.pack('<QQ', start, offset - start))
+
+    chunks[0] = HEADER.pack(MAGIC, VERSION, len(sections), offset)
+    with open(path, 'wb') as f:
+        f.write(b''.join(chunks))
+        f.write(b''.join(index))
+
+def read_ini(f):
+    """Read an INI checkpoint from a file object, as a list of (section,
+    entries) pairs whose values are all text."""
+    sections = []
+    entries = None
+    for line in f:
+        line = line.strip()
+        if not line:
+            continue
+        if line.startswith('[') and line.endswith(']'):
+            entries = []
+            sections.append((line[1:-1].strip(), entries))
+        elif entries is not None:
+            name, sep, value = line.partition('=')
+            if not sep:
+                raise ValueError("Can't parse INI line %s" % line)
+            entries.append(Entry(name.strip(), TEXT, [ value.strip() ]))
+    return sections
+
+def write_ini(f, sections):
+    for name, entries in sections:
+        f.write('\n[%s]\n' % name)
+        for entry in entries:
+            f.write('%s=%s\n' % (entry.name, entry.text()))
+
+def retype(sections, original):
+    """Give back their binary types to the text entries of sections read
+    from INI whose text is still that of the entries of the same name in
+    original, a binary checkpoint they were converted from."""
+    types = {}
+    for name, entries in original:
+        for entry in entries:
+            types[(name, entry.name)] = entry
+
+    for name, entries in sections:
+        for i, entry in enumerate(entries):
+            typed = types.get((name, entry.name))
+            if entry.type == TEXT and typed and \
+               typed.text() == entry.text():
+                entries[i] = typed
+    return sections
+
+if __name__ == '__main__':
+    from optparse import OptionParser
+    parser = OptionParser("usage: %prog [options] <m5.cpt>")
+    parser.add_option("-o", "--output", help="File to write, by default "
+                      "the input with a .ini or .bin suffix")
+    (options, args) = parser.parse_args()
+
+    if len(args) != 1:
+        parser.error("You must specify a single checkpoint file")
+
+    path = args[0]
+    if is_binary(path):
+        output = options.output or path + '.ini'
+        with open(output, 'w') as f:
+            write_ini(f, read_binary(path))
+    else:
+        output = options.output or path + '.bin'
+        with open(path) as f:
+            write_binary(output, read_ini(f))
+    print("Wrote %s" % output)
+    sys.exit(0)
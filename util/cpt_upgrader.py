@@ -76,6 +76,9 @@
 import ConfigParser
 import glob, types, sys, os
 import os.path as osp
+from StringIO import StringIO
+
+import cpt_binary
 
 verbose_print = False
 
@@ -200,8 +203,16 @@ def process_file(path, **kwargs):
     # gem5 is case sensitive with paramaters
     cpt.optionxform = str
 
-    # Read the current data
-    cpt_file = file(path, 'r')
+    # Read the current data. Binary checkpoints are upgraded in their INI
+    # form.
+    binary = cpt_binary.is_binary(path)
+    if binary:
+        original = cpt_binary.read_binary(path)
+        cpt_file = StringIO()
+        cpt_binary.write_ini(cpt_file, original)
+        cpt_file.seek(0)
+    else:
+        cpt_file = file(path, 'r')
     cpt.readfp(cpt_file)
     cpt_file.close()
 
@@ -259,7 +270,14 @@ def process_file(path, **kwargs):
 
     # Write the old data back
     verboseprint("...completed")
-    cpt.write(file(path, 'w'))
+    if binary:
+        cpt_file = StringIO()
+        cpt.write(cpt_file)
+        cpt_file.seek(0)
+        cpt_binary.write_binary(path, cpt_binary.retype(
+            cpt_binary.read_ini(cpt_file), original))
+    else:
+        cpt.write(file(path, 'w'))
 
 if __name__ == '__main__':
     from optparse import OptionParser, SUPPRESS_HELP
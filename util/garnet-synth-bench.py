@@ -0,0 +1,111 @@
+#! /usr/bin/env python2
+
+# Copyright (c) 2026 The Regents of The University of Michigan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script measures how fast garnet2.0 simulates synthetic traffic. It
+# runs the garnet_synth_traffic.py example script for every combination of
+# traffic pattern and injection rate on a mesh, and reports the simulated
+# cycles per host second of each run, read back from its stats.txt.
+#
+# Example, from the root of the repository:
+#
+#   util/garnet-synth-bench.py build/Garnet_standalone/gem5.opt
+#
+# The gem5 binary must be built with the Garnet_standalone protocol.
+
+from __future__ import print_function
+
+import optparse
+import os
+import re
+import subprocess
+import sys
+
+parser = optparse.OptionParser(usage="%prog [options] <gem5 binary>")
+
+parser.add_option('-p', '--patterns',
+                  default='uniform_random,transpose,tornado',
+                  help="Comma-separated traffic patterns [default: %default]")
+parser.add_option('-r', '--rates', default='0.01,0.05,0.1,0.2,0.3',
+                  help="Comma-separated injection rates, in packets per "
+                  "node per cycle [default: %default]")
+parser.add_option('-c', '--sim-cycles', type='int', default=100000,
+                  help="Simulated cycles of each run [default: %default]")
+parser.add_option('--mesh-rows', type='int', default=8,
+                  help="Rows of the mesh, which is square [default: %default]")
+parser.add_option('-d', '--outdir', default='garnet-synth-bench',
+                  help="Directory of the output of the runs "
+                  "[default: %default]")
+
+(options, args) = parser.parse_args()
+
+if len(args) != 1:
+    parser.error("Expecting a single argument specifying the gem5 binary")
+
+gem5_binary = args[0]
+script = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                      os.pardir, 'configs', 'example',
+                      'garnet_synth_traffic.py')
+num_nodes = options.mesh_rows * options.mesh_rows
+devnull = open(os.devnull, 'w')
+
+def host_seconds(stats_file):
+    with open(stats_file) as f:
+        for line in f:
+            match = re.match(r'host_seconds\s+(\S+)', line)
+            if match:
+                return float(match.group(1))
+    return None
+
+print("%-16s %8s %14s %20s" % ("pattern", "rate", "host seconds",
+                                "cycles/host second"))
+
+for pattern in options.patterns.split(','):
+    for rate in options.rates.split(','):
+        outdir = os.path.join(options.outdir, '%s-%s' % (pattern, rate))
+        status = subprocess.call([gem5_binary, '-d', outdir, script,
+                                  '--network=garnet2.0',
+                                  '--topology=Mesh_XY',
+                                  '--mesh-rows=%d' % options.mesh_rows,
+                                  '--num-cpus=%d' % num_nodes,
+                                  '--num-dirs=%d' % num_nodes,
+                                  '--synthetic=%s' % pattern,
+                                  '--injectionrate=%s' % rate,
+                                  '--sim-cycles=%d' % options.sim_cycles],
+                                 stdout=devnull)
+        if status != 0:
+            print("Error: run of %s at rate %s failed, see %s" %
+                  (pattern, rate, outdir))
+            sys.exit(1)
+
+        seconds = host_seconds(os.path.join(outdir, 'stats.txt'))
+        if not seconds:
+            print("Error: no host_seconds in the stats of %s" % outdir)
+            sys.exit(1)
+
+        print("%-16s %8s %14.2f %20.0f" %
+              (pattern, rate, seconds, options.sim_cycles / seconds))
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Renders a binary debug trace, written by gem5 --debug-format=binary,
+ * as the text gem5 would have written with --debug-format=text. See
+ * src/base/binary_trace.hh for the format of the traces.
+ *
+ * The messages are formatted by the cprintf code of gem5, with their
+ * arguments converted back to the types they had in gem5, so they are
+ * formatted as they would have been when recorded.
+ *
+ * Usage: trace_render [-o output] trace
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#include "base/binary_trace.hh"
+#include "base/cprintf.hh"
+
+using namespace std;
+using namespace BinaryTrace;
+
+namespace {
+
+const uint64_t maxTick = (uint64_t)-1;
+
+string path;
+
+void
+corrupt(const char *what)
+{
+    cerr << path << ": " << what << endl;
+    exit(1);
+}
+
+/** Cursor over part of the trace, which fails on reads beyond its end. */
+class Cursor
+{
+  private:
+    const uint8_t *pos;
+    const uint8_t *end;
+
+  public:
+    Cursor(const uint8_t *begin, uint64_t bytes)
+        : pos(begin), end(begin + bytes)
+    {}
+
+    bool done() const { return pos == end; }
+
+    const uint8_t *
+    skip(uint64_t bytes)
+    {
+        if (bytes > (uint64_t)(end - pos))
+            corrupt("truncated trace");
+        const uint8_t *start = pos;
+        pos += bytes;
+        return start;
+    }
+
+    template <class T>
+    T
+    get()
+    {
+        T value;
+        memcpy(&value, skip(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    string
+    str()
+    {
+        const uint32_t length = get<uint32_t>();
+        return string(reinterpret_cast<const char *>(skip(length)), length);
+    }
+};
+
+unordered_map<uint32_t, string> strings;
+
+const string &
+lookup(uint32_t id)
+{
+    auto s = strings.find(id);
+    if (s == strings.end())
+        corrupt("record refers to an unknown string");
+    return s->second;
+}
+
+/** Give an argument to cprintf with the type it had when recorded. */
+void
+addArg(cp::Print &print, Cursor &args)
+{
+    const uint8_t type = args.get<uint8_t>();
+    if (type == String) {
+        print.add_arg(args.str());
+        return;
+    }
+
+    union {
+        int64_t i;
+        uint64_t u;
+        double d;
+    } v;
+    memcpy(&v, args.skip(sizeof(v)), sizeof(v));
+
+    switch (type) {
+      case Bool: print.add_arg((bool)v.u); break;
+      case Char: print.add_arg((char)v.i); break;
+      case SignedChar: print.add_arg((signed char)v.i); break;
+      case UnsignedChar: print.add_arg((unsigned char)v.u); break;
+      case Short: print.add_arg((short)v.i); break;
+      case UnsignedShort: print.add_arg((unsigned short)v.u); break;
+      case Int: print.add_arg((int)v.i); break;
+      case UnsignedInt: print.add_arg((unsigned int)v.u); break;
+      case Long: print.add_arg((long)v.i); break;
+      case UnsignedLong: print.add_arg((unsigned long)v.u); break;
+      case LongLong: print.add_arg((long long)v.i); break;
+      case UnsignedLongLong: print.add_arg((unsigned long long)v.u); break;
+      case Float: print.add_arg((float)v.d); break;
+      case Double: print.add_arg(v.d); break;
+      case Pointer:
+        print.add_arg(reinterpret_cast<const void *>((uintptr_t)v.u));
+        break;
+      default:
+        corrupt("unknown argument type");
+    }
+}
+
+/** Write a record as Trace::OstreamLogger would have. */
+void
+render(ostream &os, Cursor &record)
+{
+    const RecordHeader header = record.get<RecordHeader>();
+    if (header.bytes < sizeof(header))
+        corrupt("corrupt record");
+    Cursor args(record.skip(header.bytes - sizeof(header)),
+                header.bytes - sizeof(header));
+
+    if (header.when != maxTick)
+        ccprintf(os, "%d.%03d.%03d: ", header.when / 1000000,
+                 header.when / 1000 % 1000, header.when % 1000);
+
+    if (header.name != noName)
+        os << lookup(header.name) << ": ";
+
+    if (header.format == textFormat) {
+        if (header.args != 1 || args.get<uint8_t>() != String)
+            corrupt("corrupt text record");
+        os << args.str();
+        return;
+    }
+
+    cp::Print print(os, lookup(header.format).c_str());
+    for (uint32_t i = 0; i < header.args; i++)
+        addArg(print, args);
+    print.end_args();
+}
+
+void
+usage(const char *prog)
+{
+    cerr << "Usage: " << prog << " [-o output] trace" << endl;
+    exit(2);
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char *argv[])
+{
+    const char *output = nullptr;
+    int c;
+    while ((c = getopt(argc, argv, "o:")) != -1) {
+        switch (c) {
+          case 'o':
+            output = optarg;
+            break;
+          default:
+            usage(argv[0]);
+        }
+    }
+    if (optind != argc - 1)
+        usage(argv[0]);
+    path = argv[optind];
+
+    // Map the trace rather than reading it, as traces can be much
+    // larger than memory. The pages are read in as the records are
+    // rendered, and can be dropped again once they have been.
+    const int fd = open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        cerr << "Can't open " << path << endl;
+        return 1;
+    }
+    if (st.st_size == 0)
+        corrupt("truncated trace");
+    const uint64_t bytes = st.st_size;
+    void *data = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        cerr << "Can't map " << path << endl;
+        return 1;
+    }
+    close(fd);
+    madvise(data, bytes, MADV_SEQUENTIAL);
+
+    ofstream out_file;
+    if (output) {
+        out_file.open(output);
+        if (!out_file) {
+            cerr << "Can't open " << output << endl;
+            return 1;
+        }
+    }
+    ostream &os = output ? out_file : cout;
+
+    Cursor trace(static_cast<const uint8_t *>(data), bytes);
+    const FileHeader header = trace.get<FileHeader>();
+    if (memcmp(header.magic, magic, sizeof(magic)) != 0)
+        corrupt("not a binary gem5 trace");
+    if (header.byteOrder != byteOrder)
+        corrupt("trace written by a host of another byte order");
+    if (header.version != version)
+        corrupt("unsupported trace version");
+
+    while (!trace.done()) {
+        const BlockHeader block = trace.get<BlockHeader>();
+        Cursor payload(trace.skip(block.bytes), block.bytes);
+        switch (block.kind) {
+          case Strings:
+            while (!payload.done()) {
+                const uint32_t id = payload.get<uint32_t>();
+                strings[id] = payload.str();
+            }
+            break;
+          case Records:
+            while (!payload.done())
+                render(os, payload);
+            break;
+          default:
+            corrupt("unknown block kind");
+        }
+    }
+
+    return 0;
+}